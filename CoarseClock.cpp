@@ -0,0 +1,120 @@
+#include "CoarseClock.h"
+
+#if DT_UNDER_OS > 0 && !defined(DT_NO_THREADS)
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+/**
+* @struct coarse_clock_updater_s
+* @brief Background thread of CoarseClock. Thread is stopped by destructor, so running clock does not block end of program.
+*/
+struct coarse_clock_updater_s {
+	std::thread thread;
+	std::mutex mutex;
+	std::condition_variable cv;
+	int64_t period = DT_COARSE_CLOCK_PERIOD;
+	bool stopRequested = false;
+
+	~coarse_clock_updater_s() {
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			stopRequested = true;
+		}
+		cv.notify_all();
+		if (thread.joinable()) thread.join();
+	}
+};
+
+static coarse_clock_updater_s& getUpdater() {
+	static coarse_clock_updater_s updater;
+	return updater;
+}
+
+//Serializes start() and stop(), thread cannot be joined while updater mutex is locked
+static std::mutex& getControlMutex() {
+	static std::mutex mutex;
+	return mutex;
+}
+
+CoarseClock::coarse_clock_slot_s CoarseClock::slot;
+
+/**
+* @brief Converts UTC time to local time using system time zone info.
+* @return Returns local time with DST flag in the lowest bit.
+*/
+static int64_t toLocalWithDSTFlag(int64_t utc) {
+	const TimeZoneInfo& tzinfo = TimeZoneInfo::getSystemTZInfo();
+	int64_t local = utc + (int64_t)tzinfo.timeZone.getTimeZoneOffset();
+	bool isDST = tzinfo.DST.checkDSTRegion(local);
+	if (isDST) {
+		local += (int64_t)tzinfo.DST.getDSTOffset();
+	}
+	return (local & ~1LL) | (isDST ? 1 : 0);
+}
+
+int64_t CoarseClock::readUTC() {
+	return ((DateTime)DateTimeSysSync::nowUTC()).getRaw();
+}
+
+int64_t CoarseClock::readLocal() {
+	return toLocalWithDSTFlag(readUTC());
+}
+
+void CoarseClock::update() {
+	int64_t utc = readUTC();
+	int64_t local = toLocalWithDSTFlag(utc);
+	slot.utc.store(utc, std::memory_order_relaxed);
+	slot.local.store(local, std::memory_order_relaxed);
+}
+
+void CoarseClock::run() {
+	coarse_clock_updater_s& updater = getUpdater();
+	std::unique_lock<std::mutex> lock(updater.mutex);
+	std::chrono::steady_clock::time_point next = std::chrono::steady_clock::now();
+	while (!updater.stopRequested) {
+		update();
+		next += std::chrono::microseconds(updater.period);
+		std::chrono::steady_clock::time_point current = std::chrono::steady_clock::now();
+		if (next < current) next = current; //Missed updates are not repeated
+		updater.cv.wait_until(lock, next, [&updater]() { return updater.stopRequested; });
+	}
+}
+
+bool CoarseClock::start(int64_t period) {
+	if (period <= 0) return false;
+	std::lock_guard<std::mutex> control(getControlMutex());
+	coarse_clock_updater_s& updater = getUpdater();
+	{
+		std::lock_guard<std::mutex> lock(updater.mutex);
+		updater.period = period;
+		updater.stopRequested = false;
+	}
+	if (updater.thread.joinable()) return true; //New period is used after the next update
+
+	update();
+	updater.thread = std::thread(run);
+	return true;
+}
+
+void CoarseClock::stop() {
+	std::lock_guard<std::mutex> control(getControlMutex());
+	coarse_clock_updater_s& updater = getUpdater();
+	{
+		std::lock_guard<std::mutex> lock(updater.mutex);
+		updater.stopRequested = true;
+	}
+	updater.cv.notify_all();
+	if (updater.thread.joinable()) updater.thread.join();
+
+	slot.utc.store(0, std::memory_order_relaxed);
+	slot.local.store(0, std::memory_order_relaxed);
+}
+
+bool CoarseClock::isRunning() {
+	std::lock_guard<std::mutex> control(getControlMutex());
+	return getUpdater().thread.joinable();
+}
+
+#endif // DT_UNDER_OS > 0 && !defined(DT_NO_THREADS)
@@ -0,0 +1,126 @@
+/**
+ * @file CoarseClock.h
+ * @brief This file contains class CoarseClock, which is opt-in service of cached current time.
+ *
+ * Background thread reads system time with a given period and publishes current UTC and local time into one cache line.
+ * Reading of current time is then only one relaxed atomic load, but value is accurate only to update period.
+ * It is available only on systems with OS and threads (not with DT_NO_THREADS).
+ *
+ * @see CoarseClock
+ *
+ * # Credits
+ * @author Matej Fitoš
+ */
+
+#ifndef _COARSE_CLOCK_H
+#define _COARSE_CLOCK_H
+
+#include "DateTimeSysSync.h"
+
+#if DT_UNDER_OS > 0 && !defined(DT_NO_THREADS)
+#include <atomic>
+
+#ifndef DT_COARSE_CLOCK_PERIOD
+#define DT_COARSE_CLOCK_PERIOD	(1000L)	//Default period of updating of CoarseClock in microseconds
+#endif // !DT_COARSE_CLOCK_PERIOD
+
+/**
+* @class CoarseClock
+* @brief Cached current time updated by background thread. When clock is not running, current time is read directly from system.
+*
+* Local time uses system time zone info (TimeZoneInfo::getSystemTZInfo()) and DST is evaluated only by background thread.
+* @code{.cpp}
+* CoarseClock::start(500); //Time is updated every 500 us
+* bool isDST;
+* DateTime local = CoarseClock::now(isDST);
+* DateTime utc = CoarseClock::nowUTC();
+* CoarseClock::stop();
+* @endcode
+*/
+class CoarseClock {
+public:
+
+	/**
+	* @brief Starts background thread, which updates current time. If thread is already running, only its period is changed.
+	* Current time is published before this function returns.
+	* @param period Period of updating in microseconds.
+	* @return Returns false if period is not positive.
+	*/
+	static bool start(int64_t period = DT_COARSE_CLOCK_PERIOD);
+
+	/**
+	* @brief Stops background thread and waits until it ends. Current time is then read directly from system.
+	*/
+	static void stop();
+
+	/**
+	* @brief Checks if background thread is running.
+	*/
+	static bool isRunning();
+
+	/**
+	* @brief Gets current UTC time published by background thread.
+	* @return Returns cached UTC time, which can be late at most by update period.
+	*/
+	inline static DateTime nowUTC() {
+		int64_t raw = slot.utc.load(std::memory_order_relaxed);
+		if (raw == 0) raw = readUTC();
+		return DateTime(raw);
+	}
+
+	/**
+	* @brief Gets current local time published by background thread.
+	* @param[out] isDST True if DST offset is applied.
+	* @return Returns cached local time, which can be late at most by update period.
+	*/
+	inline static DateTime now(bool& isDST) {
+		//DST flag is in the lowest bit, so local time and flag are always read together
+		int64_t raw = slot.local.load(std::memory_order_relaxed);
+		if (raw == 0) raw = readLocal();
+		isDST = (raw & 1) != 0;
+		return DateTime(raw & ~1LL);
+	}
+
+	/**
+	* @brief Gets current local time published by background thread.
+	* @return Returns cached local time, which can be late at most by update period.
+	*/
+	inline static DateTime now() {
+		bool isDST;
+		return now(isDST);
+	}
+
+private:
+	/**
+	* @struct coarse_clock_slot_s
+	* @brief Published time. Both values are 0 when clock is not running.
+	*/
+	struct alignas(64) coarse_clock_slot_s {
+		std::atomic<int64_t> utc;
+		std::atomic<int64_t> local;	//Local time with resolution of 2 us, the lowest bit is DST flag
+	};
+
+	static coarse_clock_slot_s slot;
+
+	/**
+	* @brief Reads UTC time from system.
+	*/
+	static int64_t readUTC();
+
+	/**
+	* @brief Reads local time from system.
+	* @return Returns local time with DST flag in the lowest bit.
+	*/
+	static int64_t readLocal();
+
+	/**
+	* @brief Reads system time and publishes it.
+	*/
+	static void update();
+
+	static void run();
+};
+
+#endif // DT_UNDER_OS > 0 && !defined(DT_NO_THREADS)
+
+#endif // !_COARSE_CLOCK_H
@@ -0,0 +1,81 @@
+#include "DSTScheduler.h"
+
+#if DT_UNDER_OS > 0 || defined(ESP32)
+#include <vector>
+
+DSTScheduler::queue_t::iterator DSTScheduler::schedule(DateTimeTZSysSync* clock) {
+	if (clock->nextDSTTransitionDT == DateTime::MaxValue) return queue.end();
+	int64_t syncTime = (int64_t)clock->getRawSyncTime();
+	int64_t remaining = clock->nextDSTTransitionDT.getRaw() - clock->getRawNoSync();
+	if (remaining < 0) remaining = 0; //Transition was already reached
+	//Rounding up, so value of clock is not before transition, when it is recalculated
+	int64_t due = syncTime + (remaining + DT_SYNC_RESOLUTION - 1) / DT_SYNC_RESOLUTION;
+	return queue.insert(std::make_pair(due, clock));
+}
+
+bool DSTScheduler::add(DateTimeTZSysSync& clock) {
+	std::lock_guard<std::mutex> lock(mutex);
+	if (clocks.find(&clock) != clocks.end()) return false;
+	clocks[&clock] = schedule(&clock);
+	return true;
+}
+
+bool DSTScheduler::remove(DateTimeTZSysSync& clock) {
+	std::lock_guard<std::mutex> lock(mutex);
+	auto it = clocks.find(&clock);
+	if (it == clocks.end()) return false;
+	if (it->second != queue.end()) queue.erase(it->second);
+	clocks.erase(it);
+	return true;
+}
+
+bool DSTScheduler::reschedule(DateTimeTZSysSync& clock) {
+	std::lock_guard<std::mutex> lock(mutex);
+	auto it = clocks.find(&clock);
+	if (it == clocks.end()) return false;
+	if (it->second != queue.end()) queue.erase(it->second);
+	it->second = schedule(&clock);
+	return true;
+}
+
+size_t DSTScheduler::run() {
+	std::lock_guard<std::mutex> lock(mutex);
+	if (queue.empty()) return 0;
+	int64_t now = (int64_t)DT_SYNC_FUNC();
+	if (queue.begin()->first > now) return 0;
+
+	//All clocks, which reached transition, are taken out first, so recalculated clock cannot be visited twice
+	std::vector<DateTimeTZSysSync*> due;
+	queue_t::iterator end = queue.upper_bound(now);
+	for (queue_t::iterator it = queue.begin(); it != end; ++it) {
+		due.push_back(it->second);
+	}
+	queue.erase(queue.begin(), end);
+
+	for (DateTimeTZSysSync* clock : due) {
+		clock->recalcDST();
+		clocks[clock] = schedule(clock);
+	}
+	return due.size();
+}
+
+TimeSpan DSTScheduler::getTimeToNextRun() const {
+	std::lock_guard<std::mutex> lock(mutex);
+	if (queue.empty()) return TimeSpan::MaxValue;
+	int64_t remaining = queue.begin()->first - (int64_t)DT_SYNC_FUNC();
+	if (remaining <= 0) return TimeSpan::Zero;
+	return TimeSpan(remaining * DT_SYNC_RESOLUTION);
+}
+
+size_t DSTScheduler::size() const {
+	std::lock_guard<std::mutex> lock(mutex);
+	return clocks.size();
+}
+
+void DSTScheduler::clear() {
+	std::lock_guard<std::mutex> lock(mutex);
+	queue.clear();
+	clocks.clear();
+}
+
+#endif // DT_UNDER_OS > 0 || defined(ESP32)
@@ -0,0 +1,106 @@
+/**
+ * @file DSTScheduler.h
+ * @brief This file contains class DSTScheduler, which calls DateTimeTZSysSync::recalcDST() of many clocks only at their DST transitions.
+ *
+ * Each registered clock is scheduled at tick of sync clock, at which its value reaches its next DST transition.
+ * Clocks are ordered by this tick, so checking of scheduler is only one comparison and clocks, which reached
+ * their transitions, are recalculated together.
+ *
+ * @see DSTScheduler
+ *
+ * # Credits
+ * @author Matej Fitoš
+ */
+
+#ifndef _DST_SCHEDULER_H
+#define _DST_SCHEDULER_H
+
+#include "DateTimeTZSysSync.h"
+
+#if DT_UNDER_OS > 0 || defined(ESP32)
+#include <map>
+#include <mutex>
+#include <unordered_map>
+
+/**
+* @class DSTScheduler
+* @brief Scheduler of DST recalculation of registered DateTimeTZSysSync clocks.
+*
+* Scheduler stores only pointers, so registered clock has to be removed before it is destroyed or moved.
+* When registered clock is set (set(), setTimeZone(), ...), its next DST transition changes and reschedule() should be called.
+* Clock, which was not rescheduled, is recalculated at its old transition time and then it is scheduled correctly again.
+* Clocks without DST stay registered, but they are never recalculated.
+* @code{.cpp}
+* DSTScheduler scheduler;
+* scheduler.add(clock1);
+* scheduler.add(clock2);
+*
+* //Main loop:
+* scheduler.run(); //Only one comparison, when no clock reached its DST transition
+* @endcode
+* @note Clocks are recalculated in thread, which calls run(). If clocks are read by another thread, SharedClock should be used instead.
+*/
+class DSTScheduler {
+public:
+
+	/**
+	* @brief Registers clock. Clock is scheduled at time of its next DST transition.
+	* @param clock Clock to register.
+	* @return Returns false if clock is already registered.
+	*/
+	bool add(DateTimeTZSysSync& clock);
+
+	/**
+	* @brief Unregisters clock.
+	* @param clock Clock to unregister.
+	* @return Returns false if clock was not registered.
+	*/
+	bool remove(DateTimeTZSysSync& clock);
+
+	/**
+	* @brief Schedules clock again using its current next DST transition. It should be called after registered clock was set.
+	* @param clock Registered clock.
+	* @return Returns false if clock is not registered.
+	*/
+	bool reschedule(DateTimeTZSysSync& clock);
+
+	/**
+	* @brief Calls recalcDST() of all clocks, which reached their DST transition, and schedules them at their next transition.
+	* @return Returns count of recalculated clocks.
+	*/
+	size_t run();
+
+	/**
+	* @brief Gets time remaining until the nearest scheduled DST transition. It can be used for sleeping between calls of run().
+	* @return Returns remaining time, TimeSpan::Zero if some transition was already reached or TimeSpan::MaxValue
+	* if no clock is scheduled.
+	*/
+	TimeSpan getTimeToNextRun() const;
+
+	/**
+	* @brief Gets count of registered clocks.
+	*/
+	size_t size() const;
+
+	/**
+	* @brief Unregisters all clocks.
+	*/
+	void clear();
+
+private:
+	typedef std::multimap<int64_t, DateTimeTZSysSync*> queue_t;
+
+	/**
+	* @brief Schedules clock at tick of sync clock, at which its value reaches its next DST transition.
+	* @return Returns position in queue or end of queue, if clock has no next DST transition.
+	*/
+	queue_t::iterator schedule(DateTimeTZSysSync* clock);
+
+	queue_t queue;													//Scheduled clocks ordered by tick of sync clock
+	std::unordered_map<DateTimeTZSysSync*, queue_t::iterator> clocks;	//Registered clocks and their positions in queue
+	mutable std::mutex mutex;
+};
+
+#endif // DT_UNDER_OS > 0 || defined(ESP32)
+
+#endif // !_DST_SCHEDULER_H
@@ -0,0 +1,182 @@
+/**
+ * @file DTString.h
+ * @brief This file contains class DTString, which is string with fixed capacity stored inline (without heap allocation).
+ *
+ * @see DTString
+ *
+ * # Credits
+ * @author Matej Fitoš
+ */
+
+#ifndef _DT_STRING_H
+#define _DT_STRING_H
+
+#include "DateTimeHelpers.h"
+
+#ifndef ARDUINO
+#include <cstring>
+#endif // !ARDUINO
+
+#if DT_UNDER_OS > 0
+#include <ostream>
+#endif // DT_UNDER_OS > 0
+
+#ifndef DT_STRING_DEFAULT_CAPACITY
+#define DT_STRING_DEFAULT_CAPACITY	(48)	//Default capacity of DTString, which is enough for any ISO 8601 string
+#endif // !DT_STRING_DEFAULT_CAPACITY
+
+#ifndef DT_APPEND_BUFFER_SIZE
+#define DT_APPEND_BUFFER_SIZE		(128)	//Size of stack buffer used by appendTo() and formatTo() member functions
+#endif // !DT_APPEND_BUFFER_SIZE
+
+/**
+* @class DTString
+* @brief String with fixed capacity, which is stored inline, so it can be returned by value without any heap allocation.
+* It is returned by toDTString() member functions of DateTime, DateTimeTZ and TimeSpan. Longer strings are truncated.
+* @tparam N Maximum count of characters without null terminator.
+*/
+template<size_t N = DT_STRING_DEFAULT_CAPACITY>
+class DTString {
+public:
+	/**
+	* @brief Creates empty string.
+	*/
+	constexpr DTString() {}
+
+	/**
+	* @brief Creates string from null terminated string. String is truncated, if it is longer than capacity.
+	* @param str Null terminated string.
+	*/
+	DTString(const char* str) {
+		assign(str, strlen(str));
+	}
+
+	/**
+	* @brief Assigns characters to string. String is truncated, if it is longer than capacity.
+	* @param str Array of characters.
+	* @param length Count of characters.
+	*/
+	void assign(const char* str, size_t length) {
+		if (length > N) length = N;
+		memcpy(value, str, length);
+		setLength(length);
+	}
+
+	/**
+	* @brief Sets length of string and inserts null terminator. It is used after characters were written directly to data().
+	* @param length New length of string, it is limited to capacity.
+	*/
+	void setLength(size_t length) {
+		if (length > N) length = N;
+		len = length;
+		value[len] = '\0';
+	}
+
+	/**
+	* @brief Clears the string.
+	*/
+	void clear() {
+		setLength(0);
+	}
+
+	/**
+	* @brief Gets null terminated string.
+	*/
+	constexpr const char* c_str() const {
+		return value;
+	}
+
+	/**
+	* @brief Gets buffer of string. Buffer has size capacity() + 1 including null terminator.
+	*/
+	char* data() {
+		return value;
+	}
+
+	/**
+	* @brief Gets buffer of string.
+	*/
+	constexpr const char* data() const {
+		return value;
+	}
+
+	/**
+	* @brief Gets length of string without null terminator.
+	*/
+	constexpr size_t length() const {
+		return len;
+	}
+
+	/**
+	* @brief Gets length of string without null terminator.
+	*/
+	constexpr size_t size() const {
+		return len;
+	}
+
+	/**
+	* @brief Gets maximum count of characters without null terminator.
+	*/
+	static constexpr size_t capacity() {
+		return N;
+	}
+
+	/**
+	* @brief Checks if string is empty.
+	*/
+	constexpr bool empty() const {
+		return len == 0;
+	}
+
+	constexpr const char* begin() const {
+		return value;
+	}
+
+	constexpr const char* end() const {
+		return value + len;
+	}
+
+	constexpr char operator[](size_t index) const {
+		return value[index];
+	}
+
+	template<size_t M>
+	bool operator==(const DTString<M>& other) const {
+		return len == other.length() && memcmp(value, other.c_str(), len) == 0;
+	}
+
+	template<size_t M>
+	bool operator!=(const DTString<M>& other) const {
+		return !(*this == other);
+	}
+
+	bool operator==(const char* other) const {
+		return strcmp(value, other) == 0;
+	}
+
+	bool operator!=(const char* other) const {
+		return strcmp(value, other) != 0;
+	}
+
+#ifdef ARDUINO
+	operator String() const {
+		return String(value);
+	}
+#else
+	operator std::string() const {
+		return std::string(value, len);
+	}
+#endif // ARDUINO
+
+#if DT_UNDER_OS > 0
+	friend auto operator<<(std::ostream& os, const DTString& str) -> std::ostream& {
+		return os.write(str.value, str.len);
+	}
+#endif //DT_UNDER_OS > 0
+
+private:
+	char value[N + 1] = {};
+	size_t len = 0;
+};
+
+#endif // !_DT_STRING_H
@@ -16,6 +16,9 @@
 #define _DATE_TIME_BASE_H
 
 #include "TimeZone.h"
+#include "DateTimeFormat.h"
+#include "DateTimeParser.h"
+#include "DTString.h"
 
 
 /**
@@ -70,7 +73,7 @@ public:
     /**
     * @brief Default constructor, which set DateTime to the 0001/01/01 00:00:00.000000 with no time zone and DST adjustment.
     */
-    DateTimeBase()
+    DT_CONSTEXPR14 DateTimeBase()
     {
         syncBeforeSet();
     }
@@ -79,7 +82,7 @@ public:
     * @brief Constructor, which sets DateTime from raw value.
     * @param raw Raw value in microseconds from the begin of epoch (0001/1/1).
     */
-    explicit DateTimeBase(int64_t raw)
+    explicit DT_CONSTEXPR14 DateTimeBase(int64_t raw)
     {
         syncBeforeSet();
         setRawTime(raw);
@@ -89,7 +92,7 @@ public:
     * @brief Sets DateTime from raw value.
     * @param raw Raw value in microseconds from the begin of epoch (0001/1/1).
     */
-    inline void setRaw(int64_t raw) {
+    DT_CONSTEXPR14 void setRaw(int64_t raw) {
         syncBeforeSet();
         setRawTime(raw);
     }
@@ -98,7 +101,7 @@ public:
     * @brief Gets raw date time value.
     * @return Returns raw value in microseconds from the begin of epoch (0001/1/1).
     */
-    inline int64_t getRaw() const {
+    constexpr int64_t getRaw() const {
         return getRawTime();
     }
 
@@ -106,7 +109,7 @@ public:
     * @brief Gets raw date time value, which is not synchronized.
     * @return Returns raw value in microseconds from the begin of epoch (0001/1/1).
     */
-    inline int64_t getRawNoSync() const {
+    constexpr int64_t getRawNoSync() const {
         return getRawTimeNoSync();
     }
 
@@ -115,7 +118,7 @@ public:
     * @note This member function copyies only raw value.
     */
     template<class T>
-    void set(const DateTimeBase<T>& dt) {
+    DT_CONSTEXPR14 void set(const DateTimeBase<T>& dt) {
         syncBeforeSet();
         setRawTime(dt.getRawTime());
     }
@@ -123,80 +126,80 @@ public:
     /**
     * @brief Explicit conversion operator to int64_t, which returns synchronized raw value, same getRaw() function. 
     */
-    explicit operator int64_t() const{
+    explicit constexpr operator int64_t() const{
         return getRaw();
     }
 
     //Arithmetic operators
 
-    derivedSyncClass operator+(const TimeSpan& ts2) const {
+    DT_CONSTEXPR14 derivedSyncClass operator+(const TimeSpan& ts2) const {
         derivedSyncClass ret = *static_cast<const derivedSyncClass*>(this);
         ret.addRawTime(ts2.getRaw());
         return ret;
     }
 
-    derivedSyncClass operator+(const int64_t raw) const {
+    DT_CONSTEXPR14 derivedSyncClass operator+(const int64_t raw) const {
         derivedSyncClass ret = *static_cast<const derivedSyncClass*>(this);
         ret.addRawTime(raw);
         return ret;
     }
 
-    derivedSyncClass operator-(const TimeSpan& ts2) const {
+    DT_CONSTEXPR14 derivedSyncClass operator-(const TimeSpan& ts2) const {
         derivedSyncClass ret = *static_cast<const derivedSyncClass*>(this);
         ret.addRawTime(-ts2.getRaw());
         return ret;
     }
 
-    derivedSyncClass operator-(const int64_t raw) const {
+    DT_CONSTEXPR14 derivedSyncClass operator-(const int64_t raw) const {
         derivedSyncClass ret = *static_cast<const derivedSyncClass*>(this);
         ret.addRawTime(-raw);
         return ret;
     }
 
     template<typename T>
-    TimeSpan operator-(const DateTimeBase<T>& raw) const {
+    constexpr TimeSpan operator-(const DateTimeBase<T>& raw) const {
         //Just sync time here
         return TimeSpan(getRawTime() - raw.getRawTime());
     }
 
 
-    derivedSyncClass operator+=(const TimeSpan& ts2) {
+    DT_CONSTEXPR14 derivedSyncClass operator+=(const TimeSpan& ts2) {
         addRawTime(ts2.getRaw());
         return *static_cast<derivedSyncClass*>(this);
     }
 
-    derivedSyncClass operator+=(const int64_t _raw) {
+    DT_CONSTEXPR14 derivedSyncClass operator+=(const int64_t _raw) {
         addRawTime(_raw);
         return *static_cast<derivedSyncClass*>(this);
     }
 
-    derivedSyncClass& operator++() {
+    DT_CONSTEXPR14 derivedSyncClass& operator++() {
         addRawTime(1);
         return *static_cast<derivedSyncClass*>(this);
     }
 
-    derivedSyncClass operator++(int) {
+    DT_CONSTEXPR14 derivedSyncClass operator++(int) {
         derivedSyncClass ret = *static_cast<derivedSyncClass*>(this);
         addRawTime(1);
         return ret;
     }
 
-    derivedSyncClass operator-=(const TimeSpan& ts2) {
+    DT_CONSTEXPR14 derivedSyncClass operator-=(const TimeSpan& ts2) {
         addRawTime(-ts2.getRaw());
         return *static_cast<derivedSyncClass*>(this);
     }
 
-    derivedSyncClass operator-=(const int64_t _raw) {
+    DT_CONSTEXPR14 derivedSyncClass operator-=(const int64_t _raw) {
         addRawTime(-_raw);
         return *static_cast<derivedSyncClass*>(this);
     }
 
-    derivedSyncClass& operator--() {
+    DT_CONSTEXPR14 derivedSyncClass& operator--() {
         addRawTime(-1);
         return *static_cast<derivedSyncClass*>(this);
     }
 
-    derivedSyncClass operator--(int) {
+    DT_CONSTEXPR14 derivedSyncClass operator--(int) {
         derivedSyncClass ret = *static_cast<derivedSyncClass*>(this);
         addRawTime(-1);
         return ret;
@@ -205,63 +208,63 @@ public:
     //Comparison operators
 
     template<class T>
-    bool operator==(DateTimeBase<T>& dt2) const{
+    constexpr bool operator==(const DateTimeBase<T>& dt2) const{
         return getRawTime() == dt2.getRawTime();
     }
 
-    bool operator==(int64_t mil) const {
+    constexpr bool operator==(int64_t mil) const {
         return getRawTime() == mil;
     }
 
     template<class T>
-    bool operator!=(DateTimeBase<T>& dt2) const {
+    constexpr bool operator!=(const DateTimeBase<T>& dt2) const {
         return getRawTime() != dt2.getRawTime();
     }
 
-    bool operator!=(int64_t mil) const {
+    constexpr bool operator!=(int64_t mil) const {
         return getRawTime() != mil;
     }
 
     template<class T>
-    bool operator>=(DateTimeBase<T>& dt2) const {
+    constexpr bool operator>=(const DateTimeBase<T>& dt2) const {
         return getRawTime() >= dt2.getRawTime();
     }
 
-    bool operator>=(int64_t mil) const {
+    constexpr bool operator>=(int64_t mil) const {
         return getRawTime() >= mil;
     }
 
     template<class T>
-    bool operator<=(DateTimeBase<T>& dt2) const {
+    constexpr bool operator<=(const DateTimeBase<T>& dt2) const {
         return getRawTime() <= dt2.getRawTime();
     }
 
-    bool operator<=(int64_t mil) const {
+    constexpr bool operator<=(int64_t mil) const {
         return getRawTime() <= mil;
     }
 
     template<class T>
-    bool operator<(DateTimeBase<T>& dt2) const {
+    constexpr bool operator<(const DateTimeBase<T>& dt2) const {
         return getRawTime() < dt2.getRawTime();
     }
 
-    bool operator<(int64_t mil) const {
+    constexpr bool operator<(int64_t mil) const {
         return getRawTime() < mil;
     }
 
     template<class T>
-    bool operator>(DateTimeBase<T>& dt2) const {
+    constexpr bool operator>(const DateTimeBase<T>& dt2) const {
         return getRawTime() > dt2.getRawTime();
     }
 
-    bool operator>(int64_t mil) const {
+    constexpr bool operator>(int64_t mil) const {
         return getRawTime() > mil;
     }
 
     /**
     * @brief Gets Unix time, which is count of seconds from 1970/01/01.
     */
-    inline int64_t getUnix() const {
+    constexpr int64_t getUnix() const {
         return (getRawTime() - 62135596800000000LL) / SECOND;
     }
 
@@ -270,7 +273,7 @@ public:
     * @note Microseconds and milliseconds fields will be set to 0.
     * @param unixTime Unix time, which is count of seconds from 1970/01/01.
     */
-    static derivedSyncClass fromUnix(int64_t unixTime) {
+    static DT_CONSTEXPR14 derivedSyncClass fromUnix(int64_t unixTime) {
         unixTime = (unixTime * SECOND) + 62135596800000000LL;
         return derivedSyncClass(unixTime);
     }
@@ -388,7 +391,7 @@ protected:
     * If synchronization is not supported, getRawTimeNoSync() is called.
     * @note It is recommended to call this member function instead of getRawTimeNoSync().
     */
-    inline int64_t getRawTime() const {
+    DT_CONSTEXPR14 int64_t getRawTime() const {
         CONSTEXPR_IF(has_getRawTimeSync<derivedSyncClass>::value) {
             return static_cast<const derivedSyncClass*>(this)->getRawTimeSync();
         }
@@ -401,7 +404,7 @@ protected:
     * @brief Gets raw time value without synchronization.
     * @note It is recommended to call getRawTime() instead of getRawTimeNoSync().
     */
-    inline int64_t getRawTimeNoSync() const {
+    constexpr int64_t getRawTimeNoSync() const {
         return static_cast<const derivedSyncClass*>(this)->getRawValueDer();
     }
 
@@ -413,7 +416,7 @@ protected:
     * do not call it when adding offset to raw time.
     * @param value Raw value to set.
     */
-    inline void setRawTime(int64_t value) {
+    DT_CONSTEXPR14 void setRawTime(int64_t value) {
         CONSTEXPR_IF (has_setRawTimeTD<derivedSyncClass>::value) {
             static_cast<derivedSyncClass*>(this)->setRawTimeTD(value);
         }
@@ -429,7 +432,7 @@ protected:
     * @note It is recommended to call setRawTime() instead of setRawTimeNoTD().
     * @param value Raw value to set.
     */
-    inline void setRawTimeNoTD(int64_t value) {
+    DT_CONSTEXPR14 void setRawTimeNoTD(int64_t value) {
         static_cast<derivedSyncClass*>(this)->setRawValueDer(value);
     }
 
@@ -440,7 +443,7 @@ protected:
     * @note Do not need to call syncBeforeSet() before this member function.
     * @note It is recommended to call this member function instead of addRawTimeNoTD().
     */
-    inline void addRawTime(int64_t value) {
+    DT_CONSTEXPR14 void addRawTime(int64_t value) {
         CONSTEXPR_IF (has_addRawTimeTD<derivedSyncClass>::value) {
             static_cast<derivedSyncClass*>(this)->addRawTimeTD(value);
         }
@@ -455,7 +458,7 @@ protected:
     * @note Do not need to call syncBeforeSet() before this member function.
     * @note It is recommended to call addRawTime() instead of addRawTimeNoTD().
     */
-    inline void addRawTimeNoTD(int64_t value) {
+    DT_CONSTEXPR14 void addRawTimeNoTD(int64_t value) {
         static_cast<derivedSyncClass*>(this)->addRawValueDer(value);
     }
 
@@ -464,7 +467,7 @@ protected:
     * called, when offset is added to DateTime (for example when using addHours() or + operator). Synchronization is done here.
     * @note It is recommended to call it before raw value calculation or at the begin of member function.
     */
-    inline void syncBeforeSet() {
+    DT_CONSTEXPR14 void syncBeforeSet() {
         CONSTEXPR_IF (has_preSetSync<derivedSyncClass>::value) {
             static_cast<derivedSyncClass*>(this)->preSetSync();
         }
@@ -473,7 +476,7 @@ protected:
     * @brief This function has to be called before setting and calculating raw value. Synchronization is done here.
     * @return Returns raw value after synchronization.
     */
-    inline int64_t getAndSyncBeforeSet() {
+    DT_CONSTEXPR14 int64_t getAndSyncBeforeSet() {
         CONSTEXPR_IF (has_getAndPreSetSync<derivedSyncClass>::value) {
             return static_cast<derivedSyncClass*>(this)->getAndPreSetSync();
         }
@@ -529,7 +532,7 @@ public:
     /**
     * @brief Default constructor, which set DateTime to the 0001/01/01 00:00:00.000000 with no time zone and DST adjustment.
     */
-    DateTimeRawBase():
+    constexpr DateTimeRawBase():
         rawValue(0)
     {
         //DateTimeBase<derivedSyncClass>::syncBeforeSet();
@@ -540,10 +543,9 @@ public:
     * @brief Constructor, which sets DateTime from raw value.
     * @param raw Raw value in microseconds from the begin of epoch (0001/1/1).
     */
-    DateTimeRawBase(int64_t raw) : DateTimeBase<derivedSyncClass>(raw)
+    DT_CONSTEXPR14 DateTimeRawBase(int64_t raw)
     {
-        /*DateTimeBase<derivedSyncClass>::syncBeforeSet();
-        DateTimeBase<derivedSyncClass>::setRawTime(raw);*/
+        DateTimeBase<derivedSyncClass>::setRawTime(raw);
     }
 
     /**
@@ -552,7 +554,7 @@ public:
     * @param month Month from 1 to 12.
     * @param day Day of month from 1 to 28/29/30/31.
     */
-    DateTimeRawBase(int32_t year, uint8_t month, uint8_t day)
+    DT_CONSTEXPR14 DateTimeRawBase(int32_t year, uint8_t month, uint8_t day)
     {
         set(year, month, day);
     }
@@ -568,7 +570,7 @@ public:
     * @param milliseconds Milliseconds from 0 to 999.
     * @param microseconds Microseconds from 0 to 999.
     */
-    DateTimeRawBase(int32_t year, uint8_t month, uint8_t day, hour_t hours, uint8_t minutes = 0, uint8_t seconds = 0, uint16_t milliseconds = 0, uint16_t microseconds = 0)
+    DT_CONSTEXPR14 DateTimeRawBase(int32_t year, uint8_t month, uint8_t day, hour_t hours, uint8_t minutes = 0, uint8_t seconds = 0, uint16_t milliseconds = 0, uint16_t microseconds = 0)
     {
         set(year, month, day, hours, minutes, seconds, milliseconds, microseconds);
     }
@@ -577,7 +579,7 @@ public:
     * @brief Constructor, which creates DateTime from date_time_s.
     * @param dt_s date_time_s structure with date and time fields.
     */
-    DateTimeRawBase(date_time_s dt_s)
+    DT_CONSTEXPR14 DateTimeRawBase(date_time_s dt_s)
     {
         set(dt_s);
     }
@@ -586,7 +588,7 @@ public:
     * @brief Constructor, which creates DateTime from time_s.
     * @param t_s time_s structure with time fields.
     */
-    DateTimeRawBase(time_s t_s)
+    DT_CONSTEXPR14 DateTimeRawBase(time_s t_s)
     {
         set(t_s);
     }
@@ -595,7 +597,7 @@ public:
     * @brief Constructor, which creates DateTime from date_s.
     * @param d_s date_s structure with date fields.
     */
-    DateTimeRawBase(date_s d_s)
+    DT_CONSTEXPR14 DateTimeRawBase(date_s d_s)
     {
         set(d_s);
     }
@@ -604,7 +606,7 @@ public:
     * @brief Constructor, which creates DateTime from tm.
     * @param dt_s Date and time specified by tm structure.
     */
-    DateTimeRawBase(tm dt_s)
+    DT_CONSTEXPR14 DateTimeRawBase(tm dt_s)
     {
         set(dt_s);
     }
@@ -614,7 +616,7 @@ public:
     * the fastest method if you want to get all fields.
     * @return Calculates all date and time fields, which are returned as date_time_s structure.
     */
-    date_time_s getDateTimeStruct() const {
+    constexpr date_time_s getDateTimeStruct() const {
         return dtlib::rawToDateTime(DateTimeBase<derivedSyncClass>::getRawTime());
     }
 
@@ -623,7 +625,7 @@ public:
     * the fastest method if you want to get all date fields.
     * @return Calculates all date fields, which are returned as date_s structure.
     */
-    date_s getDateStruct() const {
+    constexpr date_s getDateStruct() const {
         return dtlib::rawToDate(DateTimeBase<derivedSyncClass>::getRawTime());
     }
 
@@ -632,14 +634,14 @@ public:
     * the fastest method if you want to get all time fields.
     * @return Calculates all time fields, which are returned as time_s structure.
     */
-    time_s getTimeStruct() const {
+    constexpr time_s getTimeStruct() const {
         return dtlib::rawToTime(DateTimeBase<derivedSyncClass>::getRawTime());
     }
 
     /**
     * @brief Gets the date component of this instance.
     */
-    derivedSyncClass getDate() const {
+    DT_CONSTEXPR14 derivedSyncClass getDate() const {
         derivedSyncClass ret(*this);
         ret -= ret.getMicrosecondsOfDay();
         return ret;
@@ -650,7 +652,7 @@ public:
     * functions, if you want to set all fields.
     * @param dt_s date_time_s structure, which contains all date and time fields.
     */
-    void set(date_time_s dt_s) {
+    DT_CONSTEXPR14 void set(date_time_s dt_s) {
         DateTimeBase<derivedSyncClass>::syncBeforeSet();
         DateTimeBase<derivedSyncClass>::setRawTime(dtlib::dateTimeToRaw(dt_s));
     }
@@ -667,7 +669,7 @@ public:
     * @param milliseconds Milliseconds from 0 to 999.
     * @param microseconds Microseconds from 0 to 999.
     */
-    void set(int32_t year, uint8_t month, uint8_t day, hour_t hours, uint8_t minutes = 0, uint8_t seconds = 0, uint16_t milliseconds = 0, uint16_t microseconds = 0) {
+    DT_CONSTEXPR14 void set(int32_t year, uint8_t month, uint8_t day, hour_t hours, uint8_t minutes = 0, uint8_t seconds = 0, uint16_t milliseconds = 0, uint16_t microseconds = 0) {
         DateTimeBase<derivedSyncClass>::syncBeforeSet();
         DateTimeBase<derivedSyncClass>::setRawTime(dtlib::dateTimeToRaw(date_time_s(year, month, day, hours, minutes, seconds, milliseconds, microseconds )));
     }
@@ -678,7 +680,7 @@ public:
     * @note All time fields are set to zero.
     * @param d_s date_s structure, which contains all date fields.
     */
-    void set(date_s d_s) {
+    DT_CONSTEXPR14 void set(date_s d_s) {
         DateTimeBase<derivedSyncClass>::syncBeforeSet();
         DateTimeBase<derivedSyncClass>::setRawTime(dtlib::dateToRaw(d_s));
     }
@@ -690,7 +692,7 @@ public:
     * @param month Month from 1 to 12.
     * @param day Day of month from 1 to 28/29/30/31.
     */
-    void set(int32_t year, uint8_t month, uint8_t day) {
+    DT_CONSTEXPR14 void set(int32_t year, uint8_t month, uint8_t day) {
         DateTimeBase<derivedSyncClass>::syncBeforeSet();
         DateTimeBase<derivedSyncClass>::setRawTime(dtlib::dateToRaw(date_s(year, month, day)));
     }
@@ -701,7 +703,7 @@ public:
     * @note Date is set to 0001/01/01 A.D.
     * @param t_s time_s structure, which contains all time fields.
     */
-    void set(time_s t_s) {
+    DT_CONSTEXPR14 void set(time_s t_s) {
         DateTimeBase<derivedSyncClass>::syncBeforeSet();
         DateTimeBase<derivedSyncClass>::setRawTime(dtlib::timeToRaw(t_s));
     }
@@ -710,7 +712,7 @@ public:
     * @brief Sets DateTime from tm structure.
     * @param dt_s Date and time specified by tm structure.
     */
-    void set(tm time)
+    DT_CONSTEXPR14 void set(tm time)
     {
         DateTimeBase<derivedSyncClass>::syncBeforeSet();
         date_time_s dt_s;
@@ -730,7 +732,7 @@ public:
     * @note To set time fields to zero, use set(date_s) member function.
     * @param d_s date_s structure, which contains all date fields.
     */
-    void setDate(date_s d_s) {
+    DT_CONSTEXPR14 void setDate(date_s d_s) {
         int64_t newRaw = DateTimeBase<derivedSyncClass>::getAndSyncBeforeSet();
         dtlib::setDateToRaw(newRaw, d_s);
         DateTimeBase<derivedSyncClass>::setRawTime(newRaw);
@@ -743,7 +745,7 @@ public:
     * @param month Month from 1 to 12.
     * @param day Day of month from 1 to 28/29/30/31.
     */
-    void setDate(int32_t year, uint8_t month, uint8_t day) {
+    DT_CONSTEXPR14 void setDate(int32_t year, uint8_t month, uint8_t day) {
         int64_t newRaw = DateTimeBase<derivedSyncClass>::getAndSyncBeforeSet();
         dtlib::setDateToRaw(newRaw, date_s{ year, month, day,0 });
         DateTimeBase<derivedSyncClass>::setRawTime(newRaw);
@@ -771,7 +773,7 @@ public:
     * @note To set date fields to 0001/01/01, use set(time_s) member function.
     * @param t_s time_s structure, which contains all time fields.
     */
-    void setTime(time_s t_s) {
+    DT_CONSTEXPR14 void setTime(time_s t_s) {
         int64_t newRaw = DateTimeBase<derivedSyncClass>::getAndSyncBeforeSet();
         dtlib::setTimeToRaw(newRaw, t_s);
         DateTimeBase<derivedSyncClass>::setRawTime(newRaw);
@@ -785,7 +787,7 @@ public:
     * @param milliseconds Milliseconds from 0 to 999.
     * @param microseconds Microseconds from 0 to 999.
     */
-    void setTime(hour_t hours, uint8_t minutes, uint8_t seconds, uint16_t milliseconds = 0, uint16_t microseconds = 0) {
+    DT_CONSTEXPR14 void setTime(hour_t hours, uint8_t minutes, uint8_t seconds, uint16_t milliseconds = 0, uint16_t microseconds = 0) {
         int64_t newRaw = DateTimeBase<derivedSyncClass>::getAndSyncBeforeSet();
         dtlib::setTimeToRaw(newRaw, time_s( hours, minutes, seconds, milliseconds, microseconds ));
         DateTimeBase<derivedSyncClass>::setRawTime(newRaw);
@@ -816,7 +818,7 @@ public:
     * (in range from 0 to 24). For more info see hour_t.
     * @note If you pass number as hours parameter, setHours24() is called.
     */
-    void setHours(hour_t hours) {
+    DT_CONSTEXPR14 void setHours(hour_t hours) {
         int64_t newRaw = DateTimeBase<derivedSyncClass>::getAndSyncBeforeSet();
         dtlib::setHoursToRaw(newRaw, hours);
         DateTimeBase<derivedSyncClass>::setRawTime(newRaw);
@@ -829,7 +831,7 @@ public:
     * @param hours New value to set. Hours in 12-hours format in range from 1 to 12.
     * @param isAM_ True if AM.
     */
-    void setHours12(uint8_t hours, bool isAM_) {
+    DT_CONSTEXPR14 void setHours12(uint8_t hours, bool isAM_) {
         int64_t newRaw = DateTimeBase<derivedSyncClass>::getAndSyncBeforeSet();
         dtlib::setHoursToRaw(newRaw, hour_t(hours, false, isAM));
         DateTimeBase<derivedSyncClass>::setRawTime(newRaw);
@@ -842,7 +844,7 @@ public:
     * @param hours New value to set. Hours in 24-hours format in range from 0 to 23.
     * @param isAM_ True if AM.
     */
-    void setHours24(uint8_t hours) {
+    DT_CONSTEXPR14 void setHours24(uint8_t hours) {
         int64_t newRaw = DateTimeBase<derivedSyncClass>::getAndSyncBeforeSet();
         dtlib::setHoursToRaw(newRaw, hour_t(hours, true));
         DateTimeBase<derivedSyncClass>::setRawTime(newRaw);
@@ -852,7 +854,7 @@ public:
     * @brief Adds hours to DateTime.
     * @param hours Hours to add.
     */
-    void addHours(int32_t hours) {
+    DT_CONSTEXPR14 void addHours(int32_t hours) {
         DateTimeBase<derivedSyncClass>::addRawTime(((int64_t)hours) * HOUR);
     }
 
@@ -860,7 +862,7 @@ public:
     * @brief Adds hours to DateTime.
     * @param hours Hours to add.
     */
-    void addHours(int64_t hours) {
+    DT_CONSTEXPR14 void addHours(int64_t hours) {
         DateTimeBase<derivedSyncClass>::addRawTime(hours * HOUR);
     }
 
@@ -870,7 +872,7 @@ public:
     * and if you want to get all date time fields, use getDateTimeStruct().
     * @return Returns hours field value in range from 0 to 23.
     */
-    hour_t getHours() const {
+    constexpr hour_t getHours() const {
         return dtlib::getHoursFromRaw(DateTimeBase<derivedSyncClass>::getRawTime());
     }
 
@@ -880,7 +882,7 @@ public:
     * and if you want to get all date time fields, use getDateTimeStruct().
     * @return Returns hours field value in range from 1 to 12.
     */
-    uint8_t getHours12() const {
+    DT_CONSTEXPR14 uint8_t getHours12() const {
         hour_t hours = dtlib::getHoursFromRaw(DateTimeBase<derivedSyncClass>::getRawTime());
         hours.convertTo12();
         return hours;
@@ -892,14 +894,14 @@ public:
     * and if you want to get all date time fields, use getDateTimeStruct().
     * @return Returns hours field value in range from 0 to 23.
     */
-    uint8_t getHours24() const {
+    constexpr uint8_t getHours24() const {
         return dtlib::getHoursFromRaw(DateTimeBase<derivedSyncClass>::getRawTime()); //No conversion needed
     }
 
     /**
     * @brief Returns true if current time period is AM.
     */
-    bool isAM() const {
+    constexpr bool isAM() const {
         return dtlib::getHoursFromRaw(DateTimeBase<derivedSyncClass>::getRawTime()).isAM();
     }
 
@@ -910,7 +912,7 @@ public:
     * and if you want to set all date time fields, use set().
     * @param minutes New value to set in range from 0 to 59.
     */
-    void setMinutes(uint8_t minutes) {
+    DT_CONSTEXPR14 void setMinutes(uint8_t minutes) {
         int64_t newRaw = DateTimeBase<derivedSyncClass>::getAndSyncBeforeSet();
         dtlib::setMinutesToRaw(newRaw, minutes);
         DateTimeBase<derivedSyncClass>::setRawTime(newRaw);
@@ -920,7 +922,7 @@ public:
     * @brief Adds minutes to DateTime.
     * @param minutes Minutes to add.
     */
-    void addMinutes(int32_t minutes) {
+    DT_CONSTEXPR14 void addMinutes(int32_t minutes) {
         DateTimeBase<derivedSyncClass>::addRawTime(((int64_t)minutes) * MINUTE);
     }
 
@@ -928,7 +930,7 @@ public:
     * @brief Adds minutes to DateTime.
     * @param minutes Minutes to add.
     */
-    void addMinutes(int64_t minutes) {
+    DT_CONSTEXPR14 void addMinutes(int64_t minutes) {
         DateTimeBase<derivedSyncClass>::addRawTime(minutes * MINUTE);
     }
 
@@ -938,7 +940,7 @@ public:
     * and if you want to get all date time fields, use getDateTimeStruct().
     * @return Returns minutes field value in range from 0 to 59.
     */
-    uint8_t getMinutes() const {
+    constexpr uint8_t getMinutes() const {
         return dtlib::getMinutesFromRaw(DateTimeBase<derivedSyncClass>::getRawTime());
     }
 
@@ -948,7 +950,7 @@ public:
     * and if you want to set all date time fields, use set().
     * @param seconds New value to set in range from 0 to 59.
     */
-    void setSeconds(uint8_t seconds) {
+    DT_CONSTEXPR14 void setSeconds(uint8_t seconds) {
         int64_t newRaw = DateTimeBase<derivedSyncClass>::getAndSyncBeforeSet();
         dtlib::setSecondsToRaw(newRaw, seconds);
         DateTimeBase<derivedSyncClass>::setRawTime(newRaw);
@@ -958,7 +960,7 @@ public:
     * @brief Adds seconds to DateTime.
     * @param seconds Seconds to add.
     */
-    void addSeconds(int32_t seconds) {
+    DT_CONSTEXPR14 void addSeconds(int32_t seconds) {
         DateTimeBase<derivedSyncClass>::addRawTime(((int64_t)seconds) * SECOND);
     }
 
@@ -966,7 +968,7 @@ public:
     * @brief Adds seconds to DateTime.
     * @param seconds Seconds to add.
     */
-    void addSeconds(int64_t seconds) {
+    DT_CONSTEXPR14 void addSeconds(int64_t seconds) {
         DateTimeBase<derivedSyncClass>::addRawTime(seconds * SECOND);
     }
 
@@ -976,7 +978,7 @@ public:
     * and if you want to get all date time fields, use getDateTimeStruct().
     * @return Returns seconds field value in range from 0 to 59.
     */
-    uint8_t getSeconds() const {
+    constexpr uint8_t getSeconds() const {
         return dtlib::getSecondsFromRaw(DateTimeBase<derivedSyncClass>::getRawTime());
     }
 
@@ -986,7 +988,7 @@ public:
     * and if you want to set all date time fields, use set().
     * @param milliseconds New value to set in range from 0 to 999.
     */
-    void setMilliseconds(uint16_t milliseconds) {
+    DT_CONSTEXPR14 void setMilliseconds(uint16_t milliseconds) {
         int64_t newRaw = DateTimeBase<derivedSyncClass>::getAndSyncBeforeSet();
         dtlib::setMillisToRaw(newRaw, milliseconds);
         DateTimeBase<derivedSyncClass>::setRawTime(newRaw);
@@ -996,7 +998,7 @@ public:
     * @brief Adds milliseconds to DateTime.
     * @param milliseconds Milliseconds to add.
     */
-    void addMilliseconds(int32_t milliseconds) {
+    DT_CONSTEXPR14 void addMilliseconds(int32_t milliseconds) {
         DateTimeBase<derivedSyncClass>::addRawTime(((int64_t)milliseconds) * MILLISECOND);
     }
 
@@ -1004,7 +1006,7 @@ public:
     * @brief Adds milliseconds to DateTime.
     * @param milliseconds Milliseconds to add.
     */
-    void addMilliseconds(int64_t milliseconds) {
+    DT_CONSTEXPR14 void addMilliseconds(int64_t milliseconds) {
         DateTimeBase<derivedSyncClass>::addRawTime(milliseconds * MILLISECOND);
     }
 
@@ -1014,7 +1016,7 @@ public:
     * and if you want to get all date time fields, use getDateTimeStruct().
     * @return Returns milliseconds field value in range from 0 to 999.
     */
-    uint16_t getMilliseconds() const {
+    constexpr uint16_t getMilliseconds() const {
         return dtlib::getMillisFromRaw(DateTimeBase<derivedSyncClass>::getRawTime());
     }
 
@@ -1024,7 +1026,7 @@ public:
     * and if you want to set all date time fields, use set().
     * @param microseconds New value to set in range from 0 to 999.
     */
-    void setMicroseconds(uint16_t microseconds) {
+    DT_CONSTEXPR14 void setMicroseconds(uint16_t microseconds) {
         int64_t newRaw = DateTimeBase<derivedSyncClass>::getAndSyncBeforeSet();
         dtlib::setMicrosToRaw(newRaw, microseconds);
         DateTimeBase<derivedSyncClass>::setRawTime(newRaw);
@@ -1034,7 +1036,7 @@ public:
     * @brief Adds microseconds to DateTime.
     * @param microseconds Microseconds to add.
     */
-    void addMicroseconds(int32_t microseconds) {
+    DT_CONSTEXPR14 void addMicroseconds(int32_t microseconds) {
         DateTimeBase<derivedSyncClass>::addRawTime(((int64_t)microseconds) * MICROSECOND);
     }
 
@@ -1042,7 +1044,7 @@ public:
     * @brief Adds microseconds to DateTime.
     * @param microseconds Microseconds to add.
     */
-    void addMicroseconds(int64_t microseconds) {
+    DT_CONSTEXPR14 void addMicroseconds(int64_t microseconds) {
         DateTimeBase<derivedSyncClass>::addRawTime(microseconds * MICROSECOND);
     }
 
@@ -1052,7 +1054,7 @@ public:
     * and if you want to get all date time fields, use getDateTimeStruct().
     * @return Returns microseconds field value in range from 0 to 999.
     */
-    uint16_t getMicroseconds() const {
+    constexpr uint16_t getMicroseconds() const {
         return dtlib::getMicrosFromRaw(DateTimeBase<derivedSyncClass>::getRawTime());
     }
 
@@ -1064,7 +1066,7 @@ public:
     * @param years New value of year to be set. Value can be in range from MIN_YEAR to MAX_YEAR except 0, because year 0 does not exists. Value
     * can be also negative, which means, that this is year B.C.
     */
-    void setYear(int32_t year) {
+    DT_CONSTEXPR14 void setYear(int32_t year) {
         int64_t newRaw = DateTimeBase<derivedSyncClass>::getAndSyncBeforeSet();
         dtlib::setYearToRaw(newRaw, year);
         DateTimeBase<derivedSyncClass>::setRawTime(newRaw);
@@ -1075,7 +1077,7 @@ public:
     * @note This function has slightly worst performance than setYear().
     * @param years Value to add. This value can be also negative, which means, that it will be subtracted.
     */
-    void addYears(int32_t years) {
+    DT_CONSTEXPR14 void addYears(int32_t years) {
         int64_t newRaw = DateTimeBase<derivedSyncClass>::getRawTime(); //No sync here
         dtlib::addYearsToRaw(newRaw, years);
         DateTimeBase<derivedSyncClass>::setRawTime(newRaw);
@@ -1089,14 +1091,14 @@ public:
     * @return Returns year from raw value. Value can be in range from MIN_YEAR to MAX_YEAR except 0, because year 0 does not exists. Value
     * can be also negative, which means, that this is year BC.
     */
-    int32_t getYear() const {
+    constexpr int32_t getYear() const {
         return dtlib::getYearFromRaw(DateTimeBase<derivedSyncClass>::getRawTime());
     }
 
     /**
     * @brief Checks if current year is leap year.
     */
-    bool isCurrentYearLeap() const {
+    constexpr bool isCurrentYearLeap() const {
         return dtlib::isLeapYear(dtlib::getYearFromRaw(DateTimeBase<derivedSyncClass>::getRawTime()));
     }
 
@@ -1107,7 +1109,7 @@ public:
     * which has better performance for setting all date and time fields.
     * @param val New value of month to be set. Value can be in range from 1 to 12.
     */
-    void setMonth(Month month) {
+    DT_CONSTEXPR14 void setMonth(Month month) {
         int64_t newRaw = DateTimeBase<derivedSyncClass>::getAndSyncBeforeSet();
         dtlib::setMonthToRaw(newRaw, month);
         DateTimeBase<derivedSyncClass>::setRawTime(newRaw);
@@ -1119,7 +1121,7 @@ public:
     * @note This function has worse performance than setMonth(), try to avoid it.
     * @param months Value to add. This value can be also negative, which means, that it will be subtracted.
     */
-    void addMonths(int32_t months) {
+    DT_CONSTEXPR14 void addMonths(int32_t months) {
         int64_t newRaw = DateTimeBase<derivedSyncClass>::getRawTime(); //No sync here
         dtlib::addMonthsToRaw(newRaw, months);
         DateTimeBase<derivedSyncClass>::setRawTime(newRaw);
@@ -1132,7 +1134,7 @@ public:
     * which has better performance for setting all date and time fields.
     * @return Returns month from raw value. Value can be in range from 1 to 12.
     */
-    Month getMonth() const {
+    constexpr Month getMonth() const {
         return dtlib::getMonthFromRaw(DateTimeBase<derivedSyncClass>::getRawTime());
     }
 
@@ -1144,7 +1146,7 @@ public:
     * @param val New value of day to be set. Value can be in range from 1 to 28/29/30/31. To get maximum value that can be set,
     * use getMonthLength() function.
     */
-    void setDay(uint8_t day) {
+    DT_CONSTEXPR14 void setDay(uint8_t day) {
         int64_t newRaw = DateTimeBase<derivedSyncClass>::getAndSyncBeforeSet();
         dtlib::setMonthDayToRaw(newRaw, day);
         DateTimeBase<derivedSyncClass>::setRawTime(newRaw);
@@ -1154,7 +1156,7 @@ public:
     * @brief Adds days to DateTime.
     * @param days Days to add.
     */
-    void addDays(int32_t days) {
+    DT_CONSTEXPR14 void addDays(int32_t days) {
         int64_t newRaw = DateTimeBase<derivedSyncClass>::getRawTime(); //No sync here
         dtlib::addDaysToRaw(newRaw, days);
         DateTimeBase<derivedSyncClass>::setRawTime(newRaw);
@@ -1167,7 +1169,7 @@ public:
     * which has better performance for setting all date and time fields.
     * @return Returns day in range from 1 to 28/29/30/31.
     */
-    uint8_t getDay() const {
+    constexpr uint8_t getDay() const {
         return dtlib::getMonthDayFromRaw(DateTimeBase<derivedSyncClass>::getRawTime());
     }
 
@@ -1175,7 +1177,7 @@ public:
     * @brief Gets current day of week.
     * @return Returns day of week, which is in range from 1(Sunday) to 7(Saturday). See enum DayOfWeek.
     */
-    DayOfWeek getDayOfWeek() const {
+    constexpr DayOfWeek getDayOfWeek() const {
         return dtlib::getDayOfWeekFromRaw(DateTimeBase<derivedSyncClass>::getRawTime());
     }
 
@@ -1184,7 +1186,7 @@ public:
     * @param firstDayOfWeek First day of week. In some countries week starts with Sunday, some with Monday.
     * @returns Week of the year from 1 to 52.
     */
-    uint8_t getWeekOfYear(DayOfWeek firstDayOfWeek = DayOfWeek::Sunday) const {
+    constexpr uint8_t getWeekOfYear(DayOfWeek firstDayOfWeek = DayOfWeek::Sunday) const {
         return dtlib::getWeekOfYearFromRaw(DateTimeBase<derivedSyncClass>::getRawTime(), firstDayOfWeek);
     }
 
@@ -1206,7 +1208,7 @@ public:
     * @param firstDayOfWeek First day of week. In some countries week starts with Sunday, some with Monday.
     * @returns Week of the month from 1(first) to 6(sixth).
     */
-    uint8_t getWeekOfMonth(DayOfWeek firstDayOfWeek = DayOfWeek::Sunday) const {
+    constexpr uint8_t getWeekOfMonth(DayOfWeek firstDayOfWeek = DayOfWeek::Sunday) const {
         return dtlib::getWeekOfMonthFromRaw(DateTimeBase<derivedSyncClass>::getRawTime(), firstDayOfWeek);
     }
 
@@ -1226,7 +1228,7 @@ public:
     * #endverbatim
     * @returns Week day of the month from 1(first) to 5(fifth).
     */
-    inline WeekOfMonth getWeekDayOfMonth() const {
+    constexpr WeekOfMonth getWeekDayOfMonth() const {
         return (WeekOfMonth)dtlib::getWeekDayOfMonthFromRaw(DateTimeBase<derivedSyncClass>::getRawTime());
     }
 
@@ -1235,7 +1237,7 @@ public:
     * @param dayOfYear Count of days, that elapsed from first day in current year. This value can be in range from 0 to 364 for basic years
     * and in range from 0 to 365 for leap years.
     */
-    void setDayOfYear(uint16_t dayOfYear) {
+    DT_CONSTEXPR14 void setDayOfYear(uint16_t dayOfYear) {
         int64_t newRaw = DateTimeBase<derivedSyncClass>::getAndSyncBeforeSet();
         dtlib::setDayOfYearToRaw(newRaw, dayOfYear);
         DateTimeBase<derivedSyncClass>::setRawTime(newRaw);
@@ -1246,7 +1248,7 @@ public:
     * @return Returns count of days, that elapsed from first day in current year. This value can be in range from 0 to 364 for basic years
     * and in range from 0 to 365 for leap years.
     */
-    uint16_t getDayOfYear() const {
+    constexpr uint16_t getDayOfYear() const {
         return dtlib::getDayOfYearFromRaw(DateTimeBase<derivedSyncClass>::getRawTime());
     }
 
@@ -1255,7 +1257,7 @@ public:
     * @param val Count of days, that elapsed from from year 1 (calendar start). This value can be in range from MIN_DAYS to MAX_DAYS. It
     * can be also negative, which means, that current date is B.C.
     */
-    void setDaysFromEpoch(int32_t days) {
+    DT_CONSTEXPR14 void setDaysFromEpoch(int32_t days) {
         int64_t newRaw = DateTimeBase<derivedSyncClass>::getAndSyncBeforeSet();
         dtlib::setDaysToRaw(newRaw, days);
         DateTimeBase<derivedSyncClass>::setRawTime(newRaw);
@@ -1266,7 +1268,7 @@ public:
     * @return Returns count of days that elapsed from from start of the epoch. Value can be in range from MIN_DAYS to MAX_DAYS. It
     * can be also negative, which means, that current date is B.C.
     */
-    int32_t getDaysFromEpoch() const {
+    constexpr int32_t getDaysFromEpoch() const {
         return dtlib::getDaysFromRaw(DateTimeBase<derivedSyncClass>::getRawTime());
     }
     
@@ -1274,7 +1276,7 @@ public:
     * @brief Sets count of microseconds, that elapsed since start of the current day.
     * @param val Count of microseconds, that elapsed since start of current year. This value can be in range from 0 to (DAY - 1).
     */
-    void setMicrosecondsOfDay(int64_t microsOfDay) {
+    DT_CONSTEXPR14 void setMicrosecondsOfDay(int64_t microsOfDay) {
         int64_t newRaw = DateTimeBase<derivedSyncClass>::getAndSyncBeforeSet();
         dtlib::setMicrosOfDayToRaw(newRaw, microsOfDay);
         DateTimeBase<derivedSyncClass>::setRawTime(newRaw);
@@ -1284,7 +1286,7 @@ public:
     * @brief Gets count of microseconds, that elapsed since start of the current day.
     * @return Returns count of microseconds, that elapsed since start of the current year. This value can be in range from 0 to (DAY - 1).
     */
-    int64_t getMicrosecondsOfDay() const {
+    constexpr int64_t getMicrosecondsOfDay() const {
         return dtlib::getMicrosOfDayFromRaw(DateTimeBase<derivedSyncClass>::getRawTime());
     }
     
@@ -1464,6 +1466,196 @@ public:
         return dtlib::dateTimeToString(format, DateTimeBase<derivedSyncClass>::getRawTime(), tz, dst, monthNames, weekDayNames);
     }
 
+    /**
+    * @brief Converts DateTime to string using precompiled format.
+    * @param buffer Buffer, where string will be written.
+    * @param bufferSize Size of buffer including null terminator. Size format.getMaxLength() + 1 is always enough.
+    * @param format Precompiled date and time format.
+    * @return Returns pointer to buffer, where null terminator was inserted.
+    */
+    char* toArray(char* buffer, size_t bufferSize, const DateTimeFormat& format) const {
+        int16_t tz = 0;
+        int16_t dst = 0;
+        CONSTEXPR_IF (has_getTimeZoneOffsetMinutes<derivedSyncClass>::value) {
+            tz = static_cast<const derivedSyncClass*>(this)->getTimeZoneOffsetMinutes();
+        }
+        CONSTEXPR_IF (has_getCurrentDSTOffsetMinutes<derivedSyncClass>::value) {
+            dst = static_cast<const derivedSyncClass*>(this)->getCurrentDSTOffsetMinutes();
+        }
+        return format.toArray(buffer, bufferSize, DateTimeBase<derivedSyncClass>::getRawTime(), tz, dst);
+    }
+
+    /**
+    * @brief Converts DateTime to string using precompiled format.
+    * @param format Precompiled date and time format.
+    * @return Returns converted string.
+    */
+#ifdef ARDUINO
+    String toString(const DateTimeFormat& format) const {
+#else
+    std::string toString(const DateTimeFormat& format) const {
+#endif // ARDUINO
+        char buffer[DT_FORMAT_MAX_LENGTH + 1];
+        toArray(buffer, sizeof(buffer) / sizeof(char), format);
+        return buffer;
+    }
+
+    /**
+    * @brief Converts DateTime to string with fixed capacity, which is returned by value without heap allocation.
+    * @tparam N Capacity of returned string. Longer result is truncated.
+    * @param format Custom date and time format, see toArray() for format specifiers.
+    * @param monthNames Array with custom month names. This array has to contain exactly 12 strings. If set to NULL, English names are used.
+    * @param weekDayNames Array with custom days of week. This array has to contain exactly 7 strings and first name has to be Sunday, then Monday and so on. If set to NULL, English names are used.
+    * @return Returns converted string.
+    */
+    template<size_t N = DT_STRING_DEFAULT_CAPACITY>
+    DTString<N> toDTString(const char* format = "yyyy-MM-ddTHH:mm:ss.ffffffZZZ", const char* const* monthNames = NULL, const char* const* weekDayNames = NULL) const {
+        DTString<N> ret;
+        ret.setLength(toArray(ret.data(), N + 1, format, monthNames, weekDayNames) - ret.data());
+        return ret;
+    }
+
+    /**
+    * @brief Converts DateTime to string with fixed capacity using precompiled format. String is returned by value without heap allocation.
+    * @tparam N Capacity of returned string. Default capacity is always enough.
+    * @param format Precompiled date and time format.
+    * @return Returns converted string.
+    */
+    template<size_t N = DT_FORMAT_MAX_LENGTH>
+    DTString<N> toDTString(const DateTimeFormat& format) const {
+        DTString<N> ret;
+        ret.setLength(toArray(ret.data(), N + 1, format) - ret.data());
+        return ret;
+    }
+
+    /**
+    * @brief Appends DateTime to the end of string. Result is written to stack buffer at first, so no memory is allocated,
+    * when string has enough capacity. This is useful, when the same string is reused for many values.
+    * @param str String, where DateTime will be appended.
+    * @param format Custom date and time format, see toArray() for format specifiers.
+    * @param monthNames Array with custom month names. This array has to contain exactly 12 strings. If set to NULL, English names are used.
+    * @param weekDayNames Array with custom days of week. This array has to contain exactly 7 strings and first name has to be Sunday, then Monday and so on. If set to NULL, English names are used.
+    */
+#ifdef ARDUINO
+    void appendTo(String& str, const char* format = "yyyy-MM-ddTHH:mm:ss.ffffffZZZ", const char* const* monthNames = NULL, const char* const* weekDayNames = NULL) const {
+#else
+    void appendTo(std::string& str, const char* format = "yyyy-MM-ddTHH:mm:ss.ffffffZZZ", const char* const* monthNames = NULL, const char* const* weekDayNames = NULL) const {
+#endif // ARDUINO
+        char buffer[DT_APPEND_BUFFER_SIZE];
+        char* newBuff = toArray(buffer, sizeof(buffer) / sizeof(char), format, monthNames, weekDayNames);
+        if ((size_t)(newBuff - buffer) < sizeof(buffer) / sizeof(char) - 1) {
+            str += buffer;
+        }
+        else {
+            str += toString(format, monthNames, weekDayNames); //Result could be truncated, so it is converted again without limit
+        }
+    }
+
+    /**
+    * @brief Appends DateTime to the end of string using precompiled format. No memory is allocated, when string has enough capacity.
+    * @param str String, where DateTime will be appended.
+    * @param format Precompiled date and time format.
+    */
+#ifdef ARDUINO
+    void appendTo(String& str, const DateTimeFormat& format) const {
+#else
+    void appendTo(std::string& str, const DateTimeFormat& format) const {
+#endif // ARDUINO
+        char buffer[DT_FORMAT_MAX_LENGTH + 1];
+        toArray(buffer, sizeof(buffer) / sizeof(char), format);
+        str += buffer;
+    }
+
+    /**
+    * @brief Writes DateTime to output iterator, for example std::back_inserter() or pointer to character array.
+    * Result is written to stack buffer at first, so no memory is allocated by this function.
+    * @param out Output iterator, which accepts characters. Null terminator is not written.
+    * @param format Custom date and time format, see toArray() for format specifiers.
+    * @param monthNames Array with custom month names. This array has to contain exactly 12 strings. If set to NULL, English names are used.
+    * @param weekDayNames Array with custom days of week. This array has to contain exactly 7 strings and first name has to be Sunday, then Monday and so on. If set to NULL, English names are used.
+    * @return Returns output iterator after the last written character.
+    */
+    template<class OutputIt>
+    OutputIt formatTo(OutputIt out, const char* format = "yyyy-MM-ddTHH:mm:ss.ffffffZZZ", const char* const* monthNames = NULL, const char* const* weekDayNames = NULL) const {
+        char buffer[DT_APPEND_BUFFER_SIZE];
+        char* newBuff = toArray(buffer, sizeof(buffer) / sizeof(char), format, monthNames, weekDayNames);
+        if ((size_t)(newBuff - buffer) < sizeof(buffer) / sizeof(char) - 1) {
+            for (const char* c = buffer; c < newBuff; c++) {
+                *out++ = *c;
+            }
+        }
+        else {
+            //Result could be truncated, so it is converted again without limit
+            auto str = toString(format, monthNames, weekDayNames);
+            for (size_t i = 0; i < str.length(); i++) {
+                *out++ = str[i];
+            }
+        }
+        return out;
+    }
+
+    /**
+    * @brief Writes DateTime to output iterator using precompiled format.
+    * @param out Output iterator, which accepts characters. Null terminator is not written.
+    * @param format Precompiled date and time format.
+    * @return Returns output iterator after the last written character.
+    */
+    template<class OutputIt>
+    OutputIt formatTo(OutputIt out, const DateTimeFormat& format) const {
+        char buffer[DT_FORMAT_MAX_LENGTH + 1];
+        char* newBuff = toArray(buffer, sizeof(buffer) / sizeof(char), format);
+        for (const char* c = buffer; c < newBuff; c++) {
+            *out++ = *c;
+        }
+        return out;
+    }
+
+#if DT_STATIC_FORMAT != 0
+    /**
+    * @brief Converts DateTime to string using format, which is known at compile time.
+    * Writer of the format is generated by compiler, so format is not scanned at all.
+    * Result is the same as result of toArray() with the same format.
+    *
+    * With C++20 compiler, string literal can be used as format:
+    * @code{.cpp}
+    * dt.format<"yyyy-MM-dd HH:mm:ss">(buffer, sizeof(buffer));
+    * @endcode
+    * Older compilers require static char array:
+    * @code{.cpp}
+    * static constexpr char isoFormat[] = "yyyy-MM-dd HH:mm:ss";
+    * dt.format<isoFormat>(buffer, sizeof(buffer));
+    * @endcode
+    * @tparam Format Custom date and time format, see toArray() for format specifiers.
+    * @param buffer Buffer, where string will be written.
+    * @param bufferSize Size of buffer including null terminator.
+    * @return Returns pointer to buffer, where null terminator was inserted.
+    * @note This function needs C++17 (DT_STATIC_FORMAT is not 0).
+    */
+    template<DT_STATIC_FORMAT_PARAM Format>
+    char* format(char* buffer, size_t bufferSize) const {
+        int16_t tz = 0;
+        int16_t dst = 0;
+        CONSTEXPR_IF (has_getTimeZoneOffsetMinutes<derivedSyncClass>::value) {
+            tz = static_cast<const derivedSyncClass*>(this)->getTimeZoneOffsetMinutes();
+        }
+        CONSTEXPR_IF (has_getCurrentDSTOffsetMinutes<derivedSyncClass>::value) {
+            dst = static_cast<const derivedSyncClass*>(this)->getCurrentDSTOffsetMinutes();
+        }
+        return dtlib::StaticFormat<Format>::toArray(buffer, bufferSize, DateTimeBase<derivedSyncClass>::getRawTime(), tz, dst);
+    }
+
+    /**
+    * @brief Converts DateTime to string using format, which is known at compile time.
+    * @tparam Format Custom date and time format, see toArray() for format specifiers.
+    * @param buffer Buffer, where string will be written.
+    * @return Returns pointer to buffer, where null terminator was inserted.
+    */
+    template<DT_STATIC_FORMAT_PARAM Format, size_t N>
+    char* format(char (&buffer)[N]) const {
+        return format<Format>(buffer, N);
+    }
+#endif // DT_STATIC_FORMAT != 0
+
     /**
     * @brief Converts DateTime to ISO8601 string.
     * @param buffer Buffer, where string will be written.
@@ -1522,6 +1714,49 @@ public:
         }
     }
 
+    /**
+    * @brief Converts DateTime to fixed-width ISO 8601 string, for example 2009-06-15T13:45:30.123456+02:00.
+    * This is the fastest way to write date and time, because format is not scanned and all fields are written
+    * using two-digit lookup table. See dtlib::iso8601ToArray() for details.
+    * @param buffer Buffer, where string will be written.
+    * @param bufferSize Size of buffer including null terminator. Buffer of size ISO8601_MAX_LENGTH + 1 is always large enough.
+    * @param fractionDigits Count of fraction digits from 0 to 6. Fraction is truncated.
+    * @param includeTimeZone True to include time zone offset in string.
+    * @return Returns pointer to buffer, where null terminator was inserted.
+    */
+    char* toISO8601(char* buffer, size_t bufferSize, uint8_t fractionDigits = 6, bool includeTimeZone = true) const {
+        int16_t tz = 0;
+        int16_t dst = 0;
+        CONSTEXPR_IF (has_getTimeZoneOffsetMinutes<derivedSyncClass>::value) {
+            tz = static_cast<const derivedSyncClass*>(this)->getTimeZoneOffsetMinutes();
+        }
+        CONSTEXPR_IF (has_getCurrentDSTOffsetMinutes<derivedSyncClass>::value) {
+            dst = static_cast<const derivedSyncClass*>(this)->getCurrentDSTOffsetMinutes();
+        }
+        return dtlib::iso8601ToArray(buffer, bufferSize, DateTimeBase<derivedSyncClass>::getRawTime(), fractionDigits, tz + dst,
+            includeTimeZone ? dtlib::ISO_OFFSET_NUMERIC : dtlib::ISO_OFFSET_NONE);
+    }
+
+    /**
+    * @brief Converts DateTime to fixed-width RFC 3339 string, for example 2009-06-15T13:45:30.123456Z or 2009-06-15T13:45:30.123456+02:00.
+    * It is the same as toISO8601(), but zero offset is written as 'Z'.
+    * @param buffer Buffer, where string will be written.
+    * @param bufferSize Size of buffer including null terminator. Buffer of size ISO8601_MAX_LENGTH + 1 is always large enough.
+    * @param fractionDigits Count of fraction digits from 0 to 6. Fraction is truncated.
+    * @return Returns pointer to buffer, where null terminator was inserted.
+    */
+    char* toRFC3339(char* buffer, size_t bufferSize, uint8_t fractionDigits = 6) const {
+        int16_t tz = 0;
+        int16_t dst = 0;
+        CONSTEXPR_IF (has_getTimeZoneOffsetMinutes<derivedSyncClass>::value) {
+            tz = static_cast<const derivedSyncClass*>(this)->getTimeZoneOffsetMinutes();
+        }
+        CONSTEXPR_IF (has_getCurrentDSTOffsetMinutes<derivedSyncClass>::value) {
+            dst = static_cast<const derivedSyncClass*>(this)->getCurrentDSTOffsetMinutes();
+        }
+        return dtlib::iso8601ToArray(buffer, bufferSize, DateTimeBase<derivedSyncClass>::getRawTime(), fractionDigits, tz + dst, dtlib::ISO_OFFSET_UTC_Z);
+    }
+
 #if DT_UNDER_OS > 0
     friend auto operator<<(std::ostream& os, derivedSyncClass const& m) -> std::ostream& {
         return os << m.toString();
@@ -1542,6 +1777,19 @@ public:
         return (size_t)(newBuff - buffer);
     }
 
+    /**
+    * @brief Prints DateTime to specified stream using precompiled format.
+    * @param[in] p Stream, where to print.
+    * @param format Precompiled date and time format.
+    * @return Returns count of printed characters.
+    */
+    size_t printTo(Print& p, const DateTimeFormat& format) const {
+        char buffer[DT_FORMAT_MAX_LENGTH + 1];
+        char* newBuff = toArray(buffer, sizeof(buffer) / sizeof(char), format);
+        p.print(buffer);
+        return (size_t)(newBuff - buffer);
+    }
+
     operator dtlib::DTStaticPrintable<derivedSyncClass>() const {
         return dtlib::DTStaticPrintable<derivedSyncClass>(*this);
     }
@@ -1729,30 +1977,96 @@ public:
     }
 
     /**
-   * @brief Parses date and time from ISO8601 string.
-   * @param buffer Buffer, where DateTime is written in text form.
-   * @param bufferSize Size of buffer including null terminator.
-   * @return Returns value greather than 0, when parsing was successful. This value is count of parsed characters from buffer.
-   *         Returns negative or 0, when parsing failed. This value is zero based position of character from buffer, where parsing failed.
-   */
-    /*int parseISO8601(const char* buffer, size_t bufferSize) {
-        TODO accept all ISO8601 formats
+    * @brief Parses date and time from string using precompiled format.
+    * Result is the same as result of parse() with format string, but format is not scanned again.
+    * @param buffer Buffer, where DateTime is written in text form.
+    * @param bufferSize Size of buffer including null terminator.
+    * @param parser Precompiled format, see DateTimeParser.
+    * @return Returns value greather than 0, when parsing was successful. This value is count of parsed characters from buffer.
+    *         Returns negative or 0, when parsing failed. This value is zero based position of character from buffer, where parsing failed.
+    */
+    int parse(const char* buffer, int bufferSize, const DateTimeParser& parser) {
         DateTimeBase<derivedSyncClass>::syncBeforeSet();
 
         date_time_s parsedVal;
         int16_t tzOffset;
         int16_t DSTOffset;
         int16_t tz_DST_Offset;
-        int ret = parseDateTime(buffer, bufferSize, "y-M-dTHH:mm:ss.FFFFFFzzzz", parsedVal, tzOffset, DSTOffset, tz_DST_Offset, true);
+        int ret = parser.parse(buffer, bufferSize, parsedVal, tzOffset, DSTOffset, tz_DST_Offset);
 
-        DateTimeBase<derivedSyncClass>::setRawTime(dateTimeToRaw(parsedVal));
+        DateTimeBase<derivedSyncClass>::setRawTime(dtlib::dateTimeToRaw(parsedVal));
 
         CONSTEXPR_IF (has_setTimeZone<derivedSyncClass>::value) {
-            static_cast<derivedSyncClass*>(this)->setTimeZone(TimeZone::fromTotalMinutesOffset(tzOffset), false);
+            int16_t offset = tz_DST_Offset;
+            if (offset == 0) {
+                offset = tzOffset + DSTOffset;
+            }
+            static_cast<derivedSyncClass*>(this)->setTimeZone(TimeZone::fromTotalMinutesOffset(offset), false);
+        }
+
+        return ret;
+    }
+
+    /**
+    * @brief Parses date and time from string using precompiled format.
+    * @param str String, where DateTime is written in text form.
+    * @param parser Precompiled format, see DateTimeParser.
+    * @return Returns value greather than 0, when parsing was successful. This value is count of parsed characters from buffer.
+    *         Returns negative or 0, when parsing failed. This value is zero based position of character from buffer, where parsing failed.
+    */
+#ifdef ARDUINO
+    int parse(const String& str, const DateTimeParser& parser) {
+#else
+    int parse(const std::string& str, const DateTimeParser& parser) {
+#endif // ARDUINO
+        return parse(str.c_str(), str.length() + 1, parser);
+    }
+
+    /**
+    * @brief Parses date and time from ISO 8601 / RFC 3339 string, for example "2009-06-15T13:45:30.123456+02:00".
+    * Fields are validated and converted using 8-byte words, so it is much faster than parse() with format.
+    * See dtlib::parseISO8601() for accepted layout.
+    * If offset is found and this object has time zone, offset is set as time zone (without DST).
+    * Nothing is changed, when parsing fails.
+    * @param buffer Buffer, where DateTime is written in text form.
+    * @param length Length of text in buffer. Null terminator is not required.
+    * @return Returns value greather than 0, when parsing was successful. This value is count of parsed characters from buffer.
+    *         Returns negative or 0, when parsing failed. This value is zero based position of character from buffer, where parsing failed.
+    */
+    int parseISO8601(const char* buffer, size_t length) {
+        int64_t raw;
+        int16_t offset;
+        bool hasOffset;
+        int ret = dtlib::parseISO8601(buffer, length, raw, offset, hasOffset);
+        if (ret <= 0) {
+            return ret;
+        }
+
+        DateTimeBase<derivedSyncClass>::syncBeforeSet();
+        DateTimeBase<derivedSyncClass>::setRawTime(raw);
+
+        CONSTEXPR_IF (has_setTimeZoneNoRecalc<derivedSyncClass>::value) {
+            if (hasOffset) {
+                static_cast<derivedSyncClass*>(this)->setTimeZone(TimeZone::fromTotalMinutesOffset(offset), false);
+            }
         }
 
         return ret;
-    }*/
+    }
+
+    /**
+    * @brief Parses date and time from ISO 8601 / RFC 3339 string, see parseISO8601() with buffer for details.
+    * @param str String, where DateTime is written in text form.
+    * @return Returns value greather than 0, when parsing was successful. This value is count of parsed characters from buffer.
+    *         Returns negative or 0, when parsing failed. This value is zero based position of character from buffer, where parsing failed.
+    */
+#ifdef ARDUINO
+    int parseISO8601(const String& str) {
+#else
+    int parseISO8601(const std::string& str) {
+#endif // ARDUINO
+        return parseISO8601(str.c_str(), str.length());
+    }
 
     /**
     * @brief Maximum possible value, that can be used with DateTime.
@@ -1790,7 +2104,7 @@ protected:
     * @brief Gets raw time value without synchronization.
     * @return Returns Raw time value in microseconds.
     */
-    inline int64_t getRawValueDer() const {
+    constexpr int64_t getRawValueDer() const {
         return rawValue;
     }
 
@@ -1798,7 +2112,7 @@ protected:
     * @brief Sets raw time without synchronization and without DST offset calculation
     * @param value Raw value to set in microseconds.
     */
-    inline void setRawValueDer(int64_t value) {
+    DT_CONSTEXPR14 void setRawValueDer(int64_t value) {
         rawValue = value;
     }
 
@@ -1806,12 +2120,12 @@ protected:
     * @brief Adds value to raw time without synchronization and without DST offset calculation
     * @param value Raw value to set in microseconds.
     */
-    inline void addRawValueDer(int64_t value) {
+    DT_CONSTEXPR14 void addRawValueDer(int64_t value) {
         rawValue += value;
     }
 
 private:
-    int64_t rawValue;
+    int64_t rawValue = 0;
 };
 
 template <class T> const T DateTimeRawBase<T>::MaxValue(MAX_YEAR, 12, 31, 23, 59, 59, 999, 999);
@@ -1837,7 +2151,7 @@ public:
     /**
     * @brief Default constructor, which set DateTime to the 0001/01/01 00:00:00.000000 with no time zone and DST adjustment.
     */
-    DateTime() : DateTimeRawBase<DateTime>()
+    constexpr DateTime() : DateTimeRawBase<DateTime>()
     { }
 
     /**
@@ -1846,9 +2160,53 @@ public:
     * @param dt Any other DateTimeBase (for example DateTimeTZ, DateTimeSysSync, ...)
     */
     template<class DTclass, typename = typename dtlib::enable_if<has_getRaw<DTclass>::value>::type>
-    explicit DateTime(const DTclass& dt) {
+    explicit DT_CONSTEXPR14 DateTime(const DTclass& dt) {
         DateTimeBase<DateTime>::setRawTime(dt.getRaw());
     }
 };
 
+#if !defined(DT_LEGACY_CALENDAR) && DT_CPP_VERSION >= 201703L
+//Constants of DateTime are computed at compile time, so they can be also used in constant expressions (inline variables need C++17)
+template<> inline constexpr DateTime DateTimeRawBase<DateTime>::MaxValue(MAX_YEAR, 12, 31, 23, 59, 59, 999, 999);
+template<> inline constexpr DateTime DateTimeRawBase<DateTime>::Zero(0LL);
+template<> inline constexpr DateTime DateTimeRawBase<DateTime>::MinValue(MIN_YEAR, 0, 0, 0, 0, 0, 0, 0);
+template<> inline constexpr DateTime DateTimeRawBase<DateTime>::UnixBase(62135596800000000LL);
+template<> inline constexpr DateTime DateTimeRawBase<DateTime>::OABase(1899, 12, 30);
+#endif // !defined(DT_LEGACY_CALENDAR) && DT_CPP_VERSION >= 201703L
+
+namespace dtlib {
+
+    /**
+    * @brief Called by _dt literal, when literal is malformed. This function is not constexpr, so malformed literal fails to compile.
+    */
+    inline int64_t malformedDateTimeLiteral() {
+        return 0;
+    }
+
+    inline namespace literals {
+
+        /**
+        * @brief User defined literal, which converts date and time in ISO 8601 format to DateTime at compile time, for example:
+        * @code
+        * using namespace dtlib::literals;
+        * constexpr DateTime release = "2024-03-01T12:00:00Z"_dt;
+        * @endcode
+        * Accepted formats are described in parseDateTimeLiteral(). If time zone offset is present, value is converted to UTC.
+        * Malformed literal or invalid date (for example "2023-02-29") fails to compile.
+        * @note When DT_LEGACY_CALENDAR is defined, literal is converted at runtime and malformed literal is converted to 0001-01-01.
+        */
+#ifndef DT_LEGACY_CALENDAR
+        DT_CONSTEVAL DateTime operator""_dt(const char* str, size_t len) {
+#else
+        inline DateTime operator""_dt(const char* str, size_t len) {
+#endif // !DT_LEGACY_CALENDAR
+            int64_t raw = 0;
+            if (!parseDateTimeLiteral(str, len, raw)) {
+                raw = malformedDateTimeLiteral();
+            }
+            return DateTime(raw);
+        }
+    }
+}
+
 #endif // !_DATE_TIME_BASE_H
@@ -0,0 +1,987 @@
+#include "DateTimeBatch.h"
+
+#ifndef ARDUINO
+#include <cstring>
+#endif // !ARDUINO
+
+#if DT_BATCH_THREADS != 0
+#include <thread>
+#endif // DT_BATCH_THREADS != 0
+
+#if DT_BATCH_X86_SIMD != 0
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#define DT_TARGET_SSE41
+#define DT_TARGET_AVX2
+#else
+#define DT_TARGET_SSE41 __attribute__((target("sse4.1")))
+#define DT_TARGET_AVX2 __attribute__((target("avx2")))
+#endif // _MSC_VER
+#endif // DT_BATCH_X86_SIMD != 0
+
+#define BATCH_CHUNK	(64) //Count of values converted by SIMD kernel at once (has to be multiple of 8)
+
+//Magic numbers for division by constant using multiplication (valid for whole range of used values):
+//x / d == (mulhi(x, magic) >> shift)
+#define MAGIC_146097	(0x396B06BDUL)	//shift 15, x < 2^30
+#define MAGIC_11758980	(0x5B4FFFCBUL)	//shift 22, any 32-bit x
+#define MAGIC_2141		(0x001E9C29UL)	//shift 0, x < 2^16
+#define MAGIC_7			(0x24924925UL)	//shift 0, x < 2^28
+#define MAGIC_3600		(0x00123457UL)	//shift 0, x < 86400
+#define MAGIC_60		(0x04444445UL)	//shift 0, x < 3600
+#define MAGIC_100		(0x51EB851FUL)	//shift 5, any 32-bit x
+
+namespace dtlib {
+
+	/**
+	* @brief Splits raw value to days, seconds of day and microseconds of second.
+	*/
+	static inline void splitRaw(int64_t raw, int32_t& days, uint32_t& secOfDay, uint32_t& micros) {
+		int64_t rem = raw % DAY;
+		int32_t neg = rem < 0;
+		days = (int32_t)(raw / DAY) - neg;
+		rem += neg * DAY;
+		secOfDay = (uint32_t)(rem / SECOND);
+		micros = (uint32_t)(rem % SECOND);
+	}
+
+	static void rawToDateTimeScalar(const int64_t* raw, size_t from, size_t count, const date_time_columns_s& columns) {
+		for (size_t i = from; i < count; i++) {
+			int32_t days;
+			uint32_t secOfDay;
+			uint32_t micros;
+			splitRaw(raw[i], days, secOfDay, micros);
+
+			date_s date = getDateFromDays(days);
+			if (columns.year != NULL) columns.year[i] = date.year;
+			if (columns.month != NULL) columns.month[i] = date.month;
+			if (columns.day != NULL) columns.day[i] = date.day;
+			if (columns.dayOfWeek != NULL) columns.dayOfWeek[i] = date.dayOfWeek;
+			if (columns.hour != NULL) columns.hour[i] = (uint8_t)(secOfDay / 3600);
+			if (columns.minute != NULL) columns.minute[i] = (uint8_t)((secOfDay % 3600) / 60);
+			if (columns.second != NULL) columns.second[i] = (uint8_t)(secOfDay % 60);
+			if (columns.microsecond != NULL) columns.microsecond[i] = micros;
+		}
+	}
+
+	static inline int32_t getDaysFromColumns(const const_date_time_columns_s& columns, size_t i) {
+		int32_t year = columns.year[i];
+		int32_t days = (columns.day[i] - 1);
+		days += getDayOfYearFromMonth(columns.month[i], isLeapYear(year));
+		days += getDaysUntilYear(year);
+		return days;
+	}
+
+	static inline uint32_t getSecOfDayFromColumns(const const_date_time_columns_s& columns, size_t i) {
+		uint32_t secOfDay = 0;
+		if (columns.hour != NULL) secOfDay += columns.hour[i] * 3600;
+		if (columns.minute != NULL) secOfDay += columns.minute[i] * 60;
+		if (columns.second != NULL) secOfDay += columns.second[i];
+		return secOfDay;
+	}
+
+	static inline int64_t joinRaw(int32_t days, uint32_t secOfDay, const const_date_time_columns_s& columns, size_t i) {
+		int64_t raw = days * DAY + (int64_t)secOfDay * SECOND;
+		if (columns.microsecond != NULL) raw += columns.microsecond[i];
+		return raw;
+	}
+
+	static void dateTimeToRawScalar(const const_date_time_columns_s& columns, size_t from, size_t count, int64_t* raw) {
+		for (size_t i = from; i < count; i++) {
+			raw[i] = joinRaw(getDaysFromColumns(columns, i), getSecOfDayFromColumns(columns, i), columns, i);
+		}
+	}
+
+#if DT_BATCH_X86_SIMD != 0
+	/*
+	* SIMD kernels use the same calculation as getDateFromDays(), getDaysUntilYear(), getDayOfYearFromMonth() and
+	* isLeapYear(), but all divisions are replaced by multiplication (high 32 bits of 32x32 bit product) and shift.
+	* 64-bit division of raw value is done by scalar code, because there is no 64-bit division or multiplication
+	* in AVX2 and SSE4.1. All values are calculated using 32-bit lanes.
+	*/
+
+	DT_TARGET_AVX2 static inline __m256i mulhi_avx2(__m256i a, uint32_t magic) {
+		__m256i m = _mm256_set1_epi32((int32_t)magic);
+		__m256i even = _mm256_srli_epi64(_mm256_mul_epu32(a, m), 32);
+		__m256i odd = _mm256_mul_epu32(_mm256_srli_epi64(a, 32), m);
+		return _mm256_blend_epi32(even, odd, 0xAA);
+	}
+
+	DT_TARGET_AVX2 static inline __m256i loadBytes_avx2(const uint8_t* src) {
+		return _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)src));
+	}
+
+	DT_TARGET_AVX2 static inline void storeBytes_avx2(uint8_t* dst, __m256i v) {
+		//Lowest byte of each 32-bit lane is moved to lowest 4 bytes of each 128-bit lane and then both lanes are joined
+		const __m256i shuffle = _mm256_setr_epi8(0, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+			0, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+		v = _mm256_shuffle_epi8(v, shuffle);
+		v = _mm256_permutevar8x32_epi32(v, _mm256_setr_epi32(0, 4, 0, 0, 0, 0, 0, 0));
+		_mm_storel_epi64((__m128i*)dst, _mm256_castsi256_si128(v));
+	}
+
+	DT_TARGET_AVX2 static void rawToDateTimeKernel_avx2(const int32_t* days, const uint32_t* secOfDay, size_t count,
+		const date_time_columns_s& columns, size_t offset) {
+
+		bool needDate = columns.year != NULL || columns.month != NULL || columns.day != NULL;
+		bool needTime = columns.hour != NULL || columns.minute != NULL || columns.second != NULL;
+
+		for (size_t i = 0; i < count; i += 8) {
+			size_t o = offset + i;
+			//Days elapsed from the 1st of March of shifted year 0
+			__m256i n = _mm256_add_epi32(_mm256_loadu_si256((const __m256i*)(days + i)),
+				_mm256_set1_epi32((int32_t)(DT_CAL_MARCH_OFFSET + DT_CAL_SHIFT_DAYS)));
+
+			if (needDate) {
+				__m256i n1 = _mm256_add_epi32(_mm256_slli_epi32(n, 2), _mm256_set1_epi32(3));
+				__m256i centuries = _mm256_srli_epi32(mulhi_avx2(n1, MAGIC_146097), 15);
+				__m256i n2 = _mm256_or_si256(_mm256_sub_epi32(n1, _mm256_mullo_epi32(centuries, _mm256_set1_epi32(146097))), _mm256_set1_epi32(3));
+
+				//64-bit product n2 * 2939745, high part is year of century, low part is used to get day of year
+				__m256i m = _mm256_set1_epi32(2939745);
+				__m256i pEven = _mm256_mul_epu32(n2, m);
+				__m256i pOdd = _mm256_mul_epu32(_mm256_srli_epi64(n2, 32), m);
+				__m256i yearOfCentury = _mm256_blend_epi32(_mm256_srli_epi64(pEven, 32), pOdd, 0xAA);
+				__m256i pLow = _mm256_blend_epi32(pEven, _mm256_slli_epi64(pOdd, 32), 0xAA);
+				__m256i dayOfMarchYear = _mm256_srli_epi32(mulhi_avx2(pLow, MAGIC_11758980), 22);
+				__m256i janFeb = _mm256_cmpgt_epi32(dayOfMarchYear, _mm256_set1_epi32(305)); //-1 for January and February
+
+				if (columns.year != NULL) {
+					__m256i year = _mm256_add_epi32(_mm256_mullo_epi32(centuries, _mm256_set1_epi32(100)), yearOfCentury);
+					year = _mm256_sub_epi32(year, _mm256_add_epi32(janFeb, _mm256_set1_epi32((int32_t)DT_CAL_SHIFT_YEARS)));
+					year = _mm256_add_epi32(year, _mm256_cmpgt_epi32(_mm256_set1_epi32(1), year)); //Skip year 0
+					_mm256_storeu_si256((__m256i*)(columns.year + o), year);
+				}
+
+				__m256i n3 = _mm256_add_epi32(_mm256_mullo_epi32(dayOfMarchYear, _mm256_set1_epi32(2141)), _mm256_set1_epi32(197913));
+				if (columns.month != NULL) {
+					__m256i month = _mm256_add_epi32(_mm256_srli_epi32(n3, 16), _mm256_and_si256(janFeb, _mm256_set1_epi32(-12)));
+					storeBytes_avx2(columns.month + o, month);
+				}
+				if (columns.day != NULL) {
+					__m256i day = mulhi_avx2(_mm256_and_si256(n3, _mm256_set1_epi32(0xFFFF)), MAGIC_2141);
+					storeBytes_avx2(columns.day + o, _mm256_add_epi32(day, _mm256_set1_epi32(1)));
+				}
+			}
+
+			if (columns.dayOfWeek != NULL) {
+				__m256i x = _mm256_sub_epi32(n, _mm256_set1_epi32(DT_CAL_MARCH_OFFSET - 1));
+				__m256i weeks = mulhi_avx2(x, MAGIC_7);
+				__m256i dow = _mm256_sub_epi32(x, _mm256_mullo_epi32(weeks, _mm256_set1_epi32(7)));
+				storeBytes_avx2(columns.dayOfWeek + o, _mm256_add_epi32(dow, _mm256_set1_epi32(1)));
+			}
+
+			if (needTime) {
+				__m256i sod = _mm256_loadu_si256((const __m256i*)(secOfDay + i));
+				__m256i hour = mulhi_avx2(sod, MAGIC_3600);
+				__m256i rem = _mm256_sub_epi32(sod, _mm256_mullo_epi32(hour, _mm256_set1_epi32(3600)));
+				__m256i minute = mulhi_avx2(rem, MAGIC_60);
+				if (columns.hour != NULL) storeBytes_avx2(columns.hour + o, hour);
+				if (columns.minute != NULL) storeBytes_avx2(columns.minute + o, minute);
+				if (columns.second != NULL) storeBytes_avx2(columns.second + o, _mm256_sub_epi32(rem, _mm256_mullo_epi32(minute, _mm256_set1_epi32(60))));
+			}
+		}
+	}
+
+	DT_TARGET_AVX2 static void dateTimeToRawKernel_avx2(const const_date_time_columns_s& columns, size_t offset, size_t count,
+		int32_t* days, uint32_t* secOfDay) {
+
+		for (size_t i = 0; i < count; i += 8) {
+			size_t o = offset + i;
+			__m256i one = _mm256_set1_epi32(1);
+			__m256i year = _mm256_loadu_si256((const __m256i*)(columns.year + o));
+			__m256i yearA = _mm256_sub_epi32(year, _mm256_cmpgt_epi32(_mm256_setzero_si256(), year)); //Skip year 0
+
+			//Days until year
+			__m256i y = _mm256_add_epi32(yearA, _mm256_set1_epi32((int32_t)DT_CAL_SHIFT_YEARS - 1));
+			__m256i centuries = _mm256_srli_epi32(mulhi_avx2(y, MAGIC_100), 5);
+			__m256i daysUntilYear = _mm256_add_epi32(_mm256_mullo_epi32(y, _mm256_set1_epi32(365)), _mm256_srli_epi32(y, 2));
+			daysUntilYear = _mm256_sub_epi32(daysUntilYear, centuries);
+			daysUntilYear = _mm256_add_epi32(daysUntilYear, _mm256_srli_epi32(centuries, 2));
+			daysUntilYear = _mm256_sub_epi32(daysUntilYear, _mm256_set1_epi32((int32_t)DT_CAL_SHIFT_DAYS));
+
+			//Leap year
+			__m256i yearAbs = _mm256_abs_epi32(yearA);
+			__m256i rem100 = _mm256_sub_epi32(yearAbs, _mm256_mullo_epi32(_mm256_srli_epi32(mulhi_avx2(yearAbs, MAGIC_100), 5), _mm256_set1_epi32(100)));
+			__m256i leapMask = _mm256_or_si256(_mm256_set1_epi32(3), _mm256_and_si256(_mm256_cmpeq_epi32(rem100, _mm256_setzero_si256()), _mm256_set1_epi32(12)));
+			__m256i leap = _mm256_and_si256(_mm256_cmpeq_epi32(_mm256_and_si256(yearAbs, leapMask), _mm256_setzero_si256()), one);
+
+			//Day of year of month
+			__m256i month = _mm256_add_epi32(_mm256_min_epu32(_mm256_sub_epi32(loadBytes_avx2(columns.month + o), one), _mm256_set1_epi32(11)), one);
+			__m256i janFeb = _mm256_cmpgt_epi32(_mm256_set1_epi32(3), month);
+			__m256i dayOfMarchYear = _mm256_add_epi32(month, _mm256_and_si256(janFeb, _mm256_set1_epi32(12)));
+			dayOfMarchYear = _mm256_srli_epi32(_mm256_sub_epi32(_mm256_mullo_epi32(dayOfMarchYear, _mm256_set1_epi32(979)), _mm256_set1_epi32(2918)), 5);
+			__m256i dayOfYear = _mm256_add_epi32(dayOfMarchYear, _mm256_add_epi32(leap, _mm256_set1_epi32(59)));
+			dayOfYear = _mm256_sub_epi32(dayOfYear, _mm256_and_si256(janFeb, _mm256_add_epi32(leap, _mm256_set1_epi32(365))));
+
+			__m256i d = _mm256_add_epi32(daysUntilYear, _mm256_add_epi32(dayOfYear, _mm256_sub_epi32(loadBytes_avx2(columns.day + o), one)));
+			_mm256_storeu_si256((__m256i*)(days + i), d);
+
+			__m256i sod = _mm256_setzero_si256();
+			if (columns.hour != NULL) sod = _mm256_mullo_epi32(loadBytes_avx2(columns.hour + o), _mm256_set1_epi32(3600));
+			if (columns.minute != NULL) sod = _mm256_add_epi32(sod, _mm256_mullo_epi32(loadBytes_avx2(columns.minute + o), _mm256_set1_epi32(60)));
+			if (columns.second != NULL) sod = _mm256_add_epi32(sod, loadBytes_avx2(columns.second + o));
+			_mm256_storeu_si256((__m256i*)(secOfDay + i), sod);
+		}
+	}
+
+	DT_TARGET_SSE41 static inline __m128i mulhi_sse41(__m128i a, uint32_t magic) {
+		__m128i m = _mm_set1_epi32((int32_t)magic);
+		__m128i even = _mm_srli_epi64(_mm_mul_epu32(a, m), 32);
+		__m128i odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), m);
+		return _mm_blend_epi16(even, odd, 0xCC);
+	}
+
+	DT_TARGET_SSE41 static inline __m128i loadBytes_sse41(const uint8_t* src) {
+		int32_t tmp;
+		memcpy(&tmp, src, sizeof(tmp));
+		return _mm_cvtepu8_epi32(_mm_cvtsi32_si128(tmp));
+	}
+
+	DT_TARGET_SSE41 static inline void storeBytes_sse41(uint8_t* dst, __m128i v) {
+		int32_t tmp = _mm_cvtsi128_si32(_mm_shuffle_epi8(v, _mm_setr_epi8(0, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1)));
+		memcpy(dst, &tmp, sizeof(tmp));
+	}
+
+	DT_TARGET_SSE41 static void rawToDateTimeKernel_sse41(const int32_t* days, const uint32_t* secOfDay, size_t count,
+		const date_time_columns_s& columns, size_t offset) {
+
+		bool needDate = columns.year != NULL || columns.month != NULL || columns.day != NULL;
+		bool needTime = columns.hour != NULL || columns.minute != NULL || columns.second != NULL;
+
+		for (size_t i = 0; i < count; i += 4) {
+			size_t o = offset + i;
+			//Days elapsed from the 1st of March of shifted year 0
+			__m128i n = _mm_add_epi32(_mm_loadu_si128((const __m128i*)(days + i)),
+				_mm_set1_epi32((int32_t)(DT_CAL_MARCH_OFFSET + DT_CAL_SHIFT_DAYS)));
+
+			if (needDate) {
+				__m128i n1 = _mm_add_epi32(_mm_slli_epi32(n, 2), _mm_set1_epi32(3));
+				__m128i centuries = _mm_srli_epi32(mulhi_sse41(n1, MAGIC_146097), 15);
+				__m128i n2 = _mm_or_si128(_mm_sub_epi32(n1, _mm_mullo_epi32(centuries, _mm_set1_epi32(146097))), _mm_set1_epi32(3));
+
+				//64-bit product n2 * 2939745, high part is year of century, low part is used to get day of year
+				__m128i m = _mm_set1_epi32(2939745);
+				__m128i pEven = _mm_mul_epu32(n2, m);
+				__m128i pOdd = _mm_mul_epu32(_mm_srli_epi64(n2, 32), m);
+				__m128i yearOfCentury = _mm_blend_epi16(_mm_srli_epi64(pEven, 32), pOdd, 0xCC);
+				__m128i pLow = _mm_blend_epi16(pEven, _mm_slli_epi64(pOdd, 32), 0xCC);
+				__m128i dayOfMarchYear = _mm_srli_epi32(mulhi_sse41(pLow, MAGIC_11758980), 22);
+				__m128i janFeb = _mm_cmpgt_epi32(dayOfMarchYear, _mm_set1_epi32(305)); //-1 for January and February
+
+				if (columns.year != NULL) {
+					__m128i year = _mm_add_epi32(_mm_mullo_epi32(centuries, _mm_set1_epi32(100)), yearOfCentury);
+					year = _mm_sub_epi32(year, _mm_add_epi32(janFeb, _mm_set1_epi32((int32_t)DT_CAL_SHIFT_YEARS)));
+					year = _mm_add_epi32(year, _mm_cmpgt_epi32(_mm_set1_epi32(1), year)); //Skip year 0
+					_mm_storeu_si128((__m128i*)(columns.year + o), year);
+				}
+
+				__m128i n3 = _mm_add_epi32(_mm_mullo_epi32(dayOfMarchYear, _mm_set1_epi32(2141)), _mm_set1_epi32(197913));
+				if (columns.month != NULL) {
+					__m128i month = _mm_add_epi32(_mm_srli_epi32(n3, 16), _mm_and_si128(janFeb, _mm_set1_epi32(-12)));
+					storeBytes_sse41(columns.month + o, month);
+				}
+				if (columns.day != NULL) {
+					__m128i day = mulhi_sse41(_mm_and_si128(n3, _mm_set1_epi32(0xFFFF)), MAGIC_2141);
+					storeBytes_sse41(columns.day + o, _mm_add_epi32(day, _mm_set1_epi32(1)));
+				}
+			}
+
+			if (columns.dayOfWeek != NULL) {
+				__m128i x = _mm_sub_epi32(n, _mm_set1_epi32(DT_CAL_MARCH_OFFSET - 1));
+				__m128i weeks = mulhi_sse41(x, MAGIC_7);
+				__m128i dow = _mm_sub_epi32(x, _mm_mullo_epi32(weeks, _mm_set1_epi32(7)));
+				storeBytes_sse41(columns.dayOfWeek + o, _mm_add_epi32(dow, _mm_set1_epi32(1)));
+			}
+
+			if (needTime) {
+				__m128i sod = _mm_loadu_si128((const __m128i*)(secOfDay + i));
+				__m128i hour = mulhi_sse41(sod, MAGIC_3600);
+				__m128i rem = _mm_sub_epi32(sod, _mm_mullo_epi32(hour, _mm_set1_epi32(3600)));
+				__m128i minute = mulhi_sse41(rem, MAGIC_60);
+				if (columns.hour != NULL) storeBytes_sse41(columns.hour + o, hour);
+				if (columns.minute != NULL) storeBytes_sse41(columns.minute + o, minute);
+				if (columns.second != NULL) storeBytes_sse41(columns.second + o, _mm_sub_epi32(rem, _mm_mullo_epi32(minute, _mm_set1_epi32(60))));
+			}
+		}
+	}
+
+	DT_TARGET_SSE41 static void dateTimeToRawKernel_sse41(const const_date_time_columns_s& columns, size_t offset, size_t count,
+		int32_t* days, uint32_t* secOfDay) {
+
+		for (size_t i = 0; i < count; i += 4) {
+			size_t o = offset + i;
+			__m128i one = _mm_set1_epi32(1);
+			__m128i year = _mm_loadu_si128((const __m128i*)(columns.year + o));
+			__m128i yearA = _mm_sub_epi32(year, _mm_cmpgt_epi32(_mm_setzero_si128(), year)); //Skip year 0
+
+			//Days until year
+			__m128i y = _mm_add_epi32(yearA, _mm_set1_epi32((int32_t)DT_CAL_SHIFT_YEARS - 1));
+			__m128i centuries = _mm_srli_epi32(mulhi_sse41(y, MAGIC_100), 5);
+			__m128i daysUntilYear = _mm_add_epi32(_mm_mullo_epi32(y, _mm_set1_epi32(365)), _mm_srli_epi32(y, 2));
+			daysUntilYear = _mm_sub_epi32(daysUntilYear, centuries);
+			daysUntilYear = _mm_add_epi32(daysUntilYear, _mm_srli_epi32(centuries, 2));
+			daysUntilYear = _mm_sub_epi32(daysUntilYear, _mm_set1_epi32((int32_t)DT_CAL_SHIFT_DAYS));
+
+			//Leap year
+			__m128i yearAbs = _mm_abs_epi32(yearA);
+			__m128i rem100 = _mm_sub_epi32(yearAbs, _mm_mullo_epi32(_mm_srli_epi32(mulhi_sse41(yearAbs, MAGIC_100), 5), _mm_set1_epi32(100)));
+			__m128i leapMask = _mm_or_si128(_mm_set1_epi32(3), _mm_and_si128(_mm_cmpeq_epi32(rem100, _mm_setzero_si128()), _mm_set1_epi32(12)));
+			__m128i leap = _mm_and_si128(_mm_cmpeq_epi32(_mm_and_si128(yearAbs, leapMask), _mm_setzero_si128()), one);
+
+			//Day of year of month
+			__m128i month = _mm_add_epi32(_mm_min_epu32(_mm_sub_epi32(loadBytes_sse41(columns.month + o), one), _mm_set1_epi32(11)), one);
+			__m128i janFeb = _mm_cmpgt_epi32(_mm_set1_epi32(3), month);
+			__m128i dayOfMarchYear = _mm_add_epi32(month, _mm_and_si128(janFeb, _mm_set1_epi32(12)));
+			dayOfMarchYear = _mm_srli_epi32(_mm_sub_epi32(_mm_mullo_epi32(dayOfMarchYear, _mm_set1_epi32(979)), _mm_set1_epi32(2918)), 5);
+			__m128i dayOfYear = _mm_add_epi32(dayOfMarchYear, _mm_add_epi32(leap, _mm_set1_epi32(59)));
+			dayOfYear = _mm_sub_epi32(dayOfYear, _mm_and_si128(janFeb, _mm_add_epi32(leap, _mm_set1_epi32(365))));
+
+			__m128i d = _mm_add_epi32(daysUntilYear, _mm_add_epi32(dayOfYear, _mm_sub_epi32(loadBytes_sse41(columns.day + o), one)));
+			_mm_storeu_si128((__m128i*)(days + i), d);
+
+			__m128i sod = _mm_setzero_si128();
+			if (columns.hour != NULL) sod = _mm_mullo_epi32(loadBytes_sse41(columns.hour + o), _mm_set1_epi32(3600));
+			if (columns.minute != NULL) sod = _mm_add_epi32(sod, _mm_mullo_epi32(loadBytes_sse41(columns.minute + o), _mm_set1_epi32(60)));
+			if (columns.second != NULL) sod = _mm_add_epi32(sod, loadBytes_sse41(columns.second + o));
+			_mm_storeu_si128((__m128i*)(secOfDay + i), sod);
+		}
+	}
+
+	/**
+	* @brief Gets index of the lowest set bit of non zero mask.
+	*/
+	static inline uint32_t firstSetBit(uint32_t mask) {
+#ifdef _MSC_VER
+		unsigned long index;
+		_BitScanForward(&index, mask);
+		return (uint32_t)index;
+#else
+		return (uint32_t)__builtin_ctz(mask);
+#endif // _MSC_VER
+	}
+
+	DT_TARGET_AVX2 static const char* findNewline_avx2(const char* p, const char* end) {
+		const __m256i nl = _mm256_set1_epi8('\n');
+		for (; end - p >= 32; p += 32) {
+			uint32_t mask = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)p), nl));
+			if (mask != 0) return p + firstSetBit(mask);
+		}
+		while (p < end && *p != '\n') p++;
+		return p;
+	}
+
+	DT_TARGET_SSE41 static const char* findNewline_sse41(const char* p, const char* end) {
+		const __m128i nl = _mm_set1_epi8('\n');
+		for (; end - p >= 16; p += 16) {
+			uint32_t mask = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)p), nl));
+			if (mask != 0) return p + firstSetBit(mask);
+		}
+		while (p < end && *p != '\n') p++;
+		return p;
+	}
+
+	DT_TARGET_AVX2 static size_t countNewlines_avx2(const char* p, const char* end) {
+		const __m256i nl = _mm256_set1_epi8('\n');
+		size_t count = 0;
+		while (end - p >= 32) {
+			//Matches are counted in 8-bit counters, which are summed before they can overflow
+			__m256i acc = _mm256_setzero_si256();
+			for (int i = 0; i < 255 && end - p >= 32; i++, p += 32) {
+				acc = _mm256_sub_epi8(acc, _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)p), nl));
+			}
+			__m256i sum = _mm256_sad_epu8(acc, _mm256_setzero_si256());
+			count += (size_t)_mm256_extract_epi32(sum, 0) + (size_t)_mm256_extract_epi32(sum, 2) + (size_t)_mm256_extract_epi32(sum, 4) + (size_t)_mm256_extract_epi32(sum, 6);
+		}
+		for (; p < end; p++) count += *p == '\n';
+		return count;
+	}
+
+	DT_TARGET_SSE41 static size_t countNewlines_sse41(const char* p, const char* end) {
+		const __m128i nl = _mm_set1_epi8('\n');
+		size_t count = 0;
+		while (end - p >= 16) {
+			//Matches are counted in 8-bit counters, which are summed before they can overflow
+			__m128i acc = _mm_setzero_si128();
+			for (int i = 0; i < 255 && end - p >= 16; i++, p += 16) {
+				acc = _mm_sub_epi8(acc, _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)p), nl));
+			}
+			__m128i sum = _mm_sad_epu8(acc, _mm_setzero_si128());
+			count += (size_t)_mm_extract_epi32(sum, 0) + (size_t)_mm_extract_epi32(sum, 2);
+		}
+		for (; p < end; p++) count += *p == '\n';
+		return count;
+	}
+
+	DT_TARGET_AVX2 static size_t findRunEnd_avx2(const int64_t* values, size_t count, int64_t from, int64_t until) {
+		const __m256i f = _mm256_set1_epi64x(from);
+		const __m256i u = _mm256_set1_epi64x(until);
+		size_t i = 0;
+		for (; i + 4 <= count; i += 4) {
+			__m256i v = _mm256_loadu_si256((const __m256i*)(values + i));
+			//Lane is out of run, when from > v or v >= until
+			__m256i out = _mm256_or_si256(_mm256_cmpgt_epi64(f, v), _mm256_andnot_si256(_mm256_cmpgt_epi64(u, v), _mm256_set1_epi64x(-1)));
+			uint32_t mask = (uint32_t)_mm256_movemask_pd(_mm256_castsi256_pd(out));
+			if (mask != 0) return i + firstSetBit(mask);
+		}
+		while (i < count && values[i] >= from && values[i] < until) i++;
+		return i;
+	}
+
+	DT_TARGET_AVX2 static void addOffset_avx2(const int64_t* src, int64_t* dst, size_t count, int64_t offset) {
+		const __m256i o = _mm256_set1_epi64x(offset);
+		size_t i = 0;
+		for (; i + 4 <= count; i += 4) {
+			_mm256_storeu_si256((__m256i*)(dst + i), _mm256_add_epi64(_mm256_loadu_si256((const __m256i*)(src + i)), o));
+		}
+		for (; i < count; i++) dst[i] = src[i] + offset;
+	}
+
+	DT_TARGET_SSE41 static void addOffset_sse41(const int64_t* src, int64_t* dst, size_t count, int64_t offset) {
+		const __m128i o = _mm_set1_epi64x(offset);
+		size_t i = 0;
+		for (; i + 2 <= count; i += 2) {
+			_mm_storeu_si128((__m128i*)(dst + i), _mm_add_epi64(_mm_loadu_si128((const __m128i*)(src + i)), o));
+		}
+		for (; i < count; i++) dst[i] = src[i] + offset;
+	}
+
+	typedef void (*rawToDateTimeKernel_t)(const int32_t*, const uint32_t*, size_t, const date_time_columns_s&, size_t);
+	typedef void (*dateTimeToRawKernel_t)(const const_date_time_columns_s&, size_t, size_t, int32_t*, uint32_t*);
+
+	static BatchSIMD getSupportedBatchSIMD() {
+		static BatchSIMD supported = []() {
+#ifdef _MSC_VER
+			int info[4];
+			__cpuid(info, 0);
+			int maxLeaf = info[0];
+			__cpuid(info, 1);
+			bool sse41 = (info[2] & (1 << 19)) != 0;
+			bool osAVX = (info[2] & (1 << 27)) != 0 && (info[2] & (1 << 28)) != 0 && (_xgetbv(0) & 6) == 6; //OSXSAVE, AVX and YMM state enabled
+			bool avx2 = false;
+			if (maxLeaf >= 7 && osAVX) {
+				__cpuidex(info, 7, 0);
+				avx2 = (info[1] & (1 << 5)) != 0;
+			}
+#else
+			__builtin_cpu_init();
+			bool sse41 = __builtin_cpu_supports("sse4.1");
+			bool avx2 = __builtin_cpu_supports("avx2");
+#endif // _MSC_VER
+			if (avx2) return BATCH_AVX2;
+			else if (sse41) return BATCH_SSE41;
+			else return BATCH_SCALAR;
+		}();
+		return supported;
+	}
+#else
+	static BatchSIMD getSupportedBatchSIMD() {
+		return BATCH_SCALAR;
+	}
+#endif // DT_BATCH_X86_SIMD != 0
+
+	static BatchSIMD& activeBatchSIMD() {
+		static BatchSIMD active = getSupportedBatchSIMD();
+		return active;
+	}
+
+	BatchSIMD getBatchSIMD() {
+		return activeBatchSIMD();
+	}
+
+	BatchSIMD setBatchSIMD(BatchSIMD simd) {
+		BatchSIMD supported = getSupportedBatchSIMD();
+		if (simd > supported) simd = supported;
+		activeBatchSIMD() = simd;
+		return simd;
+	}
+
+	void rawToDateTimeBatch(const int64_t* raw, size_t count, const date_time_columns_s& columns) {
+		size_t i = 0;
+#if DT_BATCH_X86_SIMD != 0
+		BatchSIMD simd = activeBatchSIMD();
+		if (simd != BATCH_SCALAR) {
+			rawToDateTimeKernel_t kernel = (simd == BATCH_AVX2) ? rawToDateTimeKernel_avx2 : rawToDateTimeKernel_sse41;
+			int32_t days[BATCH_CHUNK];
+			uint32_t secOfDay[BATCH_CHUNK];
+			uint32_t micros;
+			size_t simdCount = count & ~(size_t)7;
+			while (i < simdCount) {
+				size_t chunk = simdCount - i;
+				if (chunk > BATCH_CHUNK) chunk = BATCH_CHUNK;
+
+				//64-bit division is done by scalar code
+				for (size_t j = 0; j < chunk; j++) {
+					splitRaw(raw[i + j], days[j], secOfDay[j], micros);
+					if (columns.microsecond != NULL) columns.microsecond[i + j] = micros;
+				}
+
+				kernel(days, secOfDay, chunk, columns, i);
+				i += chunk;
+			}
+		}
+#endif // DT_BATCH_X86_SIMD != 0
+		rawToDateTimeScalar(raw, i, count, columns);
+	}
+
+	void dateTimeToRawBatch(const const_date_time_columns_s& columns, size_t count, int64_t* raw) {
+		size_t i = 0;
+#if DT_BATCH_X86_SIMD != 0
+		BatchSIMD simd = activeBatchSIMD();
+		if (simd != BATCH_SCALAR) {
+			dateTimeToRawKernel_t kernel = (simd == BATCH_AVX2) ? dateTimeToRawKernel_avx2 : dateTimeToRawKernel_sse41;
+			int32_t days[BATCH_CHUNK];
+			uint32_t secOfDay[BATCH_CHUNK];
+			size_t simdCount = count & ~(size_t)7;
+			while (i < simdCount) {
+				size_t chunk = simdCount - i;
+				if (chunk > BATCH_CHUNK) chunk = BATCH_CHUNK;
+
+				kernel(columns, i, chunk, days, secOfDay);
+
+				//64-bit multiplication is done by scalar code
+				for (size_t j = 0; j < chunk; j++) {
+					raw[i + j] = joinRaw(days[j], secOfDay[j], columns, i + j);
+				}
+				i += chunk;
+			}
+		}
+#endif // DT_BATCH_X86_SIMD != 0
+		dateTimeToRawScalar(columns, i, count, raw);
+	}
+
+	char* rawToISO8601Batch(const int64_t* raw, size_t count, char* buffer, size_t bufferSize, char separator, uint8_t fractionDigits, int16_t offset, ISOOffset offsetMode, size_t* converted) {
+		size_t done = 0;
+		if (bufferSize == 0) {
+			if (converted != NULL) *converted = 0;
+			return buffer;
+		}
+		char* end = buffer + bufferSize - 1; //Last character is reserved for null terminator
+
+		int32_t year[BATCH_CHUNK];
+		uint8_t month[BATCH_CHUNK];
+		uint8_t day[BATCH_CHUNK];
+		uint8_t hour[BATCH_CHUNK];
+		uint8_t minute[BATCH_CHUNK];
+		uint8_t second[BATCH_CHUNK];
+		uint32_t microsecond[BATCH_CHUNK];
+		date_time_columns_s columns;
+		columns.year = year;
+		columns.month = month;
+		columns.day = day;
+		columns.hour = hour;
+		columns.minute = minute;
+		columns.second = second;
+		columns.microsecond = microsecond;
+
+		bool full = false;
+		while (done < count && !full) {
+			size_t chunk = count - done;
+			if (chunk > BATCH_CHUNK) chunk = BATCH_CHUNK;
+
+			rawToDateTimeBatch(raw + done, chunk, columns);
+
+			for (size_t j = 0; j < chunk; j++) {
+				//Value is written directly to buffer, when separator and the longest value fit into it
+				char tmp[ISO8601_MAX_LENGTH + 2];
+				size_t available = end - buffer;
+				char* out = (available > ISO8601_MAX_LENGTH + 1) ? buffer : tmp;
+				char* outEnd = out;
+				if (done > 0 && separator != '\0') *outEnd++ = separator;
+				outEnd = iso8601ToArray(outEnd, ISO8601_MAX_LENGTH + 1, year[j], month[j], day[j], hour[j], minute[j], second[j], microsecond[j], fractionDigits, offset, offsetMode);
+
+				size_t len = outEnd - out;
+				if (out == tmp) {
+					if (len > available) {
+						full = true;
+						break;
+					}
+					memcpy(buffer, tmp, len);
+				}
+				buffer += len;
+				done++;
+			}
+		}
+
+		buffer[0] = '\0';
+		if (converted != NULL) *converted = done;
+		return buffer; //Returns position of the null terminator
+	}
+
+	/**
+	* @brief Finds the first '\n' character, returns end if it was not found.
+	*/
+	static const char* findNewline(const char* p, const char* end) {
+#if DT_BATCH_X86_SIMD != 0
+		BatchSIMD simd = activeBatchSIMD();
+		if (simd == BATCH_AVX2) return findNewline_avx2(p, end);
+		else if (simd == BATCH_SSE41) return findNewline_sse41(p, end);
+#endif // DT_BATCH_X86_SIMD != 0
+		const char* nl = (const char*)memchr(p, '\n', end - p);
+		return (nl == NULL) ? end : nl;
+	}
+
+	/**
+	* @brief Counts '\n' characters.
+	*/
+	static size_t countNewlines(const char* p, const char* end) {
+#if DT_BATCH_X86_SIMD != 0
+		BatchSIMD simd = activeBatchSIMD();
+		if (simd == BATCH_AVX2) return countNewlines_avx2(p, end);
+		else if (simd == BATCH_SSE41) return countNewlines_sse41(p, end);
+#endif // DT_BATCH_X86_SIMD != 0
+		size_t count = 0;
+		for (; p < end; p++) count += *p == '\n';
+		return count;
+	}
+
+	size_t countLines(const char* buffer, size_t length) {
+		if (length == 0) return 0;
+		return countNewlines(buffer, buffer + length) + (buffer[length - 1] != '\n');
+	}
+
+	/**
+	* @brief Parses lines by DateTimeParser.
+	*/
+	struct FormatLineParser {
+		const DateTimeParser& parser;
+		int64_t* raw;
+		uint8_t* status;
+		int16_t* offset;
+
+		void operator()(const char* line, size_t length, bool terminated, size_t index) const {
+			parse_state_s state;
+			int ret = 0;
+			if (length > 0) {
+				if (terminated) {
+					//Line is parsed in place, '\n' is handled as null terminator
+					const size_t maxLength = (size_t)(~0U >> 1) - 1; //Maximum value of int minus null terminator
+					if (length > maxLength) length = maxLength;
+					ret = parser.parse(line, (int)length + 1, state);
+				}
+				else {
+					//Character after the last line does not have to be readable, so only the last line is copied
+					char tail[DT_BATCH_LINE_TAIL + 1];
+					if (length > DT_BATCH_LINE_TAIL) length = DT_BATCH_LINE_TAIL;
+					memcpy(tail, line, length);
+					tail[length] = '\0';
+					ret = parser.parse(tail, (int)length + 1, state);
+				}
+			}
+
+			if (ret > 0) {
+				raw[index] = dateTimeToRaw(state.value);
+				if (status != NULL) status[index] = LINE_OK;
+				if (offset != NULL) offset[index] = (state.TZandDSToffset != 0) ? state.TZandDSToffset : state.timeZoneOffset + state.DSTOffset;
+			}
+			else {
+				raw[index] = 0;
+				if (status != NULL) status[index] = (length == 0) ? LINE_EMPTY : LINE_FAILED;
+				if (offset != NULL) offset[index] = 0;
+			}
+		}
+	};
+
+	/**
+	* @brief Parses lines by parseISO8601().
+	*/
+	struct ISO8601LineParser {
+		int64_t* raw;
+		uint8_t* status;
+		int16_t* offset;
+
+		void operator()(const char* line, size_t length, bool /*terminated*/, size_t index) const {
+			int64_t value = 0;
+			int16_t off = 0;
+			bool hasOffset = false;
+			int ret = (length > 0) ? parseISO8601(line, length, value, off, hasOffset) : 0;
+			if (ret <= 0) {
+				value = 0;
+				off = 0;
+			}
+			raw[index] = value;
+			if (status != NULL) status[index] = (ret > 0) ? LINE_OK : ((length == 0) ? LINE_EMPTY : LINE_FAILED);
+			if (offset != NULL) offset[index] = off;
+		}
+	};
+
+	/**
+	* @brief Parses all lines in part of buffer. Part has to start at the beginning of line.
+	* @return Returns count of parsed lines.
+	*/
+	template<class LineParser>
+	static size_t parseLinesRange(const char* p, const char* end, size_t firstLine, size_t maxLines, const LineParser& lineParser) {
+		size_t index = firstLine;
+		while (p < end && index < maxLines) {
+			const char* nl = findNewline(p, end);
+			lineParser(p, nl - p, nl < end, index);
+			index++;
+			p = nl + 1;
+		}
+		return index - firstLine;
+	}
+
+	template<class LineParser>
+	static size_t parseLines(const char* buffer, size_t length, size_t maxLines, uint8_t threads, const LineParser& lineParser) {
+		const char* end = buffer + length;
+#if DT_BATCH_THREADS != 0
+		size_t parts = threads;
+		if (parts > DT_BATCH_MAX_THREADS) parts = DT_BATCH_MAX_THREADS;
+		if (parts > length / DT_BATCH_MIN_THREAD_BYTES) parts = length / DT_BATCH_MIN_THREAD_BYTES;
+
+		if (parts > 1) {
+			//Buffer is split to parts, which start at the beginning of line
+			const char* starts[DT_BATCH_MAX_THREADS + 1];
+			size_t firstLines[DT_BATCH_MAX_THREADS + 1];
+			size_t parsed[DT_BATCH_MAX_THREADS];
+			std::thread workers[DT_BATCH_MAX_THREADS];
+			starts[0] = buffer;
+			starts[parts] = end;
+			for (size_t k = 1; k < parts; k++) {
+				const char* p = buffer + length / parts * k;
+				if (p < starts[k - 1]) p = starts[k - 1];
+				p = findNewline(p, end);
+				starts[k] = (p < end) ? p + 1 : end;
+			}
+
+			//Index of the first line of each part is needed, so lines are counted first
+			for (size_t k = 0; k < parts; k++) {
+				workers[k] = std::thread([&, k]() {
+					firstLines[k + 1] = countNewlines(starts[k], starts[k + 1]);
+				});
+			}
+			for (size_t k = 0; k < parts; k++) workers[k].join();
+			firstLines[0] = 0;
+			for (size_t k = 1; k <= parts; k++) firstLines[k] += firstLines[k - 1];
+
+			for (size_t k = 0; k < parts; k++) {
+				workers[k] = std::thread([&, k]() {
+					parsed[k] = parseLinesRange(starts[k], starts[k + 1], firstLines[k], maxLines, lineParser);
+				});
+			}
+			size_t total = 0;
+			for (size_t k = 0; k < parts; k++) {
+				workers[k].join();
+				total += parsed[k];
+			}
+			return total;
+		}
+#endif // DT_BATCH_THREADS != 0
+		return parseLinesRange(buffer, end, 0, maxLines, lineParser);
+	}
+
+	size_t parseLinesBatch(const char* buffer, size_t length, const DateTimeParser& parser, int64_t* raw, uint8_t* status, int16_t* offset, size_t maxLines, uint8_t threads) {
+		FormatLineParser lineParser = { parser, raw, status, offset };
+		return parseLines(buffer, length, maxLines, threads, lineParser);
+	}
+
+	size_t parseISO8601LinesBatch(const char* buffer, size_t length, int64_t* raw, uint8_t* status, int16_t* offset, size_t maxLines, uint8_t threads) {
+		ISO8601LineParser lineParser = { raw, status, offset };
+		return parseLines(buffer, length, maxLines, threads, lineParser);
+	}
+
+	/**
+	* @struct offset_run_s
+	* @brief Range of values with the same offset.
+	*/
+	struct offset_run_s {
+		int64_t from = 1;		//First value of range
+		int64_t until = 0;		//Value after the last value of range
+		int64_t offset = 0;		//Offset added to all values of range
+		bool isDST = false;
+	};
+
+	/**
+	* @brief Finds count of values at the beginning of array, which are in range of run.
+	*/
+	static size_t findRunEnd(const int64_t* values, size_t count, const offset_run_s& run) {
+#if DT_BATCH_X86_SIMD != 0
+		if (activeBatchSIMD() == BATCH_AVX2) return findRunEnd_avx2(values, count, run.from, run.until);
+#endif // DT_BATCH_X86_SIMD != 0
+		size_t i = 0;
+		while (i < count && values[i] >= run.from && values[i] < run.until) i++;
+		return i;
+	}
+
+	static void addOffset(const int64_t* src, int64_t* dst, size_t count, int64_t offset) {
+#if DT_BATCH_X86_SIMD != 0
+		BatchSIMD simd = activeBatchSIMD();
+		if (simd == BATCH_AVX2) return addOffset_avx2(src, dst, count, offset);
+		else if (simd == BATCH_SSE41) return addOffset_sse41(src, dst, count, offset);
+#endif // DT_BATCH_X86_SIMD != 0
+		for (size_t i = 0; i < count; i++) dst[i] = src[i] + offset;
+	}
+
+	/**
+	* @brief Sets or clears bits from index from to index to (exclusive).
+	*/
+	static void fillBits(uint8_t* bitmap, size_t from, size_t to, bool value) {
+		uint8_t fill = value ? 0xFFU : 0x00U;
+		while (from < to && (from & 7) != 0) {
+			bitmap[from >> 3] = (uint8_t)((bitmap[from >> 3] & ~(1U << (from & 7))) | ((uint8_t)value << (from & 7)));
+			from++;
+		}
+		if (to - from >= 8) {
+			memset(bitmap + (from >> 3), fill, (to - from) >> 3);
+			from += (to - from) & ~(size_t)7;
+		}
+		for (; from < to; from++) {
+			bitmap[from >> 3] = (uint8_t)((bitmap[from >> 3] & ~(1U << (from & 7))) | ((uint8_t)value << (from & 7)));
+		}
+	}
+
+	/**
+	* @brief Adds offset of run to each value. When value is out of current run, new run is found by zone walker,
+	* so sorted values are walked together with transitions and unsorted values only cause more searching.
+	*/
+	template<class Walker>
+	static void convertRuns(const int64_t* src, size_t count, int64_t* dst, Walker& walker, uint8_t* dstBitmap) {
+		offset_run_s run;
+		size_t i = 0;
+		while (i < count) {
+			if (src[i] < run.from || src[i] >= run.until) {
+				walker.find(src[i], run);
+			}
+			size_t n = 1 + findRunEnd(src + i + 1, count - i - 1, run);
+			addOffset(src + i, dst + i, n, run.offset);
+			if (dstBitmap != NULL) fillBits(dstBitmap, i, i + n, run.isDST);
+			i += n;
+		}
+	}
+
+	/**
+	* @brief Walks DST regions of UTC values.
+	*/
+	struct DSTLocalWalker {
+		const DSTAdjustment& dst;
+		int64_t tzOffset;
+
+		void find(int64_t utc, offset_run_s& run) const {
+			int64_t regionEnd;
+			run.isDST = dst.checkDSTRegion(utc + tzOffset, regionEnd);
+			run.from = utc;
+			run.until = (regionEnd == INT64_MAX) ? INT64_MAX : regionEnd - tzOffset;
+			run.offset = tzOffset + (run.isDST ? ((int64_t)dst.getDSTOffsetTotalMinutes()) * MINUTE : 0);
+		}
+	};
+
+	/**
+	* @brief Walks DST regions of local values.
+	*/
+	struct DSTUTCWalker {
+		const DSTAdjustment& dst;
+		int64_t tzOffset;
+
+		void find(int64_t local, offset_run_s& run) const {
+			int64_t DSTOffset = ((int64_t)dst.getDSTOffsetTotalMinutes()) * MINUTE;
+			//Ambiguous local time is checked as time with the greater offset (the earlier instant), skipped local time as time before transition
+			int64_t shift = (DSTOffset > 0) ? DSTOffset : 0;
+			int64_t regionEnd;
+			run.isDST = dst.checkDSTRegion(local - shift, regionEnd);
+			run.from = local;
+			run.until = (regionEnd == INT64_MAX) ? INT64_MAX : regionEnd + shift;
+			run.offset = -tzOffset - (run.isDST ? DSTOffset : 0);
+		}
+	};
+
+	void toLocalBatch(const int64_t* utc, size_t count, int64_t* local, TimeZone tz, const DSTAdjustment& dst, uint8_t* dstBitmap) {
+		DSTLocalWalker walker = { dst, ((int64_t)tz.getTimeZoneOffsetTotalMinutes()) * MINUTE };
+		convertRuns(utc, count, local, walker, dstBitmap);
+	}
+
+	void toUTCBatch(const int64_t* local, size_t count, int64_t* utc, TimeZone tz, const DSTAdjustment& dst, uint8_t* dstBitmap) {
+		DSTUTCWalker walker = { dst, ((int64_t)tz.getTimeZoneOffsetTotalMinutes()) * MINUTE };
+		convertRuns(local, count, utc, walker, dstBitmap);
+	}
+
+#if DT_UNDER_OS > 0
+	/**
+	* @brief Walks transitions of TZif zone. Transitions are found by linear search from the last transition (merge of sorted values
+	* and transitions) and by binary search, when value is far from the last transition.
+	* Local time is mapped using thresholds of transitions in local time, which are the later of local times before and after transition.
+	*/
+	template<bool toUTC>
+	struct TZifWalker {
+		const TZifZone& zone;
+		size_t index;		//Count of transitions, which already happened
+
+		static int64_t offsetOf(const tzif_type_s& type) {
+			return ((int64_t)type.utcOffset) * SECOND;
+		}
+
+		const tzif_type_s& typeBefore(size_t i) const {
+			return (i == 0) ? zone.getInitialType() : zone.getTransitionType(i - 1);
+		}
+
+		int64_t threshold(size_t i) const {
+			int64_t t = zone.getTransition(i);
+			if (toUTC) {
+				int64_t before = offsetOf(typeBefore(i));
+				int64_t after = offsetOf(zone.getTransitionType(i));
+				t += (before > after) ? before : after;
+			}
+			return t;
+		}
+
+		void find(int64_t value, offset_run_s& run) {
+			if (!zone.isValid()) {
+				run.from = INT64_MIN;
+				run.until = INT64_MAX;
+				run.offset = 0;
+				run.isDST = false;
+				return;
+			}
+
+			size_t n = zone.getTransitionCount();
+			uint8_t steps = 0;
+			while (index < n && threshold(index) <= value && steps < 8) {
+				index++;
+				steps++;
+			}
+			if (steps == 8 || (index > 0 && value < threshold(index - 1))) {
+				//Binary search
+				size_t lo = 0;
+				size_t hi = n;
+				while (lo < hi) {
+					size_t mid = lo + (hi - lo) / 2;
+					if (threshold(mid) <= value) lo = mid + 1;
+					else hi = mid;
+				}
+				index = lo;
+			}
+
+			if (index == n && zone.hasFooter()) {
+				//After the last transition, POSIX rule is used
+				const DSTAdjustment& dst = zone.getFooterDST();
+				int64_t tzOffset = ((int64_t)zone.getFooterTimeZone().getTimeZoneOffsetTotalMinutes()) * MINUTE;
+				if (toUTC) {
+					DSTUTCWalker walker = { dst, tzOffset };
+					walker.find(value, run);
+				}
+				else {
+					DSTLocalWalker walker = { dst, tzOffset };
+					walker.find(value, run);
+				}
+				return;
+			}
+
+			const tzif_type_s& type = typeBefore(index);
+			run.from = (index == 0) ? INT64_MIN : threshold(index - 1);
+			run.until = (index == n) ? INT64_MAX : threshold(index);
+			run.offset = toUTC ? -offsetOf(type) : offsetOf(type);
+			run.isDST = type.isDST != 0;
+		}
+	};
+
+	void toLocalBatch(const int64_t* utc, size_t count, int64_t* local, const TZifZone& zone, uint8_t* dstBitmap) {
+		TZifWalker<false> walker = { zone, 0 };
+		convertRuns(utc, count, local, walker, dstBitmap);
+	}
+
+	void toUTCBatch(const int64_t* local, size_t count, int64_t* utc, const TZifZone& zone, uint8_t* dstBitmap) {
+		TZifWalker<true> walker = { zone, 0 };
+		convertRuns(local, count, utc, walker, dstBitmap);
+	}
+#endif // DT_UNDER_OS > 0
+}
@@ -0,0 +1,266 @@
+/**
+ * @file DateTimeBatch.h
+ * @brief This file contains functions for conversion of many raw values at once (batch conversion).
+ *
+ * Values are converted from/to columns (struct of arrays), so each field has its own array. On x86 and x86-64
+ * processors, conversion uses AVX2 or SSE4.1 instructions, which are selected at runtime depending on CPU.
+ * Scalar version is used on other processors and it gives exactly the same results.
+ *
+ * Timestamps at the beginning of lines of large text buffers (for example memory-mapped log files) can be parsed
+ * by parseLinesBatch() and parseISO8601LinesBatch(). Lines are found by SIMD search and buffer can be split across threads.
+ *
+ * Arrays of UTC values can be converted to local time and back by toLocalBatch() and toUTCBatch(). Values and transitions of time zone
+ * are walked together, so transitions are evaluated only once for each run of values with the same offset.
+ *
+ * # Credits
+ * @author Matej Fitoš
+ */
+
+#ifndef _DATE_TIME_BATCH_H
+#define _DATE_TIME_BATCH_H
+
+#include "DateTimeHelpers.h"
+#include "DateTimeParser.h"
+#include "tzfileParser.h"
+
+#if !defined(DT_NO_SIMD) && !defined(DT_LEGACY_CALENDAR) && (defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86))
+#define DT_BATCH_X86_SIMD	(1U)	//SIMD kernels for x86 are compiled
+#else
+#define DT_BATCH_X86_SIMD	(0U)	//Only scalar kernel is compiled
+#endif
+
+#if DT_UNDER_OS > 0 && !defined(DT_NO_THREADS)
+#define DT_BATCH_THREADS	(1U)	//Batch parsing of lines can use more threads
+#else
+#define DT_BATCH_THREADS	(0U)	//Lines are always parsed by calling thread
+#endif
+
+#ifndef DT_BATCH_MAX_THREADS
+#define DT_BATCH_MAX_THREADS		(64)		//Maximum count of threads used by batch parsing of lines
+#endif // !DT_BATCH_MAX_THREADS
+
+#ifndef DT_BATCH_MIN_THREAD_BYTES
+#define DT_BATCH_MIN_THREAD_BYTES	(65536)		//Minimum count of bytes parsed by one thread, smaller buffers use less threads
+#endif // !DT_BATCH_MIN_THREAD_BYTES
+
+#ifndef DT_BATCH_LINE_TAIL
+#define DT_BATCH_LINE_TAIL			(128)		//Maximum count of characters of the last unterminated line passed to DateTimeParser
+#endif // !DT_BATCH_LINE_TAIL
+
+/**
+* @struct date_time_columns_s
+* @brief Structure of pointers to columns (arrays) of date and time fields. Each column has to have at least
+* the same count of elements as is count of converted values. Any column can be NULL, then it is skipped.
+*/
+struct date_time_columns_s {
+	int32_t* year = NULL;			/**< Year column. Year range is from MIN_YEAR to MAX_YEAR except 0. */
+	uint8_t* month = NULL;			/**< Month column, values are in range 1-12. */
+	uint8_t* day = NULL;			/**< Day of month column, values are in range 1-31. */
+	uint8_t* hour = NULL;			/**< Hour column, values are in range 0-23. */
+	uint8_t* minute = NULL;			/**< Minute column, values are in range 0-59. */
+	uint8_t* second = NULL;			/**< Second column, values are in range 0-59. */
+	uint32_t* microsecond = NULL;	/**< Microseconds of second column (milliseconds * 1000 + microseconds), values are in range 0-999999. */
+	uint8_t* dayOfWeek = NULL;		/**< Day of week column, values are in range 1-7, see DayOfWeek. */
+};
+
+/**
+* @struct const_date_time_columns_s
+* @brief Structure of pointers to read only columns (arrays) of date and time fields.
+* Year, month and day columns are required, time columns can be NULL, then 0 is used.
+*/
+struct const_date_time_columns_s {
+	const_date_time_columns_s() {}
+
+	const_date_time_columns_s(const date_time_columns_s& cols) :
+		year(cols.year),
+		month(cols.month),
+		day(cols.day),
+		hour(cols.hour),
+		minute(cols.minute),
+		second(cols.second),
+		microsecond(cols.microsecond)
+	{}
+
+	const int32_t* year = NULL;			/**< Year column. Year range is from MIN_YEAR to MAX_YEAR except 0. */
+	const uint8_t* month = NULL;		/**< Month column, values are in range 1-12. */
+	const uint8_t* day = NULL;			/**< Day of month column, values are in range 1-31. */
+	const uint8_t* hour = NULL;			/**< Hour column in 24 hour format, values are in range 0-23. */
+	const uint8_t* minute = NULL;		/**< Minute column, values are in range 0-59. */
+	const uint8_t* second = NULL;		/**< Second column, values are in range 0-59. */
+	const uint32_t* microsecond = NULL;	/**< Microseconds of second column (milliseconds * 1000 + microseconds), values are in range 0-999999. */
+};
+
+namespace dtlib {
+
+	/**
+	* @enum BatchSIMD
+	* @brief Instruction set used by batch conversion functions.
+	*/
+	enum BatchSIMD {
+		BATCH_SCALAR = 0,	/**< No SIMD instructions are used. */
+		BATCH_SSE41 = 1,	/**< SSE4.1 instructions are used, 4 values are converted at once. */
+		BATCH_AVX2 = 2		/**< AVX2 instructions are used, 8 values are converted at once. */
+	};
+
+	/**
+	* @enum LineStatus
+	* @brief Status of one line parsed by parseLinesBatch() or parseISO8601LinesBatch().
+	*/
+	enum LineStatus : uint8_t {
+		LINE_OK = 0,		/**< Timestamp was parsed. */
+		LINE_EMPTY = 1,		/**< Line is empty, raw value is 0. */
+		LINE_FAILED = 2		/**< Timestamp at the beginning of line could not be parsed, raw value is 0. */
+	};
+
+	/**
+	* @brief Gets instruction set, which is currently used by batch conversion functions.
+	* @note By default, the best instruction set supported by CPU is used.
+	*/
+	BatchSIMD getBatchSIMD();
+
+	/**
+	* @brief Sets instruction set, which will be used by batch conversion functions. This is useful mainly for testing and benchmarks.
+	* @param simd Requested instruction set. If it is not supported by CPU, the best supported instruction set is used instead.
+	* @return Returns instruction set, which will be used.
+	*/
+	BatchSIMD setBatchSIMD(BatchSIMD simd);
+
+	/**
+	* @brief Converts array of raw values to columns of date and time fields.
+	* @note Result is the same as result of rawToDateTime() for each value.
+	* @param raw Array of raw values (microseconds since year 1).
+	* @param count Count of values to convert.
+	* @param columns Output columns. Columns, which are NULL, are not calculated.
+	*/
+	void rawToDateTimeBatch(const int64_t* raw, size_t count, const date_time_columns_s& columns);
+
+	/**
+	* @brief Converts columns of date and time fields to array of raw values.
+	* @note Result is the same as result of dateTimeToRaw() for each value.
+	* @param columns Input columns. Year, month and day columns are required.
+	* @param count Count of values to convert.
+	* @param raw Output array of raw values (microseconds since year 1).
+	*/
+	void dateTimeToRawBatch(const const_date_time_columns_s& columns, size_t count, int64_t* raw);
+
+	/**
+	* @brief Converts array of raw values to ISO 8601 strings, which are written one after another into one contiguous buffer.
+	* This is intended for CSV or JSON writers. Date and time fields are calculated using rawToDateTimeBatch()
+	* and each value is written by iso8601ToArray(), so result of each value is the same as result of iso8601ToArray().
+	* @note Only whole values are written. If buffer is too small, conversion is stopped before the first value, which does not fit.
+	* @param raw Array of raw values (microseconds since year 1) in local time.
+	* @param count Count of values to convert.
+	* @param buffer Buffer, where strings will be written. Null terminator is inserted after the last value.
+	* @param bufferSize Size of buffer including null terminator.
+	* @param separator Character, which is written between values. If it is '\0', values are written without separator.
+	* @param fractionDigits Count of fraction digits from 0 to 6.
+	* @param offset Time zone offset (including DST offset) in minutes, which is written to all values.
+	* @param offsetMode Specifies, how offset is written.
+	* @param[out] converted Count of written values. It can be NULL.
+	* @return Returns pointer to buffer, where null terminator was inserted.
+	*/
+	char* rawToISO8601Batch(const int64_t* raw, size_t count, char* buffer, size_t bufferSize, char separator = '\n', uint8_t fractionDigits = 6, int16_t offset = 0, ISOOffset offsetMode = ISO_OFFSET_NUMERIC, size_t* converted = NULL);
+
+	/**
+	* @brief Counts lines in buffer. Lines are separated by '\n', the last line does not have to be terminated.
+	* @param buffer Text buffer, null terminator is not required.
+	* @param length Length of text in buffer.
+	* @return Returns count of lines.
+	*/
+	size_t countLines(const char* buffer, size_t length);
+
+	/**
+	* @brief Parses timestamp at the beginning of each line of buffer. Each line is parsed in place (it is not copied)
+	* and result of each line is the same as result of DateTimeParser::parse() (and so dtlib::parseDateTime()).
+	* Lines are separated by '\n', the last line does not have to be terminated.
+	* @note Only timestamp at the beginning of line has to match format, rest of line is not checked.
+	* Output arrays have to be allocated by caller, required size can be found by countLines().
+	* @param buffer Text buffer, for example memory-mapped file. Null terminator is not required.
+	* @param length Length of text in buffer.
+	* @param parser Precompiled format of timestamp.
+	* @param[out] raw Array of parsed raw values (microseconds since year 1) as written in line (offset is not applied).
+	* @param[out] status Array of statuses of lines, see LineStatus. It can be NULL.
+	* @param[out] offset Array of parsed offsets (time zone and DST offset) in minutes. It can be NULL.
+	* @param maxLines Size of output arrays. Parsing is stopped, when this count of lines is reached.
+	* @param threads Count of threads, which are used for parsing. Buffer is split to parts with whole lines.
+	*        Less threads are used for small buffers, see DT_BATCH_MIN_THREAD_BYTES. It is ignored, when threads are not available.
+	* @return Returns count of parsed lines.
+	*/
+	size_t parseLinesBatch(const char* buffer, size_t length, const DateTimeParser& parser, int64_t* raw, uint8_t* status, int16_t* offset, size_t maxLines, uint8_t threads = 1);
+
+	/**
+	* @brief Parses ISO 8601 / RFC 3339 timestamp at the beginning of each line of buffer. Each line is parsed in place (it is not copied)
+	* and result of each line is the same as result of dtlib::parseISO8601(). Lines are separated by '\n', the last line does not have to be terminated.
+	* @note Only timestamp at the beginning of line has to be valid, rest of line is not checked.
+	* Output arrays have to be allocated by caller, required size can be found by countLines().
+	* @param buffer Text buffer, for example memory-mapped file. Null terminator is not required.
+	* @param length Length of text in buffer.
+	* @param[out] raw Array of parsed raw values (microseconds since year 1) as written in line (offset is not applied).
+	* @param[out] status Array of statuses of lines, see LineStatus. It can be NULL.
+	* @param[out] offset Array of parsed offsets in minutes, it is 0 if timestamp has no offset. It can be NULL.
+	* @param maxLines Size of output arrays. Parsing is stopped, when this count of lines is reached.
+	* @param threads Count of threads, which are used for parsing. Buffer is split to parts with whole lines.
+	*        Less threads are used for small buffers, see DT_BATCH_MIN_THREAD_BYTES. It is ignored, when threads are not available.
+	* @return Returns count of parsed lines.
+	*/
+	size_t parseISO8601LinesBatch(const char* buffer, size_t length, int64_t* raw, uint8_t* status, int16_t* offset, size_t maxLines, uint8_t threads = 1);
+
+	/**
+	* @brief Converts array of UTC raw values to local time. Result of each value is the same as result of adding time zone offset
+	* and DST offset, when DSTAdjustment::checkDSTRegion() returns true for value with added time zone offset.
+	* @note Sorted values are converted fastest, because DST region is checked only once for each run of values in the same region
+	* and offset is added to the whole run by SIMD instructions. Unsorted values are converted correctly too, but region is checked more often.
+	* @param utc Array of UTC raw values (microseconds since year 1).
+	* @param count Count of values to convert.
+	* @param[out] local Output array of local raw values. It can be the same array as utc.
+	* @param tz Time zone.
+	* @param dst DST adjustment rules.
+	* @param[out] dstBitmap Bitmap with one bit per value (bit i % 8 of byte i / 8), bit is set if DST is applyied to value.
+	*        It has to have at least (count + 7) / 8 bytes. It can be NULL.
+	*/
+	void toLocalBatch(const int64_t* utc, size_t count, int64_t* local, TimeZone tz, const DSTAdjustment& dst, uint8_t* dstBitmap = NULL);
+
+	/**
+	* @brief Converts array of local raw values to UTC. Ambiguous local times (when clock is moved back) use the greater offset
+	* (the earlier instant) and local times skipped by moving clock forward use offset before transition.
+	* @note Sorted values are converted fastest, see toLocalBatch().
+	* @param local Array of local raw values (microseconds since year 1) with applyied time zone and DST offset.
+	* @param count Count of values to convert.
+	* @param[out] utc Output array of UTC raw values. It can be the same array as local.
+	* @param tz Time zone.
+	* @param dst DST adjustment rules.
+	* @param[out] dstBitmap Bitmap with one bit per value (bit i % 8 of byte i / 8), bit is set if DST was applyied to value.
+	*        It has to have at least (count + 7) / 8 bytes. It can be NULL.
+	*/
+	void toUTCBatch(const int64_t* local, size_t count, int64_t* utc, TimeZone tz, const DSTAdjustment& dst, uint8_t* dstBitmap = NULL);
+
+#if DT_UNDER_OS > 0
+	/**
+	* @brief Converts array of UTC raw values to local time of zone loaded from TZif file. Result of each value is the same as result of TZifZone::toLocal().
+	* @note Sorted values are converted fastest, because transitions are walked together with values (transition is not searched for each value)
+	* and offset is added to each run of values between transitions by SIMD instructions. Unsorted values are converted correctly too.
+	* @param utc Array of UTC raw values (microseconds since year 1).
+	* @param count Count of values to convert.
+	* @param[out] local Output array of local raw values. It can be the same array as utc.
+	* @param zone Time zone.
+	* @param[out] dstBitmap Bitmap with one bit per value (bit i % 8 of byte i / 8), bit is set if DST is applyied to value.
+	*        It has to have at least (count + 7) / 8 bytes. It can be NULL.
+	*/
+	void toLocalBatch(const int64_t* utc, size_t count, int64_t* local, const TZifZone& zone, uint8_t* dstBitmap = NULL);
+
+	/**
+	* @brief Converts array of local raw values to UTC using zone loaded from TZif file. Ambiguous local times (when clock is moved back)
+	* use offset before transition (the earlier instant) and local times skipped by moving clock forward use offset before transition too.
+	* @note Sorted values are converted fastest, see toLocalBatch().
+	* @param local Array of local raw values (microseconds since year 1).
+	* @param count Count of values to convert.
+	* @param[out] utc Output array of UTC raw values. It can be the same array as local.
+	* @param zone Time zone.
+	* @param[out] dstBitmap Bitmap with one bit per value (bit i % 8 of byte i / 8), bit is set if DST was applyied to value.
+	*        It has to have at least (count + 7) / 8 bytes. It can be NULL.
+	*/
+	void toUTCBatch(const int64_t* local, size_t count, int64_t* utc, const TZifZone& zone, uint8_t* dstBitmap = NULL);
+#endif // DT_UNDER_OS > 0
+}
+
+#endif // !_DATE_TIME_BATCH_H
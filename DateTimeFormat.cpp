@@ -0,0 +1,234 @@
+#include "DateTimeFormat.h"
+#include "TimeSpan.h"
+
+char* DateTimeFormat::toArray(char* buffer, size_t bufferSize, int64_t value, int16_t timeZoneOffset, int16_t DSTOffset) const {
+	if (bufferSize == 0) return buffer;
+	bufferSize--;
+
+	if (error != FORMAT_OK || target != TARGET_DATE_TIME) {
+		buffer[0] = '\0';
+		return buffer;
+	}
+
+	//Date and time are resolved only once for all specifiers
+	date_s ds;
+	time_s ts;
+	if (needsDate) ds = dtlib::rawToDate(value);
+	if (needsTime) ts = dtlib::rawToTime(value);
+
+	const char* textPtr = text;
+	for (uint8_t i = 0; i < opsCount && bufferSize > 0; i++) {
+		const format_op_s& op = ops[i];
+		char* newBuffer = buffer;
+		switch (op.code) {
+		case OP_TEXT: {
+			size_t len = op.arg;
+			if (len > bufferSize) len = bufferSize; //Limit
+			memcpy(buffer, textPtr, len);
+			textPtr += op.arg;
+			newBuffer = buffer + len;
+			break;
+		}
+		case OP_DAY:
+			newBuffer = dtlib::intToStr2(buffer, bufferSize, ds.day, op.arg != 0);
+			break;
+		case OP_DAY_NAME3:
+			if (bufferSize < 3) {
+				bufferSize = 0;
+			}
+			else {
+				memcpy(buffer, weekDayNames[ds.dayOfWeek - 1], 3);
+				newBuffer = buffer + 3;
+			}
+			break;
+		case OP_DAY_NAME: {
+			size_t len = strlen(weekDayNames[ds.dayOfWeek - 1]);
+			if (len > bufferSize) len = bufferSize; //Limit
+			memcpy(buffer, weekDayNames[ds.dayOfWeek - 1], len);
+			newBuffer = buffer + len;
+			break;
+		}
+		case OP_MONTH:
+			newBuffer = dtlib::intToStr2(buffer, bufferSize, ds.month, op.arg != 0);
+			break;
+		case OP_MONTH_NAME3:
+			if (bufferSize < 3) {
+				bufferSize = 0;
+			}
+			else {
+				memcpy(buffer, monthNames[ds.month - 1], 3);
+				newBuffer = buffer + 3;
+			}
+			break;
+		case OP_MONTH_NAME: {
+			size_t len = strlen(monthNames[ds.month - 1]);
+			if (len > bufferSize) len = bufferSize; //Limit
+			memcpy(buffer, monthNames[ds.month - 1], len);
+			newBuffer = buffer + len;
+			break;
+		}
+		case OP_YEAR2:
+		case OP_YEAR: {
+			uint32_t year;
+			if (ds.year < 0) year = -ds.year; //Absolute value of year
+			else year = ds.year;
+			if (op.code == OP_YEAR2) {
+				newBuffer = dtlib::intToStr2(buffer, bufferSize, year, op.arg != 0);
+			}
+			else {
+				newBuffer = dtlib::intToStr(buffer, bufferSize, year, (int8_t)op.arg);
+			}
+			break;
+		}
+		case OP_HOUR12: {
+			hour_t hours = ts.hours;
+			hours.convertTo12();
+			newBuffer = dtlib::intToStr2(buffer, bufferSize, hours, op.arg != 0);
+			break;
+		}
+		case OP_HOUR24:
+			newBuffer = dtlib::intToStr2(buffer, bufferSize, ts.hours, op.arg != 0);
+			break;
+		case OP_MINUTE:
+			newBuffer = dtlib::intToStr2(buffer, bufferSize, ts.minutes, op.arg != 0);
+			break;
+		case OP_SECOND:
+			newBuffer = dtlib::intToStr2(buffer, bufferSize, ts.seconds, op.arg != 0);
+			break;
+		case OP_FRACT:
+		case OP_FRACT_STRICT: {
+			uint32_t fraction = ((uint32_t)ts.milliseconds) * MILLISECOND + ts.microseconds;
+			newBuffer = dtlib::ms_usFractToStr(buffer, bufferSize, fraction, (int8_t)op.arg, op.code == OP_FRACT_STRICT);
+			break;
+		}
+		case OP_MILLIS:
+			newBuffer = dtlib::intToStr(buffer, bufferSize, ts.milliseconds, (int8_t)op.arg);
+			break;
+		case OP_MICROS:
+			newBuffer = dtlib::intToStr(buffer, bufferSize, ts.microseconds, (int8_t)op.arg);
+			break;
+		case OP_AM_PM:
+			if (bufferSize < op.arg) {
+				bufferSize = 0;
+			}
+			else {
+				buffer[0] = (ts.hours.isAM()) ? 'A' : 'P';
+				if (op.arg > 1) buffer[1] = 'M';
+				newBuffer = buffer + op.arg;
+			}
+			break;
+		case OP_ERA:
+			if (op.arg || value < 0) {
+				if (bufferSize < 4) {
+					bufferSize = 0;
+				}
+				else {
+					memcpy(buffer, (value < 0) ? "B.C." : "A.D.", 4);
+					newBuffer = buffer + 4;
+				}
+			}
+			break;
+		case OP_SIGN:
+			if (op.arg || value < 0) {
+				buffer[0] = (value < 0) ? '-' : '+';
+				newBuffer = buffer + 1;
+			}
+			break;
+		case OP_TZ:
+			newBuffer = dtlib::tzToStr(buffer, bufferSize, timeZoneOffset, op.arg);
+			break;
+		case OP_TZ_DST:
+			newBuffer = dtlib::tzToStr(buffer, bufferSize, timeZoneOffset + DSTOffset, op.arg);
+			break;
+		case OP_DST:
+			newBuffer = dtlib::tzToStr(buffer, bufferSize, DSTOffset, op.arg);
+			break;
+		}
+		bufferSize -= newBuffer - buffer;
+		buffer = newBuffer;
+	}
+
+	buffer[0] = '\0';
+
+	return buffer; //Returns position of the null terminator
+}
+
+char* DateTimeFormat::timeSpanToArray(char* buffer, size_t bufferSize, int64_t value) const {
+	if (bufferSize == 0) return buffer;
+	bufferSize--;
+
+	if (error != FORMAT_OK || target != TARGET_TIME_SPAN) {
+		buffer[0] = '\0';
+		return buffer;
+	}
+
+	TimeSpan ts(value);
+
+	const char* textPtr = text;
+	for (uint8_t i = 0; i < opsCount && bufferSize > 0; i++) {
+		const format_op_s& op = ops[i];
+		char* newBuffer = buffer;
+		switch (op.code) {
+		case OP_TEXT: {
+			size_t len = op.arg;
+			if (len > bufferSize) len = bufferSize; //Limit
+			memcpy(buffer, textPtr, len);
+			textPtr += op.arg;
+			newBuffer = buffer + len;
+			break;
+		}
+		case OP_TS_DAYS: {
+			int32_t days = ts.getDays();
+			if (days < 0) days = -days; //Absolute value
+			newBuffer = dtlib::intToStr(buffer, bufferSize, days, (int8_t)op.arg);
+			break;
+		}
+		case OP_TS_HOURS: {
+			int8_t hours = ts.getHours();
+			if (hours < 0) hours = -hours; //Absolute value
+			newBuffer = dtlib::intToStr2(buffer, bufferSize, hours, op.arg != 0);
+			break;
+		}
+		case OP_TS_MINUTES: {
+			int8_t minutes = ts.getMinutes();
+			if (minutes < 0) minutes = -minutes; //Absolute value
+			newBuffer = dtlib::intToStr2(buffer, bufferSize, minutes, op.arg != 0);
+			break;
+		}
+		case OP_TS_SECONDS: {
+			int16_t seconds = ts.getSeconds();
+			if (seconds < 0) seconds = -seconds; //Absolute value
+			newBuffer = dtlib::intToStr2(buffer, bufferSize, seconds, op.arg != 0);
+			break;
+		}
+		case OP_FRACT:
+		case OP_FRACT_STRICT:
+			newBuffer = dtlib::ms_usFractToStr(buffer, bufferSize, (int32_t)(value % SECOND), (int8_t)op.arg, op.code == OP_FRACT_STRICT);
+			break;
+		case OP_MILLIS: {
+			int16_t milliseconds = ts.getMilliseconds();
+			if (milliseconds < 0) milliseconds = -milliseconds; //Absolute value
+			newBuffer = dtlib::intToStr(buffer, bufferSize, milliseconds, (int8_t)op.arg);
+			break;
+		}
+		case OP_MICROS: {
+			int16_t microseconds = ts.getMicroseconds();
+			if (microseconds < 0) microseconds = -microseconds; //Absolute value
+			newBuffer = dtlib::intToStr(buffer, bufferSize, microseconds, (int8_t)op.arg);
+			break;
+		}
+		case OP_SIGN:
+			if (op.arg || ts.isNegative()) {
+				buffer[0] = (ts.isNegative()) ? '-' : '+';
+				newBuffer = buffer + 1;
+			}
+			break;
+		}
+		bufferSize -= newBuffer - buffer;
+		buffer = newBuffer;
+	}
+
+	buffer[0] = '\0';
+
+	return buffer; //Returns position of the null terminator
+}
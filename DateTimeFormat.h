@@ -0,0 +1,804 @@
+/**
+ * @file DateTimeFormat.h
+ * @brief This file contains class DateTimeFormat, which is custom date and time (or time span) format compiled to list of operations.
+ *
+ * Format string is scanned only once, when DateTimeFormat is constructed. Converting to string then only
+ * executes prepared operations, so repeated specifiers are not counted again and text and escape marks are not resolved again.
+ * DateTimeFormat does not use dynamic memory, capacity is given by DT_FORMAT_MAX_OPS, DT_FORMAT_MAX_TEXT and DT_FORMAT_MAX_LENGTH.
+ *
+ * @see DateTimeFormat
+ *
+ * # Credits
+ * @author Matej Fitoš
+ */
+
+#ifndef _DATE_TIME_FORMAT_H
+#define _DATE_TIME_FORMAT_H
+
+#include "DateTimeHelpers.h"
+
+#ifndef ARDUINO
+#include <cstring>
+#endif // !ARDUINO
+
+#ifndef DT_FORMAT_MAX_OPS
+#define DT_FORMAT_MAX_OPS		(24)	//Maximum count of operations (specifiers and blocks of text) in one format
+#endif // !DT_FORMAT_MAX_OPS
+
+#ifndef DT_FORMAT_MAX_TEXT
+#define DT_FORMAT_MAX_TEXT		(32)	//Maximum count of text characters in one format
+#endif // !DT_FORMAT_MAX_TEXT
+
+#ifndef DT_FORMAT_MAX_LENGTH
+#define DT_FORMAT_MAX_LENGTH	(64)	//Maximum length of string created by one format (without null terminator)
+#endif // !DT_FORMAT_MAX_LENGTH
+
+#define DT_FORMAT_MAX_SAME_COUNT	(127)	//Maximum count of same characters in a row (format functions use int8_t counter)
+
+#if DT_CPP_VERSION >= 201703L
+#define DT_STATIC_FORMAT			(1U)	//Format known at compile time can be used (DateTimeRawBase::format()), it needs C++17
+#else
+#define DT_STATIC_FORMAT			(0U)	//Format known at compile time cannot be used
+#endif
+
+#if defined(__cpp_nontype_template_args) && __cpp_nontype_template_args >= 201911L
+#define DT_FORMAT_STRING_LITERAL	(1U)	//String literal can be used as template argument
+#define DT_STATIC_FORMAT_PARAM		dtlib::FormatString
+#else
+#define DT_FORMAT_STRING_LITERAL	(0U)	//Only static char array can be used as template argument
+#define DT_STATIC_FORMAT_PARAM		const char*
+#endif
+
+#if DT_STATIC_FORMAT != 0
+namespace dtlib {
+	template<auto Format>
+	struct StaticFormat;
+}
+#endif // DT_STATIC_FORMAT != 0
+
+/**
+* @class DateTimeFormat
+* @brief Custom date and time format or time span format, which is compiled to list of operations.
+* Format specifiers are the same as specifiers used by toArray() and toString() functions of DateTime or TimeSpan,
+* result is also the same.
+*
+* Format is usually created once and then used many times:
+* @code{.cpp}
+* static const DateTimeFormat logFormat("yyyy-MM-dd HH:mm:ss.fff");
+* char buffer[DT_FORMAT_MAX_LENGTH + 1];
+* dt.toArray(buffer, sizeof(buffer), logFormat);
+* @endcode
+*/
+class DateTimeFormat
+{
+public:
+
+	/**
+	* @enum FormatTarget
+	* @brief Type of value, which is formatted by DateTimeFormat.
+	*/
+	enum FormatTarget : uint8_t {
+		TARGET_DATE_TIME = 0,	/**< Format for DateTime (DateTimeRawBase or DateTimeTZBase). */
+		TARGET_TIME_SPAN = 1	/**< Format for TimeSpan. */
+	};
+
+	/**
+	* @enum FormatError
+	* @brief Error found in format string.
+	*/
+	enum FormatError : uint8_t {
+		FORMAT_OK = 0,				/**< Format is valid. */
+		FORMAT_TOO_MANY_OPS,		/**< Format contains more than DT_FORMAT_MAX_OPS specifiers and blocks of text. */
+		FORMAT_TEXT_TOO_LONG,		/**< Format contains more than DT_FORMAT_MAX_TEXT text characters. */
+		FORMAT_OUTPUT_TOO_LONG,		/**< Result string could be longer than DT_FORMAT_MAX_LENGTH characters. */
+		FORMAT_INVALID_COUNT,		/**< Specifier is repeated more times than it is allowed, for example "ddddd". */
+		FORMAT_UNCLOSED_TEXT,		/**< Literal string is not terminated by quote or double quote. */
+		FORMAT_DANGLING_ESCAPE		/**< Escape character is last character of format. */
+	};
+
+	/**
+	* @brief Compiles date and time format.
+	* @param format Custom date and time format, see DateTimeRawBase::toArray() for format specifiers.
+	* @param monthNames Array with custom month names. This array has to contain exactly 12 strings. If set to NULL, English names are used.
+	* @param weekDayNames Array with custom days of week. This array has to contain exactly 7 strings and first name has to be Sunday, then Monday and so on. If set to NULL, English names are used.
+	* @note Arrays with names are not copied, so they have to exist until DateTimeFormat is used.
+	*/
+	explicit DT_CONSTEXPR14 DateTimeFormat(const char* format, const char* const* monthNames = NULL, const char* const* weekDayNames = NULL) :
+		monthNames(monthNames == NULL ? dt_month_names : monthNames),
+		weekDayNames(weekDayNames == NULL ? dt_day_names : weekDayNames),
+		target(TARGET_DATE_TIME)
+	{
+		compile(format);
+	}
+
+	/**
+	* @brief Compiles date and time format or time span format.
+	* @param format Custom date and time format (see DateTimeRawBase::toArray()) or time span format (see TimeSpan::toArray()).
+	* @param target Type of formatted value.
+	*/
+	DT_CONSTEXPR14 DateTimeFormat(const char* format, FormatTarget target) :
+		monthNames(dt_month_names),
+		weekDayNames(dt_day_names),
+		target(target)
+	{
+		compile(format);
+	}
+
+	/**
+	* @brief Checks, if format was compiled without errors.
+	* @return Returns true if format is valid. Invalid format creates empty string.
+	*/
+	constexpr bool isValid() const {
+		return error == FORMAT_OK;
+	}
+
+	/**
+	* @brief Gets error found during compilation.
+	*/
+	constexpr FormatError getError() const {
+		return error;
+	}
+
+	/**
+	* @brief Gets position of character in format string, where error was found.
+	* @return Returns index of character or 0 if format is valid.
+	*/
+	constexpr uint16_t getErrorPosition() const {
+		return errorPosition;
+	}
+
+	/**
+	* @brief Gets maximum length of string created by this format without null terminator.
+	* @note Buffer with size getMaxLength() + 1 is always large enough.
+	*/
+	constexpr uint16_t getMaxLength() const {
+		return maxLength;
+	}
+
+	/**
+	* @brief Gets type of value, which is formatted by this format.
+	*/
+	constexpr FormatTarget getTarget() const {
+		return target;
+	}
+
+	/**
+	* @brief Converts raw date and time value to string.
+	* @param buffer Buffer, where string will be written.
+	* @param bufferSize Size of buffer including null terminator.
+	* @param value Raw date and time value (microseconds since 1.1.0001).
+	* @param timeZoneOffset Time zone offset in minutes.
+	* @param DSTOffset DST offset in minutes.
+	* @return Returns pointer to buffer, where null terminator was inserted.
+	* @note If format is invalid or it is not date and time format, empty string is created.
+	*/
+	char* toArray(char* buffer, size_t bufferSize, int64_t value, int16_t timeZoneOffset = 0, int16_t DSTOffset = 0) const;
+
+	/**
+	* @brief Converts raw time span value to string.
+	* @param buffer Buffer, where string will be written.
+	* @param bufferSize Size of buffer including null terminator.
+	* @param value Raw time span value (microseconds).
+	* @return Returns pointer to buffer, where null terminator was inserted.
+	* @note If format is invalid or it is not time span format, empty string is created.
+	*/
+	char* timeSpanToArray(char* buffer, size_t bufferSize, int64_t value) const;
+
+private:
+#if DT_STATIC_FORMAT != 0
+	template<auto Format>
+	friend struct dtlib::StaticFormat;
+#endif // DT_STATIC_FORMAT != 0
+
+	/**
+	* @brief Operation codes.
+	*/
+	enum OpCode : uint8_t {
+		//Operation codes of date and time format
+		OP_TEXT = 0,			//Text, arg is length of text
+		OP_DAY = 1,				//Day of month, arg is strict width flag
+		OP_DAY_NAME3 = 2,		//First 3 letters of day of week name
+		OP_DAY_NAME = 3,		//Full day of week name
+		OP_MONTH = 4,			//Month, arg is strict width flag
+		OP_MONTH_NAME3 = 5,		//First 3 letters of month name
+		OP_MONTH_NAME = 6,		//Full month name
+		OP_YEAR2 = 7,			//Last 2 digits of year, arg is strict width flag
+		OP_YEAR = 8,			//Year, arg is width
+		OP_HOUR12 = 9,			//Hours in 12-hour format, arg is strict width flag
+		OP_HOUR24 = 10,			//Hours in 24-hour format, arg is strict width flag
+		OP_MINUTE = 11,			//Minutes, arg is strict width flag
+		OP_SECOND = 12,			//Seconds, arg is strict width flag
+		OP_FRACT = 13,			//Fraction of second without trailing zeros, arg is width
+		OP_FRACT_STRICT = 14,	//Fraction of second, arg is width
+		OP_MILLIS = 15,			//Milliseconds, arg is width
+		OP_MICROS = 16,			//Microseconds, arg is width
+		OP_AM_PM = 17,			//AM/PM designator, arg is count of letters
+		OP_ERA = 18,			//B.C. or A.D., arg is true if A.D. is shown too
+		OP_SIGN = 19,			//Sign of year or time span, arg is true if + is shown too
+		OP_TZ = 20,				//Time zone offset, arg is option of dtlib::tzToStr()
+		OP_TZ_DST = 21,			//Time zone and DST offset, arg is option of dtlib::tzToStr()
+		OP_DST = 22,			//DST offset, arg is option of dtlib::tzToStr()
+
+		//Operation codes of time span format
+		OP_TS_DAYS = 32,		//Days, arg is width
+		OP_TS_HOURS = 33,		//Hours, arg is strict width flag
+		OP_TS_MINUTES = 34,		//Minutes, arg is strict width flag
+		OP_TS_SECONDS = 35,		//Seconds, arg is strict width flag
+	};
+
+	struct format_op_s {
+		uint8_t code = OP_TEXT;	//Operation code
+		uint8_t arg = 0;		//Width, option or length of text
+	};
+
+	/**
+	* @brief Gets length of the longest name.
+	*/
+	static DT_CONSTEXPR14 size_t getMaxNameLength(const char* const* names, uint8_t count) {
+		size_t ret = 0;
+		for (uint8_t i = 0; i < count; i++) {
+			size_t len = 0;
+			while (names[i][len] != '\0') len++;
+			if (len > ret) ret = len;
+		}
+		return ret;
+	}
+
+	DT_CONSTEXPR14 void setError(FormatError err, int position) {
+		if (error == FORMAT_OK) {
+			error = err;
+			errorPosition = (uint16_t)position;
+		}
+	}
+
+	DT_CONSTEXPR14 void addOp(uint8_t code, uint8_t arg, size_t length, int position) {
+		if (opsCount >= DT_FORMAT_MAX_OPS) {
+			setError(FORMAT_TOO_MANY_OPS, position);
+			return;
+		}
+		if (maxLength + length > DT_FORMAT_MAX_LENGTH) {
+			setError(FORMAT_OUTPUT_TOO_LONG, position);
+			return;
+		}
+		ops[opsCount].code = code;
+		ops[opsCount].arg = arg;
+		opsCount++;
+		maxLength += (uint16_t)length;
+	}
+
+	DT_CONSTEXPR14 void addText(char c, int count, int position) {
+		if (textLength + count > DT_FORMAT_MAX_TEXT) {
+			setError(FORMAT_TEXT_TOO_LONG, position);
+			return;
+		}
+
+		if (opsCount == 0 || ops[opsCount - 1].code != OP_TEXT || ops[opsCount - 1].arg + count > UINT8_MAX) {
+			//Text cannot be appended to previous operation
+			addOp(OP_TEXT, 0, 0, position);
+			if (error != FORMAT_OK) return;
+		}
+		if (maxLength + count > DT_FORMAT_MAX_LENGTH) {
+			setError(FORMAT_OUTPUT_TOO_LONG, position);
+			return;
+		}
+
+		ops[opsCount - 1].arg += (uint8_t)count;
+		maxLength += (uint16_t)count;
+		for (; count > 0; count--) {
+			text[textLength++] = c;
+		}
+	}
+
+	DT_CONSTEXPR14 bool compileSpecifier(char specifier, int count, int position) {
+		if (target == TARGET_TIME_SPAN) {
+			switch (specifier) {
+			case 'd': {	//days
+				uint8_t width = (count == 1) ? 0 : (uint8_t)count;
+				addOp(OP_TS_DAYS, width, width == 0 ? 9 : width, position);
+				return true;
+			}
+			case 'f': //Fraction of seconds
+			case 'F': {
+				uint8_t width = (count == 1) ? 0 : (uint8_t)count;
+				addOp(specifier == 'f' ? OP_FRACT_STRICT : OP_FRACT, width, width, position);
+				return true;
+			}
+			case 'h': //hours
+			case 'm': //minutes
+			case 's': //seconds
+				if (count > 2) {
+					setError(FORMAT_INVALID_COUNT, position);
+				}
+				else {
+					uint8_t code = (specifier == 'h') ? OP_TS_HOURS : ((specifier == 'm') ? OP_TS_MINUTES : OP_TS_SECONDS);
+					addOp(code, count > 1, 2, position);
+				}
+				return true;
+			case 'i': //milliseconds
+			case 'u': {	//microseconds
+				uint8_t width = (count == 1) ? 0 : (uint8_t)count;
+				addOp(specifier == 'i' ? OP_MILLIS : OP_MICROS, width, width == 0 ? 3 : width, position);
+				return true;
+			}
+			case 'N':
+			case 'n': // Sign
+				addOp(OP_SIGN, specifier == 'n', 1, position);
+				return true;
+			default:
+				return false;
+			}
+		}
+
+		switch (specifier) {
+		case 'd': //day or day of week
+			needsDate = true;
+			if (count <= 2) {
+				addOp(OP_DAY, count > 1, 2, position);
+			}
+			else if (count == 3) {
+				addOp(OP_DAY_NAME3, 0, 3, position);
+			}
+			else if (count == 4) {
+				addOp(OP_DAY_NAME, 0, getMaxNameLength(weekDayNames, 7), position);
+			}
+			else {
+				setError(FORMAT_INVALID_COUNT, position);
+			}
+			return true;
+
+		case 'M': //month
+			needsDate = true;
+			if (count <= 2) {
+				addOp(OP_MONTH, count > 1, 2, position);
+			}
+			else if (count == 3) {
+				addOp(OP_MONTH_NAME3, 0, 3, position);
+			}
+			else if (count == 4) {
+				addOp(OP_MONTH_NAME, 0, getMaxNameLength(monthNames, 12), position);
+			}
+			else {
+				setError(FORMAT_INVALID_COUNT, position);
+			}
+			return true;
+
+		case 'y': //year
+			needsDate = true;
+			if (count <= 2) {
+				addOp(OP_YEAR2, count > 1, 2, position);
+			}
+			else {
+				addOp(OP_YEAR, (uint8_t)count, count, position);
+			}
+			return true;
+
+		case 'f': //Fraction
+		case 'F': {
+			needsTime = true;
+			uint8_t width = (count == 1) ? 0 : (uint8_t)count;
+			addOp(specifier == 'f' ? OP_FRACT_STRICT : OP_FRACT, width, width, position);
+			return true;
+		}
+
+		case 'h': //12-hour format
+		case 'H': //24-hour format
+		case 'm': //minutes
+		case 's': //seconds
+			needsTime = true;
+			if (count > 2) {
+				setError(FORMAT_INVALID_COUNT, position);
+			}
+			else {
+				uint8_t code = (specifier == 'h') ? OP_HOUR12 : ((specifier == 'H') ? OP_HOUR24 : ((specifier == 'm') ? OP_MINUTE : OP_SECOND));
+				addOp(code, count > 1, 2, position);
+			}
+			return true;
+
+		case 'i': //milliseconds
+		case 'u': {	//microseconds
+			needsTime = true;
+			uint8_t width = (count == 1) ? 0 : (uint8_t)count;
+			addOp(specifier == 'i' ? OP_MILLIS : OP_MICROS, width, width == 0 ? 3 : width, position);
+			return true;
+		}
+
+		case 't': //AM/PM
+			needsTime = true;
+			if (count > 2) {
+				setError(FORMAT_INVALID_COUNT, position);
+			}
+			else {
+				addOp(OP_AM_PM, (uint8_t)count, count, position);
+			}
+			return true;
+
+		case 'G':
+		case 'g': // B.C. or A.C.
+			addOp(OP_ERA, specifier == 'g', 4, position);
+			return true;
+
+		case 'N':
+		case 'n': // B.C. or A.C. represented by sign
+			addOp(OP_SIGN, specifier == 'n', 1, position);
+			return true;
+
+		case 'z': //Time zone offset
+		case 'Z': //Time zone and DST offset
+		case 'l': //DTS offset
+			if (count > 4) {
+				setError(FORMAT_INVALID_COUNT, position);
+			}
+			else {
+				uint8_t code = (specifier == 'z') ? OP_TZ : ((specifier == 'Z') ? OP_TZ_DST : OP_DST);
+				addOp(code, (uint8_t)count, count <= 2 ? 3 : (count == 3 ? 6 : 5), position);
+			}
+			return true;
+
+		default:
+			return false;
+		}
+	}
+
+	DT_CONSTEXPR14 void compile(const char* format) {
+		if (format == NULL || format[0] == '\0') return;
+
+		//Format is scanned exactly like in dtlib::dateTimeToArray() and TimeSpan::toArray()
+		char lastChar = format[0];
+		int sameCnt = 1;
+
+		int i = 1;
+		bool escape = false;
+		bool isText = false;
+		bool doubleQ = false;
+		int escapePos = 0;
+		int textPos = 0;
+		do {
+			char c = format[i];
+			if (lastChar == c) {
+				//Same character found
+				sameCnt++;
+			}
+			else {
+				//New character found
+				int position = i - sameCnt;
+				if (sameCnt > DT_FORMAT_MAX_SAME_COUNT) {
+					setError(FORMAT_INVALID_COUNT, position);
+					break;
+				}
+
+				bool handled = false;
+				if (escape || isText) {
+					handled = false;
+					bool curentIsDQ = lastChar == '"';
+					if (!escape && isText && (lastChar == '\'' || curentIsDQ)) {
+						isText = !(curentIsDQ == doubleQ);
+						handled = !isText;
+					}
+					escape = !escape && lastChar == '\\';
+					if (escape) {
+						handled = escape;
+						escapePos = position;
+					}
+				}
+				else {
+					handled = true;
+					switch (lastChar) {
+					case '\\':
+						escape = true;
+						escapePos = position;
+						break;
+
+					case '\'': //Text mark
+						isText = !(isText && !doubleQ);
+						doubleQ = false;
+						textPos = position;
+						break;
+
+					case '"': //Text mark
+						isText = !(isText && !doubleQ);
+						doubleQ = true;
+						textPos = position;
+						break;
+
+					default:
+						handled = compileSpecifier(lastChar, sameCnt, position);
+						break;
+					}
+				}
+
+				if (!handled) {
+					addText(lastChar, sameCnt, position);
+				}
+				if (error != FORMAT_OK) break;
+
+				sameCnt = 1;
+				lastChar = c;
+			}
+			i++;
+		} while (lastChar != '\0');
+
+		if (escape) {
+			setError(FORMAT_DANGLING_ESCAPE, escapePos);
+		}
+		else if (isText) {
+			setError(FORMAT_UNCLOSED_TEXT, textPos);
+		}
+	}
+
+	format_op_s ops[DT_FORMAT_MAX_OPS] = {};
+	char text[DT_FORMAT_MAX_TEXT] = {};
+	const char* const* monthNames = NULL;
+	const char* const* weekDayNames = NULL;
+	uint16_t errorPosition = 0;
+	uint16_t maxLength = 0;
+	uint8_t opsCount = 0;
+	uint8_t textLength = 0;
+	FormatTarget target = TARGET_DATE_TIME;
+	FormatError error = FORMAT_OK;
+	bool needsDate = false;
+	bool needsTime = false;
+};
+
+#if DT_STATIC_FORMAT != 0
+namespace dtlib {
+
+#if DT_FORMAT_STRING_LITERAL != 0
+	/**
+	* @struct FormatString
+	* @brief String literal, which can be used as template argument of DateTimeRawBase::format().
+	*/
+	template<size_t N>
+	struct FormatString {
+		constexpr FormatString(const char(&str)[N]) {
+			for (size_t i = 0; i < N; i++) {
+				value[i] = str[i];
+			}
+		}
+
+		char value[N] = {};
+	};
+
+	template<size_t N>
+	constexpr const char* getFormatString(const FormatString<N>& format) {
+		return format.value;
+	}
+#endif // DT_FORMAT_STRING_LITERAL != 0
+
+	constexpr const char* getFormatString(const char* format) {
+		return format;
+	}
+
+	/**
+	* @struct StaticFormat
+	* @brief Date and time format, which is known at compile time. Format is compiled by compiler,
+	* so writer of each format is generated as straight sequence of digit and text stores.
+	* Result is the same as result of dtlib::dateTimeToArray() with the same format.
+	*/
+	template<auto Format>
+	struct StaticFormat {
+		static constexpr DateTimeFormat format = DateTimeFormat(getFormatString(Format));
+		static_assert(format.isValid(), "Invalid date and time format");
+
+		/**
+		* @brief Converts raw date and time value to string.
+		* @param buffer Buffer, where string will be written.
+		* @param bufferSize Size of buffer including null terminator.
+		* @param value Raw date and time value (microseconds since 1.1.0001).
+		* @param timeZoneOffset Time zone offset in minutes.
+		* @param DSTOffset DST offset in minutes.
+		* @return Returns pointer to buffer, where null terminator was inserted.
+		*/
+		static char* toArray(char* buffer, size_t bufferSize, int64_t value, int16_t timeZoneOffset, int16_t DSTOffset) {
+			if (bufferSize <= format.maxLength) {
+				//Buffer could be too small, so length has to be checked after each operation
+				return format.toArray(buffer, bufferSize, value, timeZoneOffset, DSTOffset);
+			}
+
+			date_s ds;
+			time_s ts;
+			CONSTEXPR_IF (format.needsDate) ds = rawToDate(value);
+			CONSTEXPR_IF (format.needsTime) ts = rawToTime(value);
+
+			buffer = write<0, 0>(buffer, value, ds, ts, timeZoneOffset, DSTOffset);
+			buffer[0] = '\0';
+			return buffer; //Returns position of the null terminator
+		}
+
+	private:
+		/**
+		* @brief Writes exactly W digits, result is the same as result of intToStr() with width W.
+		*/
+		template<uint8_t W>
+		static inline char* writeDigits(char* buffer, uint32_t val) {
+			for (int i = W - 1; i >= 0; i--) {
+				buffer[i] = (char)('0' + val % 10);
+				val /= 10;
+			}
+			return buffer + W;
+		}
+
+		/**
+		* @brief Writes 1 or 2 digits, result is the same as result of intToStr2().
+		*/
+		template<bool strictWidth>
+		static inline char* writeDigits2(char* buffer, uint32_t val) {
+			CONSTEXPR_IF (!strictWidth) {
+				if ((val / 10) % 10 == 0) {
+					buffer[0] = (char)('0' + val % 10);
+					return buffer + 1;
+				}
+			}
+			return writeDigits<2>(buffer, val);
+		}
+
+		/**
+		* @brief Writes time zone or DST offset, result is the same as result of tzToStr().
+		*/
+		template<uint8_t options>
+		static inline char* writeOffset(char* buffer, int16_t val) {
+			int8_t ho = val / 60;
+			int8_t mins = val % 60;
+			if (val < 0) {
+				buffer[0] = '-';
+				ho = -ho; //Absolute value
+				mins = -mins;
+			}
+			else {
+				buffer[0] = '+';
+			}
+			buffer = writeDigits2<(options > 1)>(buffer + 1, ho);
+			CONSTEXPR_IF (options >= 3) {
+				CONSTEXPR_IF (options == 3) {
+					buffer[0] = ':';
+					buffer++;
+				}
+				buffer = writeDigits<2>(buffer, mins);
+			}
+			return buffer;
+		}
+
+		/**
+		* @brief Writes fraction of second with strict width, result is the same as result of ms_usFractToStr().
+		*/
+		template<uint8_t W>
+		static inline char* writeFraction(char* buffer, uint32_t microseconds) {
+			constexpr uint8_t cnt = (W > 6) ? 6 : W;
+			CONSTEXPR_IF (cnt < 6) {
+				uint32_t div = 1;
+				for (uint8_t i = cnt; i < 5; i++) div *= 10;
+				microseconds /= div;
+				//Rounding
+				uint8_t lastDigit = microseconds % 10;
+				microseconds /= 10;
+				if (lastDigit >= 5) {
+					microseconds++;
+				}
+			}
+			buffer = writeDigits<cnt>(buffer, microseconds);
+			for (uint8_t i = cnt; i < W; i++) {
+				*buffer++ = '0';
+			}
+			return buffer;
+		}
+
+		/**
+		* @brief Writes operation I and all following operations.
+		* @tparam I Index of operation.
+		* @tparam T Position of text of operation I in text buffer.
+		*/
+		template<uint8_t I, uint8_t T>
+		static inline char* write(char* buffer, int64_t value, const date_s& ds, const time_s& ts, int16_t timeZoneOffset, int16_t DSTOffset) {
+			CONSTEXPR_IF (I >= format.opsCount) {
+				return buffer;
+			}
+			else {
+				constexpr uint8_t code = format.ops[I].code;
+				constexpr uint8_t arg = format.ops[I].arg;
+
+				CONSTEXPR_IF (code == DateTimeFormat::OP_TEXT) {
+					memcpy(buffer, format.text + T, arg);
+					buffer += arg;
+				}
+				else CONSTEXPR_IF (code == DateTimeFormat::OP_DAY) {
+					buffer = writeDigits2<arg != 0>(buffer, ds.day);
+				}
+				else CONSTEXPR_IF (code == DateTimeFormat::OP_DAY_NAME3) {
+					memcpy(buffer, dt_day_names[ds.dayOfWeek - 1], 3);
+					buffer += 3;
+				}
+				else CONSTEXPR_IF (code == DateTimeFormat::OP_DAY_NAME) {
+					size_t len = strlen(dt_day_names[ds.dayOfWeek - 1]);
+					memcpy(buffer, dt_day_names[ds.dayOfWeek - 1], len);
+					buffer += len;
+				}
+				else CONSTEXPR_IF (code == DateTimeFormat::OP_MONTH) {
+					buffer = writeDigits2<arg != 0>(buffer, ds.month);
+				}
+				else CONSTEXPR_IF (code == DateTimeFormat::OP_MONTH_NAME3) {
+					memcpy(buffer, dt_month_names[ds.month - 1], 3);
+					buffer += 3;
+				}
+				else CONSTEXPR_IF (code == DateTimeFormat::OP_MONTH_NAME) {
+					size_t len = strlen(dt_month_names[ds.month - 1]);
+					memcpy(buffer, dt_month_names[ds.month - 1], len);
+					buffer += len;
+				}
+				else CONSTEXPR_IF (code == DateTimeFormat::OP_YEAR2 || code == DateTimeFormat::OP_YEAR) {
+					uint32_t year;
+					if (ds.year < 0) year = -ds.year; //Absolute value of year
+					else year = ds.year;
+					CONSTEXPR_IF (code == DateTimeFormat::OP_YEAR2) {
+						buffer = writeDigits2<arg != 0>(buffer, year);
+					}
+					else {
+						buffer = writeDigits<arg>(buffer, year);
+					}
+				}
+				else CONSTEXPR_IF (code == DateTimeFormat::OP_HOUR12) {
+					hour_t hours = ts.hours;
+					hours.convertTo12();
+					buffer = writeDigits2<arg != 0>(buffer, hours);
+				}
+				else CONSTEXPR_IF (code == DateTimeFormat::OP_HOUR24) {
+					buffer = writeDigits2<arg != 0>(buffer, ts.hours);
+				}
+				else CONSTEXPR_IF (code == DateTimeFormat::OP_MINUTE) {
+					buffer = writeDigits2<arg != 0>(buffer, ts.minutes);
+				}
+				else CONSTEXPR_IF (code == DateTimeFormat::OP_SECOND) {
+					buffer = writeDigits2<arg != 0>(buffer, ts.seconds);
+				}
+				else CONSTEXPR_IF (code == DateTimeFormat::OP_FRACT) {
+					uint32_t fraction = ((uint32_t)ts.milliseconds) * MILLISECOND + ts.microseconds;
+					buffer = ms_usFractToStr(buffer, arg, fraction, arg, false);
+				}
+				else CONSTEXPR_IF (code == DateTimeFormat::OP_FRACT_STRICT) {
+					uint32_t fraction = ((uint32_t)ts.milliseconds) * MILLISECOND + ts.microseconds;
+					buffer = writeFraction<arg>(buffer, fraction);
+				}
+				else CONSTEXPR_IF (code == DateTimeFormat::OP_MILLIS || code == DateTimeFormat::OP_MICROS) {
+					uint32_t val = (code == DateTimeFormat::OP_MILLIS) ? ts.milliseconds : ts.microseconds;
+					CONSTEXPR_IF (arg == 0) {
+						buffer = intToStr(buffer, 3, val, 0);
+					}
+					else {
+						buffer = writeDigits<arg>(buffer, val);
+					}
+				}
+				else CONSTEXPR_IF (code == DateTimeFormat::OP_AM_PM) {
+					buffer[0] = (ts.hours.isAM()) ? 'A' : 'P';
+					CONSTEXPR_IF (arg > 1) {
+						buffer[1] = 'M';
+					}
+					buffer += arg;
+				}
+				else CONSTEXPR_IF (code == DateTimeFormat::OP_ERA) {
+					if (arg || value < 0) {
+						memcpy(buffer, (value < 0) ? "B.C." : "A.D.", 4);
+						buffer += 4;
+					}
+				}
+				else CONSTEXPR_IF (code == DateTimeFormat::OP_SIGN) {
+					if (arg || value < 0) {
+						buffer[0] = (value < 0) ? '-' : '+';
+						buffer++;
+					}
+				}
+				else CONSTEXPR_IF (code == DateTimeFormat::OP_TZ) {
+					buffer = writeOffset<arg>(buffer, timeZoneOffset);
+				}
+				else CONSTEXPR_IF (code == DateTimeFormat::OP_TZ_DST) {
+					buffer = writeOffset<arg>(buffer, timeZoneOffset + DSTOffset);
+				}
+				else CONSTEXPR_IF (code == DateTimeFormat::OP_DST) {
+					buffer = writeOffset<arg>(buffer, DSTOffset);
+				}
+
+				return write<I + 1, (code == DateTimeFormat::OP_TEXT) ? T + arg : T>(buffer, value, ds, ts, timeZoneOffset, DSTOffset);
+			}
+		}
+	};
+}
+#endif // DT_STATIC_FORMAT != 0
+
+#endif // !_DATE_TIME_FORMAT_H
@@ -6,674 +6,130 @@
 #endif // !ARDUINO
 
 #if DT_UNDER_OS > 0
+#include <mutex>
+#if DT_SYNC_TSC_X86 != 0 && !defined(_MSC_VER)
+#include <cpuid.h>
+#endif // DT_SYNC_TSC_X86 != 0 && !defined(_MSC_VER)
+
 int64_t getSysTicks() {
 	return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::time_point_cast<std::chrono::microseconds>(std::chrono::system_clock::now()).time_since_epoch()).count();
 }
-#endif // DT_UNDER_OS > 0
-
-uint8_t Month::getMonthLength(Month month, bool leapYear) {
-	return month.getMonthLength(leapYear);
-}
-
-uint8_t Month::getMonthLength(bool leapYear) const{
-	uint8_t val = value - 1; //Move to 0 index
-	if (val < 12) {
-		static const uint8_t monthLengths[] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
-		if (leapYear && val == 1) {
-			return 29;
-		}
-		else {
-			return monthLengths[val];
-		}
-	}
-	else {
-		return 0;
-	}
-}
 
 namespace dtlib {
-	date_time_s rawToDateTime(int64_t raw) {
-		date_time_s time;
-
-		int32_t days;
-		int64_t micr; //Remaining microseconds
-		//calculate days from microseconds
-		bool neg = raw < 0;
-		if (neg) {
-			raw++;
-			days = (int32_t)((raw / DAY) - 1);
-			micr = DAY + (raw % DAY) - 1;
-		}
-		else {
-			days = (int32_t)(raw / DAY);
-			micr = raw % DAY;
-		}
-
-		//Time calculation
-		time.hours.setHours24((uint8_t)(micr / HOUR));
-		micr = micr % HOUR;
-		time.minutes = (uint8_t)(micr / MINUTE);
-		int32_t micr32 = micr % MINUTE; //Using micr32 as int32_t to calculate using 32 bit arithmetic
-		time.seconds = (uint8_t)(micr32 / SECOND);
-		micr32 = micr32 % SECOND;
-		time.milliseconds = (uint16_t)(micr32 / MILLISECOND);
-		micr32 = micr32 % MILLISECOND;
-		time.microseconds = micr32;
-
-		//Date calculation
-		year_day_tuple yd = getYearFromDays(days);
-		month_day_tuple md = getMonthFromDayOfYear(yd.dayOfYear, isLeapYear(yd.year));
-		time.year = yd.year;
-		time.month = md.month;
-		time.day = md.day;
-		if (neg) {
-			//BC
-			time.dayOfWeek = (DayOfWeek)(7 + ((days - 5) % 7));
-		}
-		else {
-			//AD
-			time.dayOfWeek = (DayOfWeek)(((days + 1) % 7) + 1);
-		}
-		return time;
-	}
-
-	int64_t dateTimeToRaw(date_time_s time) {
-		//Time calculation
-		int32_t raw32 = time.microseconds * MICROSECOND;
-		raw32 += time.milliseconds * MILLISECOND;
-		raw32 += time.seconds * SECOND;
-		int64_t raw = time.minutes * MINUTE;
-		time.hours.convertTo24(); //Converting to 24 hour format.
-		raw += time.hours * HOUR;
-		raw += raw32;
-
-		//Date calculation
-		int32_t days = (time.day - 1);
-		days += getDayOfYearFromMonth(time.month, isLeapYear(time.year));
-		days += getDaysUntilYear(time.year);
-		raw += days * DAY;
-
-		return raw;
-	}
-
-
-	date_s rawToDate(int64_t raw) {
-		date_s date;
-
-		int32_t days;
-		bool neg = raw < 0;
-		if (neg) {
-			raw++;
-			days = (int32_t)((raw / DAY) - 1);
-		}
-		else {
-			days = (int32_t)(raw / DAY);
-		}
+	SyncClockTSC::tsc_anchor_s SyncClockTSC::anchor;
 
-		//Date calculation
-		year_day_tuple yd = getYearFromDays(days);
-		month_day_tuple md = getMonthFromDayOfYear(yd.dayOfYear, isLeapYear(yd.year));
-		date.year = yd.year;
-		date.month = md.month;
-		date.day = md.day;
-		if (neg) {
-			//BC
-			date.dayOfWeek = (DayOfWeek)(7 + ((days - 5) % 7));
-		}
-		else {
-			//AD
-			date.dayOfWeek = (DayOfWeek)(((days + 1) % 7) + 1);
-		}
-		return date;
-	}
-
-	//TODO tests
-	int64_t dateToRaw(date_s date) {
-		//Date calculation
-		int32_t days = (date.day - 1);
-		days += getDayOfYearFromMonth(date.month, isLeapYear(date.year));
-		days += getDaysUntilYear(date.year);
-		return ((int64_t)days) * DAY;
-	}
-
-	//TODO tests
-	void setDateToRaw(int64_t& raw, date_s date) {
-		int64_t rem_micr = getMicrosOfDayFromRaw(raw);
-
-		int32_t days = (date.day - 1);
-		days += getDayOfYearFromMonth(date.month, isLeapYear(date.year));
-		days += getDaysUntilYear(date.year);
-
-		raw = rem_micr + ((int64_t)days) * DAY;
-	}
-
-	time_s rawToTime(int64_t raw) {
-		time_s time;
-
-		int64_t micr; //Remaining microseconds
-		//calculate days from microseconds
-		bool neg = raw < 0;
-		if (neg) {
-			raw++;
-			micr = DAY + (raw % DAY) - 1;
-		}
-		else {
-			micr = raw % DAY;
-		}
-
-		//Time calculation
-		time.hours.setHours24((uint8_t)(micr / HOUR));
-		micr = micr % HOUR;
-		time.minutes = (uint8_t)(micr / MINUTE);
-		int32_t micr32 = micr % MINUTE; //Using micr32 as int32_t to calculate using 32 bit arithmetic
-		time.seconds = (uint8_t)(micr32 / SECOND);
-		micr32 = micr32 % SECOND;
-		time.milliseconds = (uint16_t)(micr32 / MILLISECOND);
-		micr32 = micr32 % MILLISECOND;
-		time.microseconds = micr32;
-
-		return time;
-	}
-
-	//TODO tests
-	int64_t timeToRaw(time_s time) {
-		int32_t raw32 = time.microseconds * MICROSECOND;
-		raw32 += time.milliseconds * MILLISECOND;
-		raw32 += time.seconds * SECOND;
-		int64_t raw = time.minutes * MINUTE;
-		time.hours.convertTo24(); //Converting to 24 hour format
-		raw += time.hours * HOUR;
-		raw += raw32;
-		return raw;
-	}
-
-	//TODO tests
-	void setTimeToRaw(int64_t& raw, time_s time) {
-		raw -= getMicrosOfDayFromRaw(raw); //Setting microseconds of year to 0
-
-		//Calculating new microseconds of year
-		int32_t raw32 = time.microseconds * MICROSECOND;
-		raw32 += time.milliseconds * MILLISECOND;
-		raw32 += time.seconds * SECOND;
-		raw += time.minutes * MINUTE;
-		time.hours.convertTo24(); //Converting to 24 hour format
-		raw += time.hours * HOUR;
-		raw += raw32;
-	}
-
-
-
-	hour_t getHoursFromRaw(int64_t raw) {
-		int64_t micr; //Remaining microseconds
-		bool neg = raw < 0;
-		if (neg) {
-			raw++;
-			micr = DAY + (raw % DAY) - 1;
-		}
-		else {
-			micr = raw % DAY;
-		}
-
-		return hour_t((uint8_t)(micr / HOUR));
-	}
-
-	void setHoursToRaw(int64_t& raw, hour_t val) {
-		/*bool neg = raw < 0;
-		if (neg) {
-			int64_t rem1 = (raw + 1) % DAY - 1;
-			int64_t rem2 = (raw + 1) % HOUR - 1;
-			raw = raw - rem1 + rem2 - (DAY - (int64_t)val * HOUR - HOUR);
-		}
-		else {
-			int64_t rem1 = raw % DAY;
-			int64_t rem2 = raw % HOUR;
-			raw = raw - rem1 + rem2 + ((int64_t)val * HOUR);
-		}*/
-
-		int64_t micr; //Remaining microseconds
-		bool neg = raw < 0;
-		if (neg) {
-			micr = DAY + ((raw + 1) % DAY) - 1;
-		}
-		else {
-			micr = raw % DAY;
-		}
-		int8_t hours = (int8_t)(micr / HOUR);
-		val.convertTo24(); //Converting to 24 hour format
-		raw -= ((int64_t)(hours - (int8_t)val)) * HOUR;
-	}
-
-	uint8_t getMinutesFromRaw(int64_t raw) {
-		int64_t micr; //Remaining microseconds
-		bool neg = raw < 0;
-		if (neg) {
-			raw++;
-			micr = HOUR + (raw % HOUR) - 1;
-		}
-		else {
-			micr = raw % HOUR;
-		}
-
-		return (uint8_t)(micr / MINUTE);
-	}
-
-	void setMinutesToRaw(int64_t& raw, uint8_t val) {
-		/*/bool neg = raw < 0;
-		if (neg) {
-			int64_t rem1 = (raw + 1) % HOUR - 1;
-			int64_t rem2 = (raw + 1) % MINUTE - 1;
-			raw = raw - rem1 + rem2 - (HOUR - (int64_t)val * MINUTE - MINUTE);
-		}
-		else {
-			int64_t rem1 = raw % HOUR;
-			int64_t rem2 = raw % MINUTE;
-			raw = raw - rem1 + rem2 + ((int64_t)val * MINUTE);
-		}*/
-
-		int64_t micr; //Remaining microseconds
-		bool neg = raw < 0;
-		if (neg) {
-			micr = HOUR + ((raw + 1) % HOUR) - 1;
-		}
-		else {
-			micr = raw % HOUR;
-		}
-		int8_t min = (int8_t)(micr / MINUTE);
-		raw -= ((int64_t)(min - (int8_t)val)) * MINUTE;
-	}
-
-	uint8_t getSecondsFromRaw(int64_t raw) {
-		int32_t micr; //Remaining microseconds
-		bool neg = raw < 0;
-		if (neg) {
-			raw++;
-			micr = MINUTE + (raw % MINUTE) - 1;
-		}
-		else {
-			micr = raw % MINUTE;
-		}
-
-		return (uint8_t)(micr / SECOND);
-	}
-
-	void setSecondsToRaw(int64_t& raw, uint8_t val) {
-		/*bool neg = raw < 0;
-		if (neg) {
-			int64_t rem1 = (raw + 1) % MINUTE - 1;
-			int64_t rem2 = (raw + 1) % SECOND - 1;
-			raw = raw - rem1 + rem2 - (MINUTE - (int32_t)val * SECOND - SECOND);
-		}
-		else {
-			int64_t rem1 = raw % MINUTE;
-			int64_t rem2 = raw % SECOND;
-			raw = raw - rem1 + rem2 + ((int32_t)val * SECOND);
-		}*/
-
-		int64_t micr; //Remaining microseconds
-		bool neg = raw < 0;
-		if (neg) {
-			micr = MINUTE + ((raw + 1) % MINUTE) - 1;
-		}
-		else {
-			micr = raw % MINUTE;
-		}
-		int8_t sec = (int8_t)(micr / SECOND);
-		raw -= ((int64_t)(sec - (int8_t)val)) * SECOND;
-	}
-
-	uint16_t getMillisFromRaw(int64_t raw) {
-		int32_t micr; //Remaining microseconds
-		bool neg = raw < 0;
-		if (neg) {
-			raw++;
-			micr = SECOND + (raw % SECOND) - 1;
-		}
-		else {
-			micr = raw % SECOND;
-		}
-
-		return (uint16_t)(micr / MILLISECOND);
-	}
-
-	void setMillisToRaw(int64_t& raw, uint16_t val) {
-		/*bool neg = raw < 0;
-		if (neg) {
-			int64_t rem1 = (raw + 1) % SECOND - 1;
-			int64_t rem2 = (raw + 1) % MILLISECOND - 1;
-			raw = raw - rem1 + rem2 - (SECOND - (int32_t)val * MILLISECOND - MILLISECOND);
-		}
-		else {
-			int64_t rem1 = raw % SECOND;
-			int64_t rem2 = raw % MILLISECOND;
-			raw = raw - rem1 + rem2 + ((int32_t)val * MILLISECOND);
-		}*/
-
-		int64_t micr; //Remaining microseconds
-		bool neg = raw < 0;
-		if (neg) {
-			micr = SECOND + ((raw + 1) % SECOND) - 1;
-		}
-		else {
-			micr = raw % SECOND;
-		}
-		int16_t mils = (int16_t)(micr / MILLISECOND);
-		raw -= ((int64_t)(mils - (int16_t)val)) * MILLISECOND;
-	}
-
-	uint16_t getMicrosFromRaw(int64_t raw) {
-		int32_t micr; //Remaining microseconds
-		bool neg = raw < 0;
-		if (neg) {
-			raw++;
-			micr = MILLISECOND + (raw % MILLISECOND) - 1;
-		}
-		else {
-			micr = raw % MILLISECOND;
-		}
-
-		return micr / MICROSECOND;
-	}
-
-	void setMicrosToRaw(int64_t& raw, uint16_t val) {
-		bool neg = raw < 0;
-		if (neg) {
-			int64_t rem1 = (raw + 1) % MILLISECOND - 1;
-			raw = raw - rem1 - (MILLISECOND - val);
-		}
-		else {
-			int64_t rem1 = raw % MILLISECOND;
-			raw = raw - rem1 + val;
-		}
-	}
-
-
-	int32_t getDaysFromRaw(int64_t raw) {
-		int32_t days;
-		bool neg = raw < 0;
-		if (neg) {
-			days = (int32_t)(((raw + 1) / DAY) - 1);
-		}
-		else {
-			days = (int32_t)(raw / DAY);
-		}
-		return days;
-	}
-
-	void setDaysToRaw(int64_t& raw, int32_t val) {
-		bool neg = raw < 0;
-		int64_t rem1;
-		if (neg) {
-			rem1 = (raw + 1) % DAY - 1;
-			raw = rem1 + ((int64_t)val) * DAY + DAY;
-		}
-		else {
-			rem1 = raw % DAY;
-			raw = rem1 + ((int64_t)val) * DAY;
-		}
-	}
-
-	int64_t getMicrosOfDayFromRaw(int64_t raw) {
-		int64_t micr;
-		bool neg = raw < 0;
-		if (neg) {
-			micr = DAY + ((raw + 1) % DAY) - 1;
-		}
-		else {
-			micr = raw % DAY;
-		}
-		return micr;
+#if DT_SYNC_TSC_X86 != 0
+	/**
+	* @brief Checks if time stamp counter has constant rate in all power states (CPUID 80000007H, EDX bit 8).
+	*/
+	static bool isTSCInvariant() {
+#ifdef _MSC_VER
+		int info[4];
+		__cpuid(info, 0x80000000);
+		if ((unsigned int)info[0] < 0x80000007U) return false;
+		__cpuid(info, 0x80000007);
+		return (info[3] & (1 << 8)) != 0;
+#else
+		unsigned int a, b, c, d;
+		if (!__get_cpuid(0x80000007U, &a, &b, &c, &d)) return false;
+		return (d & (1U << 8)) != 0;
+#endif // _MSC_VER
 	}
 
-	void setMicrosOfDayToRaw(int64_t& raw, int64_t val) {
-		int64_t micr;
-		bool neg = raw < 0;
-		if (neg) {
-			micr = DAY + ((raw + 1) % DAY) - 1;
-		}
-		else {
-			micr = raw % DAY;
+	/**
+	* @brief Reads counter and reference clock together. Counter value is taken from the middle of reading of reference clock.
+	* Reading is repeated and the shortest one is used, so thread preempted during reading does not shift anchor.
+	*/
+	static void readTSCPair(uint64_t& tsc, int64_t& micros) {
+		uint64_t bestWindow = UINT64_MAX;
+		for (uint8_t i = 0; i < 8; i++) {
+			uint64_t before = __rdtsc();
+			int64_t ref = DT_SYNC_CLOCK_DEFAULT::now();
+			uint64_t after = __rdtsc();
+			if (after - before < bestWindow) {
+				bestWindow = after - before;
+				tsc = before + (after - before) / 2;
+				micros = ref;
+			}
 		}
-		raw = raw - micr + val;
 	}
 
-
-
-	uint8_t getMonthDayFromRaw(int64_t raw) {
-		int32_t days = getDaysFromRaw(raw);
-
-		//Date calculation
-		year_day_tuple yd = getYearFromDays(days);
-		month_day_tuple md = getMonthFromDayOfYear(yd.dayOfYear, isLeapYear(yd.year));
-		return md.day;
+	static std::mutex& getTSCMutex() {
+		static std::mutex mutex;
+		return mutex;
 	}
+#endif // DT_SYNC_TSC_X86 != 0
 
-	void setMonthDayToRaw(int64_t& raw, uint8_t val) {
-		//Current values establishment
-		int32_t days = getDaysFromRaw(raw);
-		year_day_tuple yd = getYearFromDays(days);
-		bool isLeap = isLeapYear(yd.year);
-		month_day_tuple md = getMonthFromDayOfYear(yd.dayOfYear, isLeap);
-
-		//Maximum day limit
-		uint8_t maxDay = md.month.getMonthLength(isLeap);
-		if (val > maxDay) val = maxDay;
-		else if (val < 1) val = 1;
-
-		//Days difference calculation
-		int8_t val_dif = (int8_t)md.day - (int8_t)val;
-
-		//Applying difference
-		raw -= (int64_t)val_dif * DAY;
-	}
-
-	Month getMonthFromRaw(int64_t raw) {
-		int32_t days = getDaysFromRaw(raw);
-		year_day_tuple yd = getYearFromDays(days);
-		month_day_tuple md = getMonthFromDayOfYear(yd.dayOfYear, isLeapYear(yd.year));
-		return md.month;
-	}
-
-	void setMonthToRaw(int64_t& raw, Month val) {
-		//Limits
-		if (val < 1) val = 1;
-		else if (val > 12) val = 12;
-
-		//Current values establishment
-		int32_t days = getDaysFromRaw(raw);
-		year_day_tuple yd = getYearFromDays(days);
-		bool isLeap = isLeapYear(yd.year);
-		month_day_tuple md = getMonthFromDayOfYear(yd.dayOfYear, isLeap);
-
-		//Maximum day limit
-		uint8_t maxDay = val.getMonthLength(isLeap);
-		if (md.day > maxDay) md.day = maxDay;
-
-		//Days difference calculation
-		int16_t newDayOfYear = getDayOfYearFromMonth(val, isLeap) + md.day - 1; //New day of year, which need to be set
-		int16_t oldDayOfYear = yd.dayOfYear; //Old day of year
-		int16_t dayDifference = oldDayOfYear - newDayOfYear;
-
-		raw -= (int64_t)dayDifference * DAY;
-	}
-
-	//TODO tests
-	void addMonthsToRaw(int64_t& raw, int32_t val) {
-		int32_t days;
-		int64_t micr; //Remaining microseconds
-		//calculate days from microseconds
-		bool neg = raw < 0;
-		if (neg) {
-			raw++;
-			days = (int32_t)((raw / DAY) - 1);
-			micr = DAY + (raw % DAY) - 1;
-		}
-		else {
-			days = (int32_t)(raw / DAY);
-			micr = raw % DAY;
-		}
-
-		//Date calculation
-		year_day_tuple yd = getYearFromDays(days);
-		month_day_tuple md = getMonthFromDayOfYear(yd.dayOfYear, isLeapYear(yd.year));
-		int32_t newMonthDiff = md.month - 1 + val;
-		int32_t yearDiff = newMonthDiff / 12;
-		newMonthDiff %= 12;
-		if (newMonthDiff < 0) {
-			newMonthDiff = 12 + newMonthDiff; //Negative
-		}
-		else {
-			newMonthDiff++;
-		}
-
-		int32_t newYearVal = yearDiff + yd.year; //Getting new year
-		if (newYearVal <= 0 && yd.year > 0) newYearVal--; //Skip year 0
-		else if (newYearVal >= 0 && yd.year < 0) newYearVal++; //Skip year 0
-
-		bool newIsLeap = isLeapYear(newYearVal);
-		uint8_t monthLength = Month::getMonthLength(newMonthDiff, newIsLeap);
-		if (md.day > monthLength) {
-			md.day = monthLength;
-		}
-
-		days = (md.day - 1);
-		days += getDayOfYearFromMonth(newMonthDiff, newIsLeap);
-		days += getDaysUntilYear(newYearVal);
-
-		raw = micr + ((int64_t)days) * DAY;
-	}
-
-	void setYearToRaw(int64_t& raw, int32_t val) {
-		//Current values establishment
-		int32_t days = getDaysFromRaw(raw);
-		year_day_tuple yd = getYearFromDays(days);
-		bool newIsLeap = isLeapYear(val);
-		bool oldIsLeap = isLeapYear(yd.year);
-
-		//Leap day offset, to keep same month and day of month values
-		if (newIsLeap != oldIsLeap) {
-			if (newIsLeap && yd.dayOfYear >= 59) {
-				yd.dayOfYear++;
-			}
-			else if (oldIsLeap && yd.dayOfYear >= 60) {
-				yd.dayOfYear--;
-			}
-		}
-
-		//Days difference calculation
-		int32_t newDays = getDaysUntilYear(val) + yd.dayOfYear;
-		int32_t oldDays = days;
-		int32_t dayDifference = oldDays - newDays;
-
-		//Applying difference
-		raw -= (int64_t)dayDifference * DAY;
+	bool SyncClockTSC::isTSCUsed() {
+#if DT_SYNC_TSC_X86 != 0
+		static bool used = isTSCInvariant();
+		return used;
+#else
+		return false;
+#endif // DT_SYNC_TSC_X86 != 0
 	}
 
-	//TODO tests
-	void addYearsToRaw(int64_t& raw, int32_t val) {
-		//Current values establishment
-		int32_t days = getDaysFromRaw(raw);
-		year_day_tuple yd = getYearFromDays(days);
-
-		//Calculation of new year value
-		int32_t newYearVal = val + yd.year; //Getting new year
-		if (newYearVal <= 0 && yd.year > 0) newYearVal--; //Skip year 0
-		else if (newYearVal >= 0 && yd.year < 0) newYearVal++; //Skip year 0
-
-		//Leap year check
-		bool newIsLeap = isLeapYear(newYearVal);
-		bool oldIsLeap = isLeapYear(yd.year);
-
-		//Leap day offset, to keep same month and day of month values
-		if (newIsLeap != oldIsLeap) {
-			if (newIsLeap && yd.dayOfYear >= 59) {
-				yd.dayOfYear++;
+	int64_t SyncClockTSC::nowSlow() {
+#if DT_SYNC_TSC_X86 != 0
+		if (isTSCUsed()) {
+			std::lock_guard<std::mutex> lock(getTSCMutex());
+			static uint64_t baseTSC = 0;	//Counter of the first calibration, rate is measured from it, so it is more accurate with every anchor
+			static int64_t baseMicros = 0;
+
+			uint64_t tsc;
+			int64_t ref;
+			readTSCPair(tsc, ref);
+			uint64_t limit = anchor.limit.load(std::memory_order_relaxed);
+			int64_t value;
+			if (limit == 0) {
+				//The first calibration
+				baseTSC = tsc;
+				baseMicros = ref;
+				do {
+					readTSCPair(tsc, ref);
+				} while (ref - baseMicros < DT_SYNC_TSC_CALIBRATION);
+				value = ref;
 			}
-			else if (oldIsLeap && yd.dayOfYear >= 60) {
-				yd.dayOfYear--;
+			else {
+				int64_t delta = (int64_t)(tsc - anchor.tsc.load(std::memory_order_relaxed));
+				double mult = (double)anchor.mult.load(std::memory_order_relaxed);
+				int64_t extrapolated = anchor.micros.load(std::memory_order_relaxed) + (int64_t)((double)delta * mult / 4294967296.0);
+				if (delta > -(int64_t)limit && delta < (int64_t)limit) {
+					//Anchor was already renewed by other thread or counter of this core is slightly behind
+					return extrapolated;
+				}
+				//Time never goes back, so lagging counter is stepped forward
+				value = (extrapolated > ref) ? extrapolated : ref;
 			}
-		}
-
-		//Days difference calculation
-		int32_t newDays = getDaysUntilYear(newYearVal) + yd.dayOfYear;
-		int32_t oldDays = days;
-		int32_t dayDifference = oldDays - newDays;
 
-		//Applying difference
-		raw -= (int64_t)dayDifference * DAY;
+			//Period is not longer than measured interval, so error of rate (reference clock has resolution of 1 us) is small at the beginning
+			double microsPerTick = (double)(ref - baseMicros) / (double)(tsc - baseTSC);
+			int64_t period = ref - baseMicros;
+			if (period > DT_SYNC_TSC_ANCHOR_PERIOD) period = DT_SYNC_TSC_ANCHOR_PERIOD;
+
+			//Counter ahead of reference clock is slewed away during the next period
+			int64_t ahead = value - ref;
+			if (ahead > period / 2) ahead = period / 2;
+			double slewedMicrosPerTick = microsPerTick * (double)(period - ahead) / (double)period;
+
+			uint32_t seq = anchor.seq.load(std::memory_order_relaxed);
+			anchor.seq.store(seq + 1, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_release);
+			anchor.tsc.store(tsc, std::memory_order_relaxed);
+			anchor.micros.store(value, std::memory_order_relaxed);
+			anchor.mult.store((uint64_t)(slewedMicrosPerTick * 4294967296.0), std::memory_order_relaxed);
+			anchor.limit.store((uint64_t)((double)period / microsPerTick), std::memory_order_relaxed);
+			anchor.seq.store(seq + 2, std::memory_order_release);
+			return value;
+		}
+#endif // DT_SYNC_TSC_X86 != 0
+		return DT_SYNC_CLOCK_DEFAULT::now();
 	}
+}
+#endif // DT_UNDER_OS > 0
 
-	uint8_t getWeekOfYearFromRaw(int64_t raw, DayOfWeek firstDayOfWeek) {
-		//Current date info
-		int32_t days = getDaysFromRaw(raw);
-		year_day_tuple yd = getYearFromDays(days);
-		bool isLeap = isLeapYear(yd.year);
-		month_day_tuple md = getMonthFromDayOfYear(yd.dayOfYear, isLeap);
-
-		//int32_t dayOfYearUntilMonth = getDayOfYearFromMonth(md.month, isLeap);
-		int32_t daysUntilFirstDayOfYear = days - yd.dayOfYear;
-
-		uint8_t dayOfWeekOffset = 0; //Day of week offset at first day of month
-		if (days < 0) {
-			//BC
-			dayOfWeekOffset = (7 + ((daysUntilFirstDayOfYear - 4 + (7 - firstDayOfWeek)) % 7));
-		}
-		else {
-			//AD
-			dayOfWeekOffset = (((daysUntilFirstDayOfYear + 9 - firstDayOfWeek) % 7) + 1);
-		}
-
-		return ((yd.dayOfYear + dayOfWeekOffset - 1) / 7) + 1;
-	}
-
-	uint8_t getWeekOfMonthFromRaw(int64_t raw, DayOfWeek firstDayOfWeek) {
-		//Current date info
-		int32_t days = getDaysFromRaw(raw);
-		year_day_tuple yd = getYearFromDays(days);
-		bool isLeap = isLeapYear(yd.year);
-		month_day_tuple md = getMonthFromDayOfYear(yd.dayOfYear, isLeap);
-
-		int32_t dayOfYearUntilMonth = getDayOfYearFromMonth(md.month, isLeap);
-		int32_t daysUntilFirstDayOfMonth = days - (yd.dayOfYear - dayOfYearUntilMonth);
-
-		uint8_t dayOfWeekOffset = 0; //Day of week offset at first day of month
-		if (daysUntilFirstDayOfMonth < 0) {
-			//BC
-			dayOfWeekOffset = (7 + ((daysUntilFirstDayOfMonth - 4 + (7 - firstDayOfWeek)) % 7));
-		}
-		else {
-			//AD
-			dayOfWeekOffset = (((daysUntilFirstDayOfMonth + 9 - firstDayOfWeek) % 7) + 1);
-		}
-
-		int8_t dayOfMonth = md.day + dayOfWeekOffset - 2; //zero based
-		return (dayOfMonth / 7) + 1;
-	}
-
-	uint8_t getWeekDayOfMonthFromRaw(int64_t raw) {
-		uint8_t md = getMonthDayFromRaw(raw);
-		return ((md - 1) / 7) + 1;
-	}
-
-
-	void setDayOfYearToRaw(int64_t& raw, uint32_t val) {
-		//Current values establishment
-		int32_t days = getDaysFromRaw(raw);
-		year_day_tuple yd = getYearFromDays(days);
-		bool isLeap = isLeapYear(yd.year);
-
-		//Limits check
-		if (isLeap && val > 365) val = 365;
-		else if (val > 364) val = 364;
-
-		//Days difference calculation
-		int32_t dayDifference = yd.dayOfYear - val;
-
-		//Applying difference
-		raw -= (int64_t)dayDifference * DAY;
-	}
-
-
-
+namespace dtlib {
+#ifdef DT_LEGACY_CALENDAR
 	int32_t getDaysUntilYear(int32_t year) {
 		bool neg = (year < 0); //check if year is BC.
 		int32_t year_tmp;
@@ -835,6 +291,22 @@ namespace dtlib {
 		}
 	}
 
+	date_s getDateFromDays(int32_t days) {
+		year_day_tuple yd = getYearFromDays(days);
+		month_day_tuple md = getMonthFromDayOfYear(yd.dayOfYear, isLeapYear(yd.year));
+		date_s date(yd.year, md.month, md.day);
+		if (days < 0) {
+			//BC
+			date.dayOfWeek = (DayOfWeek)(7 + ((days - 5) % 7));
+		}
+		else {
+			//AD
+			date.dayOfWeek = (DayOfWeek)(((days + 1) % 7) + 1);
+		}
+		return date;
+	}
+#endif // DT_LEGACY_CALENDAR
+
 	char* intToStr2(char* buffer, size_t bufferSize, uint32_t val, bool sameWidth) {
 		if (bufferSize < 2) return buffer + bufferSize;
 		uint8_t digit1 = val % 10;
@@ -892,20 +364,7 @@ namespace dtlib {
 		return buffer + width;
 	}
 
-	/**
-	* @brief Converts time zone or DST to string.
-	* @warning Null terminator is not inserted to the end of string.
-	* @param buffer Buffer, where string will be written.
-	* @param bufferSize Size of buffer without null terminator.
-	* @param val Time zone or DST offset in minutes.
-	* @param options There are 3 options:
-	* + 1 - Prints offset hours without leading zeros. Example: +07:00 => +7
-	* + 2 - Prints offset hours with leading zeros. Example: +07:00 => +07
-	* + 3 - Prints offset hours and minutes with leading zeros and separator ':'. Example: +07:00 => +07:00
-	* + 4 - Prints offset hours and minutes with leading zeros without separator. Example: +07:00 => +0700
-	* @return Returns pointer in buffer to new position after last digit.
-	*/
-	static char* tzToStr(char* buffer, size_t bufferSize, int16_t val, uint8_t options) {
+	char* tzToStr(char* buffer, size_t bufferSize, int16_t val, uint8_t options) {
 		if (bufferSize < 2) return buffer + bufferSize;
 
 		int8_t ho = val / 60;
@@ -1083,7 +542,7 @@ namespace dtlib {
 							//Specific code for MVSC
 							memcpy_s(buffer, bufferSize, weekDayNames[ds.dayOfWeek - 1], len);
 #else
-							memcpy(buffer, dt_day_names[ds.dayOfWeek - 1], len);
+							memcpy(buffer, weekDayNames[ds.dayOfWeek - 1], len);
 #endif
 							bufferSize -= len;
 							buffer += len;
@@ -1219,7 +678,7 @@ namespace dtlib {
 								buffer[0] = monthNames[index][0];
 								buffer[1] = monthNames[index][1];
 								buffer[2] = monthNames[index][2];
-								buffer -= 3;
+								buffer += 3;
 								bufferSize -= 3;
 							}
 							else {
@@ -1233,7 +692,7 @@ namespace dtlib {
 							//Specific code for MVSC
 							memcpy_s(buffer, bufferSize, monthNames[ds.month - 1], len);
 #else
-							memcpy(buffer, dt_day_names[ds.dayOfWeek - 1], len);
+							memcpy(buffer, monthNames[ds.month - 1], len);
 #endif
 							bufferSize -= len;
 							buffer += len;
@@ -1283,18 +742,22 @@ namespace dtlib {
 							if (bufferSize < 1) {
 								bufferSize = 0;
 							}
-							buffer[0] = (ts.hours.isAM()) ? 'A' : 'P';
-							buffer++;
-							bufferSize--;
+							else {
+								buffer[0] = (ts.hours.isAM()) ? 'A' : 'P';
+								buffer++;
+								bufferSize--;
+							}
 						}
 						else {
 							if (bufferSize < 2) {
 								bufferSize = 0;
 							}
-							buffer[0] = (ts.hours.isAM()) ? 'A' : 'P';
-							buffer[1] = 'M';
-							buffer += 2;
-							bufferSize -= 2;
+							else {
+								buffer[0] = (ts.hours.isAM()) ? 'A' : 'P';
+								buffer[1] = 'M';
+								buffer += 2;
+								bufferSize -= 2;
+							}
 						}
 						break;
 
@@ -1369,6 +832,112 @@ namespace dtlib {
 		return dateTimeToArray(buffer, bufferSize, format, 0, date, true, time, true, timeZoneOffset, DSTOffset, monthNames, weekDayNames);
 	}
 
+	//Two-digit lookup table, pair of digits of value v starts at index 2 * v
+	static const char digitPairs[201] =
+		"00010203040506070809"
+		"10111213141516171819"
+		"20212223242526272829"
+		"30313233343536373839"
+		"40414243444546474849"
+		"50515253545556575859"
+		"60616263646566676869"
+		"70717273747576777879"
+		"80818283848586878889"
+		"90919293949596979899";
+
+	/**
+	* @brief Writes exactly two digits of value from 0 to 99.
+	*/
+	static inline char* writePair(char* buffer, uint32_t val) {
+		memcpy(buffer, digitPairs + 2 * val, 2);
+		return buffer + 2;
+	}
+
+	/**
+	* @brief Writes ISO 8601 string without checking of buffer size. Buffer has to have at least ISO8601_MAX_LENGTH characters.
+	*/
+	static char* writeISO8601(char* buffer, int32_t year, uint8_t month, uint8_t day, uint8_t hour, uint8_t minute, uint8_t second, uint32_t microsecond, uint8_t fractionDigits, int16_t offset, ISOOffset offsetMode) {
+		//Astronomical year numbering, year 0 is 1 BC
+		int32_t astroYear = year + (year < 0);
+		if ((uint32_t)astroYear <= 9999) {
+			buffer = writePair(buffer, astroYear / 100);
+			buffer = writePair(buffer, astroYear % 100);
+		}
+		else {
+			//Expanded representation
+			uint32_t absYear = (astroYear < 0) ? -astroYear : astroYear;
+			buffer[0] = (astroYear < 0) ? '-' : '+';
+			buffer = writePair(buffer + 1, absYear / 10000);
+			buffer = writePair(buffer, (absYear / 100) % 100);
+			buffer = writePair(buffer, absYear % 100);
+		}
+
+		buffer[0] = '-';
+		buffer = writePair(buffer + 1, month);
+		buffer[0] = '-';
+		buffer = writePair(buffer + 1, day);
+		buffer[0] = 'T';
+		buffer = writePair(buffer + 1, hour);
+		buffer[0] = ':';
+		buffer = writePair(buffer + 1, minute);
+		buffer[0] = ':';
+		buffer = writePair(buffer + 1, second);
+
+		if (fractionDigits > 0) {
+			if (fractionDigits > 6) fractionDigits = 6;
+			//All 6 digits are written, but buffer is moved only by count of requested digits
+			buffer[0] = '.';
+			writePair(buffer + 1, microsecond / 10000);
+			writePair(buffer + 3, (microsecond / 100) % 100);
+			writePair(buffer + 5, microsecond % 100);
+			buffer += 1 + fractionDigits;
+		}
+
+		if (offsetMode == ISO_OFFSET_UTC_Z && offset == 0) {
+			buffer[0] = 'Z';
+			buffer++;
+		}
+		else if (offsetMode != ISO_OFFSET_NONE) {
+			uint16_t absOffset = (offset < 0) ? -offset : offset;
+			buffer[0] = (offset < 0) ? '-' : '+';
+			buffer = writePair(buffer + 1, (absOffset / 60) % 100);
+			buffer[0] = ':';
+			buffer = writePair(buffer + 1, absOffset % 60);
+		}
+		return buffer;
+	}
+
+	char* iso8601ToArray(char* buffer, size_t bufferSize, int32_t year, uint8_t month, uint8_t day, uint8_t hour, uint8_t minute, uint8_t second, uint32_t microsecond, uint8_t fractionDigits, int16_t offset, ISOOffset offsetMode) {
+		if (bufferSize == 0) return buffer;
+
+		if (bufferSize > ISO8601_MAX_LENGTH) {
+			buffer = writeISO8601(buffer, year, month, day, hour, minute, second, microsecond, fractionDigits, offset, offsetMode);
+		}
+		else {
+			//Buffer could be too small, so string is written to temporary buffer and truncated
+			char tmp[ISO8601_MAX_LENGTH];
+			size_t len = writeISO8601(tmp, year, month, day, hour, minute, second, microsecond, fractionDigits, offset, offsetMode) - tmp;
+			if (len > bufferSize - 1) len = bufferSize - 1;
+			memcpy(buffer, tmp, len);
+			buffer += len;
+		}
+
+		buffer[0] = '\0';
+		return buffer; //Returns position of the null terminator
+	}
+
+	char* iso8601ToArray(char* buffer, size_t bufferSize, int64_t value, uint8_t fractionDigits, int16_t offset, ISOOffset offsetMode) {
+		//Floor division, so time of day is positive also for years BC
+		int64_t rem = value % DAY;
+		int32_t neg = rem < 0;
+		int32_t days = (int32_t)(value / DAY) - neg;
+		rem += neg * DAY;
+		uint32_t secOfDay = (uint32_t)(rem / SECOND);
+
+		date_s date = getDateFromDays(days);
+		return iso8601ToArray(buffer, bufferSize, date.year, date.month, date.day, (uint8_t)(secOfDay / 3600), (uint8_t)((secOfDay % 3600) / 60), (uint8_t)(secOfDay % 60), (uint32_t)(rem % SECOND), fractionDigits, offset, offsetMode);
+	}
+
 
 #ifdef ARDUINO
 	String dateTimeToString(const char* format, int64_t value, date_s ds, bool isDSResolved, time_s ts, bool isTSResolved, int16_t timeZoneOffset, int16_t DSTOffset, const char* const* monthNames, const char* const* weekDayNames) {
@@ -1708,474 +1277,5 @@ namespace dtlib {
 #endif // ARDUINO
 		return dateTimeToString(format, 0, date, true, time, true, timeZoneOffset, DSTOffset, monthNames, weekDayNames);
 	}
-
-	/**
-	* @brief Parses unsigned number from string.
-	* @warning Null terminator is not inserted to the end of string.
-	* @param buffer Buffer, where string with number is located.
-	* @param bufferSize Size of buffer without null terminator.
-	* @param parsedValue Parsed unsigned integer value. If parsing failed, negative value is returned.
-	* @param expectedDigits Expected count of digits. If parameter exactDigCnt is true, exact digits count has to be found
-	* in string, else parsedValue will be false. If parameter exactDigCnt is false, parameter expectedDigits is maximum count of digits.
-	* @param exactDigCnt True, to fill with zeros until width parameter.
-	* @return Returns pointer in buffer to new position after last parsed digit.
-	*/
-	static const char* parseNumber(const char* buffer, size_t bufferSize, int& parsedValue, uint8_t expectedDigits, bool exactDigCnt) {
-		if (bufferSize <= 0 || expectedDigits <= 0) {
-			parsedValue = -1;
-			return buffer;
-		}
-
-		parsedValue = 0;
-		bool firstFound = false;
-		while (expectedDigits > 0 && bufferSize > 0) {
-			char c = *buffer;
-			if (c >= '0' && c <= '9') { //Number found
-				parsedValue *= 10;
-				parsedValue += c - '0';
-				firstFound = true;
-			}
-			else { //Non number character found
-				if (exactDigCnt) {
-					//expectedDigits is exact count of digits
-					if (expectedDigits > 0) {
-						parsedValue = -1; //Parsing error, unexpected character
-						return buffer;
-					}
-				}
-				else {
-					//expectedDigits is maximum count of digits
-					if (!firstFound) parsedValue = -1;
-					return buffer;
-				}
-			}
-			buffer++;
-			bufferSize--;
-			expectedDigits--;
-		}
-		if (!firstFound || (exactDigCnt && expectedDigits > 0)) {
-			parsedValue = -1; //Parsing error, unexpected character
-		}
-		return buffer;
-	}
-
-	/**
-	* @brief Converts char to lower variant
-	*/
-	static char toLowerChar(char c) {
-		if (c >= 'A' && c <= 'Z') return c + 32;
-		else return c;
-	}
-
-	int parseDateTime(const char* buffer, int bufferSize, const char* format, date_time_s & parsedValue, int16_t & timeZoneOffset, int16_t & DSTOffset, int16_t & TZandDSToffset, bool matchText, const char* const* monthNames) {
-		if (bufferSize == 0) return false;
-		//bufferSize--;
-
-		if (monthNames == NULL) {
-			monthNames = dt_month_names;
-		}
-
-		parsedValue = date_time_s();
-		timeZoneOffset = 0;
-		DSTOffset = 0;
-		TZandDSToffset = 0;
-
-		//char* buffer = buffer_;
-
-		int oldBufferSize = bufferSize;
-
-		bool negativeYear = false;
-		bool isAM = false;
-
-		char lastChar = 0;
-		int8_t sameCnt = 1;
-
-		int i = 1;
-		bool escape = false;
-		bool isText = false;
-		bool doubleQ = false;
-		lastChar = format[0];
-		do {
-			char c = format[i];
-			if (lastChar == c) {
-				//Same character found
-				sameCnt++;
-			}
-			else {
-				//New character found
-				bool handled;
-				if (escape || isText) {
-					handled = false;
-					bool curentIsDQ = lastChar == '"';
-					if (!escape && isText && (lastChar == '\'' || curentIsDQ)) {
-						isText = !(curentIsDQ == doubleQ);
-						handled = !isText;
-					}
-					escape = !escape && lastChar == '\\';
-					if (escape) handled = escape;
-				}
-				else {
-					handled = true;
-					switch (lastChar) {
-					case 'f': //Fraction
-					case 'F': {
-						int parsedVal = 0;
-						int digitsFound = 0;
-						int maxDigits = (lastChar == 'f' && sameCnt < 6) ? sameCnt : 6;
-						while (bufferSize > 0) {
-							char c = *buffer;
-							if (c >= '0' && c <= '9') { //Number found
-								if (digitsFound < maxDigits) { //Captre only firts 6 digits
-									parsedVal *= 10;
-									parsedVal += c - '0';
-								}
-								digitsFound++;
-							}
-							else { //Non number character found
-								if (lastChar == 'f' && digitsFound != sameCnt) {
-									return bufferSize - oldBufferSize; //Parsing error
-								}
-								else {
-									break;
-								}
-							}
-							buffer++;
-							bufferSize--;
-						}
-
-						for (uint8_t i = digitsFound; i < 6; i++) {
-							parsedVal *= 10;
-						}
-
-						if (bufferSize <= 0 && lastChar == 'f' && digitsFound != sameCnt) {
-							return bufferSize - oldBufferSize; //Parsing error
-						}
-
-						parsedValue.milliseconds = parsedVal / 1000;
-						parsedValue.microseconds = parsedVal % 1000;
-
-						break;
-					}
-
-					case 'G':
-					case 'g': // B.C. or A.C.
-						//B.C. or A.D. expected
-						if (*buffer == 'A' || *buffer == 'a') {
-							if (bufferSize >= 4 && buffer[1] == '.' && (buffer[2] == 'D' || buffer[2] == 'd') && buffer[3] == '.') {
-								//A.D. or a.d. found
-								negativeYear = false;
-								bufferSize -= 4;
-								buffer += 4;
-							}
-							else {
-								return bufferSize - oldBufferSize; //Parsing error
-							}
-						}
-						else if (*buffer == 'B' || *buffer == 'b') {
-							if (bufferSize >= 4 && buffer[1] == '.' && (buffer[2] == 'C' || buffer[2] == 'c') && buffer[3] == '.') {
-								//A.D. or a.d. found
-								negativeYear = true;
-								bufferSize -= 4;
-								buffer += 4;
-							}
-							else {
-								return bufferSize - oldBufferSize; //Parsing error
-							}
-						}
-						else {
-							if (lastChar == 'g') {
-								return bufferSize - oldBufferSize; //Parsing error
-							}
-							else {
-								negativeYear = false;
-							}
-						}
-						break;
-
-					case 'N':
-					case 'n': // B.C. or A.C. represented by sign
-						if (lastChar == 'n') {
-							//Plus or minus char excpted
-							if (*buffer == '+' || *buffer == '-') {
-								negativeYear = *buffer == '-';
-								bufferSize--;
-								buffer++;
-							}
-							else {
-								return bufferSize - oldBufferSize; //Parsing error
-							}
-						}
-						else {
-							//Minus or any other char excpted
-							if (*buffer == '+' || *buffer == '-') {
-								negativeYear = *buffer == '-';
-								bufferSize--;
-								buffer++;
-							}
-							else {
-								negativeYear = false;
-							}
-						}
-						break;
-					case 'l':  //DTS offset
-					case 'Z':  //Time zone and DST offset
-					case 'z': {//Time zone offset
-						int parsedVal1;
-						int parsedVal2 = 0;
-						const char* newBuffer;
-
-						bool minusFound = buffer[0] == '-';
-						if (minusFound || buffer[0] == '+') {
-							bufferSize--;
-							buffer++;
-							if (bufferSize < 1) {
-								return bufferSize - oldBufferSize; //Parsing error
-							}
-						}
-
-						int offsVal;
-						if (buffer[0] == 'z' || buffer[0] == 'Z') { //UTC time
-							offsVal = 0;
-							bufferSize--;
-							buffer++;
-						}
-						else {
-							if (sameCnt == 1 || sameCnt == 2) {
-								newBuffer = parseNumber(buffer, bufferSize, parsedVal1, 2, sameCnt == 2);
-								if (parsedVal1 < 0 || parsedVal1 > 14) {
-									return bufferSize - oldBufferSize; //Parsing error
-								}
-							}
-							else {
-								newBuffer = parseNumber(buffer, bufferSize, parsedVal1, 2, false);
-								if (parsedVal1 < 0 || parsedVal1 > 14) {
-									return bufferSize - oldBufferSize; //Parsing error
-								}
-								bufferSize -= (int)(newBuffer - buffer);
-								buffer = newBuffer;
-								if (sameCnt == 3) {
-									if (*buffer != ':') {
-										return bufferSize - oldBufferSize; //Parsing error
-									}
-									bufferSize--;
-									buffer++;
-								}
-								newBuffer = parseNumber(buffer, bufferSize, parsedVal2, 2, false);
-								if (parsedVal2 < 0 || parsedVal1 > 59) {
-									return bufferSize - oldBufferSize; //Parsing error
-								}
-							}
-							offsVal = parsedVal1 * 60 + parsedVal2;
-							if (minusFound) offsVal = -offsVal;
-
-							bufferSize -= (int)(newBuffer - buffer);
-							buffer = newBuffer;
-						}
-
-						switch (lastChar) {
-						case 'z': timeZoneOffset = offsVal; break;//Time zone offset
-						case 'Z': TZandDSToffset = offsVal; break;//Time zone and DST offset
-						case 'l': DSTOffset = offsVal; break;//DTS offset
-						}
-						break;
-					}
-					case 'd':   //day of month
-					case 'u':   //microseconds
-					case 'i':   //milliseconds
-					case 's':   //seconds
-					case 'm':   //minutes
-					case 'H':   //24-hour format
-					case 'h': {	//12-hour format
-						int parsedVal;
-						const char* newBuffer;
-						bool ms_or_us = lastChar == 'u' || lastChar == 'i';
-						if (sameCnt == 1) {
-							//Unknown count of digits
-							newBuffer = parseNumber(buffer, bufferSize, parsedVal, ms_or_us ? 3 : 2, false);
-						}
-						else {
-							//Exact excepted count of digits
-							newBuffer = parseNumber(buffer, bufferSize, parsedVal, sameCnt, true);
-						}
-						bufferSize -= (int)(newBuffer - buffer);
-						if (parsedVal < 0 || (ms_or_us && parsedVal > 999) || (lastChar == 'H' && parsedVal > 23) || (lastChar == 'h' && (parsedVal > 12 || parsedVal < 1)) || (lastChar == 'd' && (parsedVal > 31 || parsedVal < 1)) || parsedVal > 60) {
-							return bufferSize - oldBufferSize; //Parsing error
-						}
-						buffer = newBuffer;
-
-						switch (lastChar) {
-						case 'd': parsedValue.day = parsedVal; break; //day of month
-						case 'u': parsedValue.microseconds = parsedVal; break; //microseconds
-						case 'i': parsedValue.milliseconds = parsedVal; break; //milliseconds
-						case 's': parsedValue.seconds = parsedVal; break; //seconds
-						case 'm': parsedValue.minutes = parsedVal; break; //minutes
-						case 'H': parsedValue.hours.setHours24(parsedVal); break; //24-hour format
-						case 'h': parsedValue.hours.setHours12(parsedVal, false); break; //12-hour format
-						}
-						break;
-					}
-					case 'M': //month
-						if (sameCnt == 1 || sameCnt == 2) {
-							int parsedVal;
-							const char* newBuffer;
-							if (sameCnt == 1) {
-								//Unknown count of digits
-								newBuffer = parseNumber(buffer, bufferSize, parsedVal, 2, false);
-							}
-							else {
-								//Exact excepted count of digits
-								newBuffer = parseNumber(buffer, bufferSize, parsedVal, sameCnt, true);
-							}
-							bufferSize -= (int)(newBuffer - buffer);
-							if (parsedVal < 0) {
-								return bufferSize - oldBufferSize - 1; //Parsing error
-							}
-							else if (parsedVal < 1 || parsedVal > 12) {
-								return bufferSize - oldBufferSize; //Parsing error
-							}
-							buffer = newBuffer;
-							parsedValue.month = parsedVal;
-						}
-						else if (sameCnt == 3) {
-							if (bufferSize < 3) {
-								return bufferSize - oldBufferSize; //Parsing error
-							}
-							bool found = false;
-							for (uint8_t i = 0; i < 12; i++) {
-								bool match = toLowerChar(monthNames[i][0]) == toLowerChar(buffer[0]) && toLowerChar(monthNames[i][1]) == toLowerChar(buffer[1]) && toLowerChar(monthNames[i][2]) == toLowerChar(buffer[2]);
-								if (match) {
-									found = true;
-									parsedValue.month = i + 1;
-									break;
-								}
-							}
-							if (!found) {
-								return bufferSize - oldBufferSize; //Parsing error
-							}
-							bufferSize -= 3;
-							buffer += 3;
-						}
-						else if (sameCnt == 4) {
-							bool found = false;
-							for (uint8_t i = 0; i < 12; i++) {
-								uint8_t j = 0;
-								for (; monthNames[i][j] != 0 && bufferSize > j && toLowerChar(monthNames[i][j]) == toLowerChar(buffer[j]); j++);
-								bool match = monthNames[i][j] == 0;
-								if (match) {
-									found = true;
-									parsedValue.month = i + 1;
-									bufferSize -= j;
-									buffer += j;
-									break;
-								}
-							}
-							if (!found) {
-								return bufferSize - oldBufferSize; //Parsing error
-							}
-						}
-						break;
-					case 't': {//AM/PM
-						bool aFound = buffer[0] == 'A' || buffer[0] == 'a';
-						bool apFound = aFound || buffer[0] == 'P' || buffer[0] == 'p';
-						if (!apFound || bufferSize < 1) {
-							return bufferSize - oldBufferSize; //Parsing error
-						}
-						if (sameCnt == 2) {
-							if (bufferSize >= 2 && (buffer[1] == 'M' || buffer[1] == 'm')) {
-								isAM = aFound;
-							}
-							else {
-								return bufferSize - oldBufferSize; //Parsing error
-							}
-							buffer += 2;
-							bufferSize -= 2;
-						}
-						else {
-							isAM = aFound;
-							buffer++;
-							bufferSize--;
-						}
-					}
-							break;
-
-					case 'y': {	//year
-						int parsedVal;
-						const char* newBuffer;
-						if (sameCnt == 1) {
-							//Unknown count of digits
-							newBuffer = parseNumber(buffer, bufferSize, parsedVal, 6, false);
-						}
-						else {
-							//Exact excepted count of digits
-							newBuffer = parseNumber(buffer, bufferSize, parsedVal, sameCnt, false);
-						}
-						bufferSize -= (int)(newBuffer - buffer);
-						if (parsedVal < 0) {
-							return bufferSize - oldBufferSize; //Parsing error
-						}
-						else if (sameCnt == 2 || sameCnt == 3) {
-							//Two or three digit year notation
-							parsedVal += 2000;
-						}
-						buffer = newBuffer;
-						parsedValue.year = parsedVal;
-						break;
-					}
-
-					case '\\':
-						escape = true;
-						break;
-
-					case '\'': //Text mark
-						isText = !(isText && !doubleQ);
-						doubleQ = false;
-						break;
-
-					case '"': //Text mark
-						isText = !(isText && !doubleQ);
-						doubleQ = true;
-						break;
-
-					default:
-						handled = false;
-						break;
-					}
-				}
-
-				if (!handled) {
-					//Skipping text characters
-					if (bufferSize < sameCnt) {
-						return bufferSize - oldBufferSize; //Parsing failed
-					}
-					for (; sameCnt > 0; sameCnt--) {
-						if (*buffer == '\0' || (matchText && *buffer != lastChar)) {
-							return bufferSize - oldBufferSize; //Parsing failed
-						}
-						buffer++;
-						bufferSize--;
-					}
-				}
-
-				sameCnt = 1;
-				lastChar = c;
-				if (*buffer == '\0' && c != 'G' && c != 'N') {
-					break; //End of buffer reached
-				}
-			}
-			i++;
-		} while (lastChar != '\0' && bufferSize > 0);
-
-		if (negativeYear) parsedValue.year = -parsedValue.year;
-		if (parsedValue.hours.is12()) {
-			parsedValue.hours.setHours12(parsedValue.hours.getHours(), isAM);
-		}
-
-		if (lastChar == '\0') {
-			return oldBufferSize - bufferSize; //Returns positive position if not failed
-		}
-		else {
-			return bufferSize - oldBufferSize; //Returns negative position if failed
-		}
-	}
 }
 
@@ -42,21 +42,65 @@
 #define CONSTEXPR_IF if constexpr //TODO shows warning
 #endif
 
+#if defined(_MSVC_LANG) && _MSVC_LANG > __cplusplus
+#define DT_CPP_VERSION  _MSVC_LANG  //MSVC sets __cplusplus only with /Zc:__cplusplus
+#else
+#define DT_CPP_VERSION  __cplusplus
+#endif
+
+#if DT_CPP_VERSION >= 201402L
+#define DT_CONSTEXPR14  constexpr   //Function needs relaxed constexpr of C++14 (more statements, loops, void or non-const member function)
+#else
+#define DT_CONSTEXPR14  inline      //Function is evaluated only at runtime before C++14
+#endif
+
+#if defined(__cpp_consteval)
+#define DT_CONSTEVAL consteval  //Literals are always evaluated at compile time
+#elif DT_CPP_VERSION >= 201402L
+#define DT_CONSTEVAL constexpr  //Literals are evaluated at compile time, when they are used in constant expression
+#else
+#define DT_CONSTEVAL inline     //Literals are evaluated at runtime before C++14
+#endif
+
 #if DT_UNDER_OS > 0
 #include <chrono>
 #include <string>
 
-#define DT_SYNC_TYPE                int64_t
-#define DT_SYNC_FUNC()              getSysTicks()
-#define DT_SYNC_RESOLUTION          (MICROSECOND)
+#include <atomic>
+
+#if DT_UNDER_OS == DT_WIN
+#define DT_SYNC_CLOCK_DEFAULT       dtlib::SyncClockSteady
+#else
+#include <time.h>
+#define DT_SYNC_CLOCK_DEFAULT       dtlib::SyncClockMonotonic
+#endif // DT_UNDER_OS == DT_WIN
+
+#if !defined(DT_NO_TSC) && (defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86))
+#define DT_SYNC_TSC_X86             (1U)    //dtlib::SyncClockTSC reads time stamp counter
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif // _MSC_VER
+#else
+#define DT_SYNC_TSC_X86             (0U)    //dtlib::SyncClockTSC reads DT_SYNC_CLOCK_DEFAULT
+#endif
+
+#ifndef DT_SYNC_TSC_ANCHOR_PERIOD
+#define DT_SYNC_TSC_ANCHOR_PERIOD   (1000000L)  //Microseconds between re-anchoring of dtlib::SyncClockTSC to DT_SYNC_CLOCK_DEFAULT
+#endif // !DT_SYNC_TSC_ANCHOR_PERIOD
+
+#ifndef DT_SYNC_TSC_CALIBRATION
+#define DT_SYNC_TSC_CALIBRATION     (2000L)     //Microseconds of the first calibration of dtlib::SyncClockTSC
+#endif // !DT_SYNC_TSC_CALIBRATION
 #define DT_SUPPORTS_NOW             (1U)    //now() and nowUTC() functions are defined in DateTimeSysSync and DateTimeTZSysSync
 #define DT_SUPPORTS_SET_SYS_TIME    (0U)    //Under OS setting system time is not supported
 #define DT_SUPPORTS_SET_SYSTZ       (0U)    //Under OS setting system time zone is not supported
 #define DT_SUPPORTS_GET_SYSTZ       (1U)    //getSystemTZ(), getSystemDST() and getSystemTZInfo() are supported
 
 /**
-* @brief Gets system ticks in microseconds (same as micros64() on Arduino), the time will be synchronized with in classes
-* DateTimeSysSync and DateTimeTZSysSync on Windows, Linux and Mac OS.
+* @brief Gets system wall clock time in microseconds since the 1st of January 1970. This value jumps, when system time is changed,
+* so it is used for synchronization only by dtlib::SyncClockSystem.
 */
 int64_t getSysTicks();
 
@@ -68,9 +112,7 @@ int64_t getSysTicks();
 
 #if defined(ESP8266)
 //ESP8266 uses micros64() for synchronizing time
-#define DT_SYNC_TYPE                int64_t
-#define DT_SYNC_FUNC()              micros64()
-#define DT_SYNC_RESOLUTION          (MICROSECOND)
+#define DT_SYNC_CLOCK_DEFAULT       dtlib::SyncClockMicros64
 #define DT_SUPPORTS_NOW             (1U)    //now() and nowUTC() functions are defined in DateTimeSysSync and DateTimeTZSysSync
 #define DT_SUPPORTS_SET_SYS_TIME    (1U)    //setSystemTime() and setSystemTimeUTC() are supported
 #define DT_SUPPORTS_SET_SYSTZ       (1U)    //setSystemTZ(), setSystemDST() and setSystemTZInfo() are supported
@@ -78,18 +120,14 @@ int64_t getSysTicks();
 #elif defined(ESP32)
 //ESP32 uses esp_timer_get_time() for synchronizing time
 #include "esp_timer.h" //for function: esp_timer_get_time()
-#define DT_SYNC_TYPE                uint64_t
-#define DT_SYNC_FUNC()              esp_timer_get_time()
-#define DT_SYNC_RESOLUTION          (MICROSECOND)
+#define DT_SYNC_CLOCK_DEFAULT       dtlib::SyncClockESPTimer
 #define DT_SUPPORTS_NOW             (1U)    //now() and nowUTC() functions are defined in DateTimeSysSync and DateTimeTZSysSync
 #define DT_SUPPORTS_SET_SYS_TIME    (1U)    //setSystemTime() and setSystemTimeUTC() are supported
 #define DT_SUPPORTS_SET_SYSTZ       (1U)    //setSystemTZ(), setSystemDST() and setSystemTZInfo() are supported
 #define DT_SUPPORTS_GET_SYSTZ       (1U)    //getSystemTZ(), getSystemDST() and getSystemTZInfo() are supported
 #else
 //Other arduinos uses millis() for synchronizing time
-#define DT_SYNC_TYPE                int32_t
-#define DT_SYNC_FUNC()              millis() //TODO use micros64() or micros() on arduino
-#define DT_SYNC_RESOLUTION          (MILLISECOND)
+#define DT_SYNC_CLOCK_DEFAULT       dtlib::SyncClockMillis //TODO use micros64() or micros() on arduino
 #define DT_SUPPORTS_NOW             (0U)    //now() and nowUTC() functions are unsupported on Arduino, because it has no system clock
 #define DT_SUPPORTS_SET_SYS_TIME    (0U)    //Arduino has no system time
 #define DT_SUPPORTS_SET_SYSTZ       (0U)    //Arduino has no system time zone
@@ -157,6 +195,17 @@ template<class C> struct name<C, typename dtlib::enable_if<!dtlib::is_same<declt
 #define DAYS_IN_4_YRS	(365L * 4L   + 1L)  //with 1 leap day
 #define DAYS_IN_YEAR	(365L)				//without leap day
 
+//Calendar kernel
+//Define DT_LEGACY_CALENDAR to use old calendar algorithms (division based) instead of the branch free kernel
+#define DT_CAL_SHIFT_YEARS	(400UL * 800UL)				//Years added to make all valid years positive (multiple of 400 years to keep leap years)
+#define DT_CAL_SHIFT_DAYS	(146097UL * 800UL)			//Count of days in DT_CAL_SHIFT_YEARS
+#define DT_CAL_MARCH_OFFSET	(306UL)						//Days from the 1st of March 0000 to the 1st of January 0001
+#ifndef DT_LEGACY_CALENDAR
+#define DT_CAL_CONSTEXPR	DT_CONSTEXPR14				//Functions, which use calendar kernel, can be evaluated at compile time (since C++14)
+#else
+#define DT_CAL_CONSTEXPR	inline						//Legacy calendar kernel cannot be evaluated at compile time
+#endif // !DT_LEGACY_CALENDAR
+
 #define MICROSECOND   (1)
 #define MILLISECOND   (1000L * MICROSECOND)
 #define SECOND        (1000L * MILLISECOND)
@@ -167,6 +216,189 @@ template<class C> struct name<C, typename dtlib::enable_if<!dtlib::is_same<declt
 #define MICROS_PER_YEAR			(DAY*365) //Count of microseconds per year
 #define MICROS_PER_LEAP_YEAR	(DAY*366) //Count of microseconds per leap year
 
+namespace dtlib {
+    /**
+    * @name Sync clocks
+    * Clock policies, which can be used for synchronization of DateTimeSysSync and DateTimeTZSysSync. Policy is selected by macro DT_SYNC_CLOCK,
+    * which has to be the same in whole program (so it is better to define it by compiler flag). Each policy has:
+    * + `type` - type of ticks, difference of two ticks can overflow only if type is unsigned or if it is 32-bit,
+    * + `resolution` - microseconds per one tick,
+    * + `now()` - static function returning current ticks.
+    * @code{.cpp}
+    * //Compiled with -DDT_SYNC_CLOCK=dtlib::SyncClockMonotonicCoarse
+    * DateTimeSysSync clock = DateTimeSysSync::now(); //Reading of clock is cheaper, but it has resolution of few milliseconds
+    * @endcode
+    */
+    /**@{*/
+
+#if DT_UNDER_OS > 0
+    /**
+    * @brief Sync clock using system wall clock (std::chrono::system_clock). Synchronized time jumps, when system time is changed.
+    */
+    struct SyncClockSystem {
+        typedef int64_t type;
+        static constexpr int64_t resolution = MICROSECOND;
+
+        static inline type now() {
+            return getSysTicks();
+        }
+    };
+
+    /**
+    * @brief Sync clock using std::chrono::steady_clock, which is not affected by changes of system time.
+    */
+    struct SyncClockSteady {
+        typedef int64_t type;
+        static constexpr int64_t resolution = MICROSECOND;
+
+        static inline type now() {
+            return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
+    };
+
+#if DT_UNDER_OS == DT_LINUX || DT_UNDER_OS == DT_MAC
+    /**
+    * @brief Sync clock reading POSIX clock by clock_gettime().
+    * @tparam clockID ID of clock, for example CLOCK_MONOTONIC.
+    */
+    template<clockid_t clockID>
+    struct SyncClockPOSIX {
+        typedef int64_t type;
+        static constexpr int64_t resolution = MICROSECOND;
+
+        static inline type now() {
+            struct timespec ts;
+            clock_gettime(clockID, &ts);
+            return ((int64_t)ts.tv_sec) * 1000000LL + ts.tv_nsec / 1000;
+        }
+    };
+
+    /**
+    * @brief Sync clock using CLOCK_MONOTONIC, which is not affected by changes of system time, but it is slewed by NTP. It does not count time of suspend.
+    */
+    typedef SyncClockPOSIX<CLOCK_MONOTONIC> SyncClockMonotonic;
+
+#ifdef CLOCK_MONOTONIC_COARSE
+    /**
+    * @brief Sync clock using CLOCK_MONOTONIC_COARSE. Reading is cheaper than reading of CLOCK_MONOTONIC,
+    * but clock is updated only once per timer tick (usually 1-4 ms).
+    */
+    typedef SyncClockPOSIX<CLOCK_MONOTONIC_COARSE> SyncClockMonotonicCoarse;
+#endif // CLOCK_MONOTONIC_COARSE
+
+#ifdef CLOCK_BOOTTIME
+    /**
+    * @brief Sync clock using CLOCK_BOOTTIME, which is the same as CLOCK_MONOTONIC, but it also counts time of suspend.
+    */
+    typedef SyncClockPOSIX<CLOCK_BOOTTIME> SyncClockBoottime;
+#endif // CLOCK_BOOTTIME
+#endif // DT_UNDER_OS == DT_LINUX || DT_UNDER_OS == DT_MAC
+
+    /**
+    * @brief Sync clock reading time stamp counter of x86 processor (rdtsc), which gives ticks of the same time base as DT_SYNC_CLOCK_DEFAULT
+    * (CLOCK_MONOTONIC on Linux). Counter is calibrated against DT_SYNC_CLOCK_DEFAULT by the first reading (it takes DT_SYNC_TSC_CALIBRATION microseconds)
+    * and it is re-anchored to it every DT_SYNC_TSC_ANCHOR_PERIOD microseconds (shorter periods are used, while time from calibration is shorter). Ahead drift is slewed away during the next period and lagging drift is
+    * stepped forward, so returned time never goes back. Reading between anchors is rdtsc and multiply-shift without any lock.
+    * @note When counter is not invariant (its frequency changes with power states) or processor is not x86, DT_SYNC_CLOCK_DEFAULT is read instead.
+    */
+    struct SyncClockTSC {
+        typedef int64_t type;
+        static constexpr int64_t resolution = MICROSECOND;
+
+        static inline type now() {
+#if DT_SYNC_TSC_X86 != 0
+            //Anchor is read like seqlock, so reading never mixes values of two anchors
+            uint64_t tsc = __rdtsc();
+            uint32_t seq = anchor.seq.load(std::memory_order_acquire);
+            uint64_t delta = tsc - anchor.tsc.load(std::memory_order_relaxed);
+            int64_t micros = anchor.micros.load(std::memory_order_relaxed);
+            uint64_t mult = anchor.mult.load(std::memory_order_relaxed);
+            uint64_t limit = anchor.limit.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (delta < limit && (seq & 1) == 0 && seq == anchor.seq.load(std::memory_order_relaxed)) {
+                return micros + (int64_t)((delta * mult) >> 32);
+            }
+#endif // DT_SYNC_TSC_X86 != 0
+            return nowSlow();
+        }
+
+        /**
+        * @brief Checks if time stamp counter is used. It is false, when counter is not invariant or processor is not x86.
+        */
+        static bool isTSCUsed();
+
+    private:
+        /**
+        * @brief Reads clock, when anchor is too old, when counter was not calibrated yet or when counter cannot be used.
+        */
+        static int64_t nowSlow();
+
+        /**
+        * @struct tsc_anchor_s
+        * @brief Anchor of counter. Value is micros + ((tsc_now - tsc) * mult) >> 32, while tsc_now - tsc is lower than limit.
+        */
+        struct alignas(64) tsc_anchor_s {
+            std::atomic<uint32_t> seq;      //Odd while anchor is written
+            std::atomic<uint64_t> tsc;
+            std::atomic<int64_t> micros;
+            std::atomic<uint64_t> mult;     //Microseconds per tick shifted by 32 bits
+            std::atomic<uint64_t> limit;    //Ticks of anchor period, 0 if counter is not calibrated
+        };
+
+        static tsc_anchor_s anchor;
+    };
+
+#elif defined(ESP8266)
+    /**
+    * @brief Sync clock using micros64().
+    */
+    struct SyncClockMicros64 {
+        typedef int64_t type;
+        static constexpr int64_t resolution = MICROSECOND;
+
+        static inline type now() {
+            return micros64();
+        }
+    };
+#elif defined(ESP32)
+    /**
+    * @brief Sync clock using esp_timer_get_time().
+    */
+    struct SyncClockESPTimer {
+        typedef uint64_t type;
+        static constexpr int64_t resolution = MICROSECOND;
+
+        static inline type now() {
+            return esp_timer_get_time();
+        }
+    };
+#elif defined(ARDUINO)
+    /**
+    * @brief Sync clock using millis(). Microseconds of synchronized time stay unchanged.
+    */
+    struct SyncClockMillis {
+        typedef int32_t type;
+        static constexpr int64_t resolution = MILLISECOND;
+
+        static inline type now() {
+            return millis();
+        }
+    };
+#endif // DT_UNDER_OS > 0
+
+    /**@}*/
+}
+
+#if defined(DT_SYNC_CLOCK_DEFAULT) && !defined(DT_SYNC_CLOCK)
+#define DT_SYNC_CLOCK               DT_SYNC_CLOCK_DEFAULT       //Clock policy used for synchronization of DateTimeSysSync and DateTimeTZSysSync
+#endif // defined(DT_SYNC_CLOCK_DEFAULT) && !defined(DT_SYNC_CLOCK)
+
+#ifdef DT_SYNC_CLOCK
+#define DT_SYNC_TYPE                DT_SYNC_CLOCK::type         //Type of ticks of sync clock
+#define DT_SYNC_FUNC()              DT_SYNC_CLOCK::now()        //Reads ticks of sync clock
+#define DT_SYNC_RESOLUTION          (DT_SYNC_CLOCK::resolution) //Microseconds per one tick of sync clock
+#endif // DT_SYNC_CLOCK
+
 //Limits
 /*
 #define MAX_RAW_MILLIS	(185542570511940999LL)
@@ -182,9 +414,11 @@ template<class C> struct name<C, typename dtlib::enable_if<!dtlib::is_same<declt
 #define MAX_DAYS ( 106751981L)	//Maximum valid days value
 #define MIN_DAYS (-106751983L)	//Minimum valid days value
 
+#define ISO8601_MAX_LENGTH (35)	//Maximum length of string written by dtlib::iso8601ToArray() without null terminator
+
 
-const char* const dt_day_names[] = { "Sunday", "Monday", "Tuesday", "Wednesday", "Thursday", "Friday", "Saturday" };
-const char* const dt_month_names[] = { "January", "February", "March", "April", "May", "June", "July", "August", "September", "October", "November", "December" };
+constexpr const char* dt_day_names[] = { "Sunday", "Monday", "Tuesday", "Wednesday", "Thursday", "Friday", "Saturday" };
+constexpr const char* dt_month_names[] = { "January", "February", "March", "April", "May", "June", "July", "August", "September", "October", "November", "December" };
 
 /**
 * @enum WeekOfMonth
@@ -205,19 +439,19 @@ typedef enum {
 * @brief Structure, that acts as day of week enumeration with size of 1 byte.
 */
 struct DayOfWeek {
-    DayOfWeek() {}
+    constexpr DayOfWeek() {}
 
-    DayOfWeek(int8_t val) :value(val) {	}
+    constexpr DayOfWeek(int8_t val) :value(val) {	}
 
-    operator uint8_t() {
+    DT_CONSTEXPR14 operator uint8_t() {
         return value;
     }
 
-    operator uint8_t() const {
+    constexpr operator uint8_t() const {
         return value;
     }
 
-    DayOfWeek& operator=(const uint8_t val) {
+    DT_CONSTEXPR14 DayOfWeek& operator=(const uint8_t val) {
         value = val;
         return *this;
     }
@@ -260,40 +494,40 @@ protected:
 * @brief Structure, that acts as month enumeration with size of 1 byte.
 */
 struct Month {
-    Month() {}
+    constexpr Month() {}
 
-    Month(int8_t val) :value(val) {	}
+    constexpr Month(int8_t val) :value(val) {	}
 
-    operator uint8_t() {
+    DT_CONSTEXPR14 operator uint8_t() {
         return value;
     }
 
-    operator uint8_t() const {
+    constexpr operator uint8_t() const {
         return value;
     }
 
-    Month& operator=(const uint8_t val) {
+    DT_CONSTEXPR14 Month& operator=(const uint8_t val) {
         value = val;
         return *this;
     }
 
-    Month& operator++() {
+    DT_CONSTEXPR14 Month& operator++() {
         ++value;
         return *this;
     }
 
-    Month& operator--() {
+    DT_CONSTEXPR14 Month& operator--() {
         --value;
         return *this;
     }
 
-    Month operator++(int) {
+    DT_CONSTEXPR14 Month operator++(int) {
         Month tmp = *this;
         value++;
         return tmp;
     }
 
-    Month operator--(int) {
+    DT_CONSTEXPR14 Month operator--(int) {
         Month tmp = *this;
         value--;
         return tmp;
@@ -322,14 +556,21 @@ struct Month {
     * @param leapYear True if year contains leap day.
     * @return Returns length of current month.
     */
-    uint8_t getMonthLength(bool leapYear) const;
+    constexpr uint8_t getMonthLength(bool leapYear) const {
+        //Month lengths alternate between 31 and 30 days and the pattern is shifted by one day in August
+        return (uint8_t)(value - 1) < 12 ?
+            (value == 2 ? 28 + leapYear : 31 - ((value & 1) == (value >= 8))) :
+            0;
+    }
 
     /**
     * @brief Gets length of month.
     * @param month Month, which length need to be known. Value can be from range 1-12.
     * @return Returns count of days in specified month. Value is in range 1-28/29/30/31;
     */
-    static uint8_t getMonthLength(Month month, bool leapYear);
+    static constexpr uint8_t getMonthLength(Month month, bool leapYear) {
+        return month.getMonthLength(leapYear);
+    }
 
     enum MonthE{
         Unknown = 0,
@@ -362,9 +603,9 @@ struct DateTime_DST_tuple {
 };
 
 struct year_day_tuple {
-    year_day_tuple() {}
+    constexpr year_day_tuple() {}
 
-    year_day_tuple(int32_t year_, uint16_t dayOfYear_) :
+    constexpr year_day_tuple(int32_t year_, uint16_t dayOfYear_) :
         year(year_),
         dayOfYear(dayOfYear_)
     {}
@@ -373,7 +614,7 @@ struct year_day_tuple {
 };
 
 struct month_day_tuple {
-    month_day_tuple(uint8_t month_, uint8_t day_) :
+    constexpr month_day_tuple(uint8_t month_, uint8_t day_) :
         month(month_),
         day(day_)
     {}
@@ -388,7 +629,7 @@ struct month_day_tuple {
 * It can remember it's format. This strucure can act as 6-bit uint8_t variable.
 */
 struct hour_t {
-    hour_t() :
+    constexpr hour_t() :
         hours(0),
         is24_(1),
         isAM_(1)
@@ -400,36 +641,37 @@ struct hour_t {
     * @param is24 True if hour format is 24 hour format.
     * @param isAM When 12 hour format is used, this parameter specifies if hour is AM.
     */
-    hour_t(uint8_t hours_, bool is24 = true, bool isAM = true) {
-        if (is24) setHours24(hours_);
-        else setHours12(hours_, isAM);
-    }
+    constexpr hour_t(uint8_t hours_, bool is24 = true, bool isAM = true) :
+        hours(is24 ? hours_ % 24 : ((hours_ + 11) % 12) + 1),
+        is24_(is24),
+        isAM_(is24 ? hours_ < 12 : isAM)
+    {	}
 
     /**
     * @brief True if current hour is AM.
     */
-    inline bool isAM() {
+    constexpr bool isAM() const {
         return isAM_;
     }
 
     /**
     * @brief True if current hour is PM.
     */
-    inline bool isPM() {
+    constexpr bool isPM() {
         return !isAM_;
     }
 
     /**
     * @brief True if current hour format is 24 hour format.
     */
-    inline bool is24() {
+    constexpr bool is24() const {
         return is24_;
     }
 
     /**
     * @brief True if current hour format is 12 hour format.
     */
-    inline bool is12() {
+    constexpr bool is12() {
         return !is24_;
     }
 
@@ -437,7 +679,7 @@ struct hour_t {
     * @brief Sets hours in 12 hour format. is24() will return false.
     * @param hours_ Hours from 1 to 12.
     */
-    inline void setHours12(uint8_t hours_, bool isAM) {
+    DT_CONSTEXPR14 void setHours12(uint8_t hours_, bool isAM) {
         hours = ((hours_ + 11) % 12) + 1;
         is24_ = false;
         isAM_ = isAM;
@@ -447,7 +689,7 @@ struct hour_t {
     * @brief Sets hours in 24 hour format. is24() will return true.
     * @param hours_ Hours from 0 to 23.
     */
-    inline void setHours24(uint8_t hours_) {
+    DT_CONSTEXPR14 void setHours24(uint8_t hours_) {
         isAM_ = hours_ < 12;
         hours = hours_ % 24;
         is24_ = true;
@@ -457,19 +699,19 @@ struct hour_t {
     * @brief Gets hours in specified format.
     * @return Returns hours in specified format.
     */
-    inline uint8_t getHours() {
+    constexpr uint8_t getHours() const {
         return hours;
     }
 
-    operator uint8_t() {
+    DT_CONSTEXPR14 operator uint8_t() {
         return hours; //Return only hours
     }
 
-    operator uint8_t() const {
+    constexpr operator uint8_t() const {
         return hours; //Return only hours
     }
 
-    hour_t& operator=(uint8_t val) {
+    DT_CONSTEXPR14 hour_t& operator=(uint8_t val) {
         if (is24_) {
             hours = val % 24;
         }
@@ -482,7 +724,7 @@ struct hour_t {
     /**
     * @brief Converts to 24 hour format.
     */
-    inline void convertTo24() {
+    DT_CONSTEXPR14 void convertTo24() {
         if (!is24_) {
             hours = (hours % 12) + 12 * (!isAM_);
             is24_ = false;
@@ -492,7 +734,7 @@ struct hour_t {
     /**
     * @brief Converts to 12 hour format.
     */
-    inline void convertTo12() {
+    DT_CONSTEXPR14 void convertTo12() {
         if (is24_) {
             isAM_ = hours < 12;
             hours = ((hours + 11) % 12) + 1;
@@ -511,15 +753,15 @@ private:
 * @brief Structure, which contains all date and time fields.
 */
 struct date_time_s {
-    date_time_s(){}
+    constexpr date_time_s(){}
 
-    date_time_s(int32_t year_, Month month_, uint8_t day_) :
+    constexpr date_time_s(int32_t year_, Month month_, uint8_t day_) :
         year(year_),
         month(month_),
         day(day_)
     {}
 
-    date_time_s(int32_t year_, Month month_, uint8_t day_, hour_t hours_, uint8_t minutes_ = 0, uint8_t seconds_ = 0, uint16_t milliseconds_ = 0, uint16_t microseconds_ = 0, DayOfWeek dayOfWeek_ = DayOfWeek::Unknown) :
+    constexpr date_time_s(int32_t year_, Month month_, uint8_t day_, hour_t hours_, uint8_t minutes_ = 0, uint8_t seconds_ = 0, uint16_t milliseconds_ = 0, uint16_t microseconds_ = 0, DayOfWeek dayOfWeek_ = DayOfWeek::Unknown) :
         year(year_),
         month(month_),
         day(day_),
@@ -547,15 +789,15 @@ struct date_time_s {
 * @brief Structure, which contains only date fields.
 */
 struct date_s {
-    date_s(){}
+    constexpr date_s(){}
 
-    date_s(int32_t year_, Month month_, uint8_t day_) :
+    constexpr date_s(int32_t year_, Month month_, uint8_t day_) :
         year(year_),
         month(month_),
         day(day_)
     {}
 
-    date_s(int32_t year_, Month month_, uint8_t day_, DayOfWeek dayOfWeek_) :
+    constexpr date_s(int32_t year_, Month month_, uint8_t day_, DayOfWeek dayOfWeek_) :
         year(year_),
         month(month_),
         day(day_),
@@ -573,9 +815,9 @@ struct date_s {
 * @brief Structure, which contains only time fields.
 */
 struct time_s {
-    time_s() {}
+    constexpr time_s() {}
 
-    time_s(hour_t hours_, uint8_t minutes_, uint8_t seconds_, uint16_t milliseconds_, uint16_t microseconds_) :
+    constexpr time_s(hour_t hours_, uint8_t minutes_, uint8_t seconds_, uint16_t milliseconds_, uint16_t microseconds_) :
         hours(hours_),
         minutes(minutes_),
         seconds(seconds_),
@@ -597,7 +839,7 @@ namespace dtlib {
     * @param year Year to check. Value can be from -5879609 to +5879610 except 0.
     * @return Returns true if year is leap year.
     */
-    inline bool isLeapYear(int32_t year) {
+    DT_CONSTEXPR14 bool isLeapYear(int32_t year) {
         if (year < 0) year++; //skip year 0 because it does not exist
         return (((year % 4) == 0 && ((year % 100) != 0)) || ((year % 400) == 0));
     }
@@ -607,7 +849,17 @@ namespace dtlib {
     * @param year Year, until which count of days will be calculated. Year can be in range from -5879609 to +5879610 except 0.
     * @return Returns count of days from the 1st Jan 0000 until specified year.
     */
+#ifndef DT_LEGACY_CALENDAR
+    DT_CONSTEXPR14 int32_t getDaysUntilYear(int32_t year) {
+        //Year shifted to positive values, year 0 is skipped for years BC
+        uint32_t y = (uint32_t)(year + (year < 0) - 1 + (int32_t)DT_CAL_SHIFT_YEARS);
+
+        //Divisions by constants are compiled as multiplication and shift
+        return (int32_t)(y * 365 + y / 4 - y / 100 + y / 400 - DT_CAL_SHIFT_DAYS);
+    }
+#else
     int32_t getDaysUntilYear(int32_t year);
+#endif // !DT_LEGACY_CALENDAR
 
     /**
     * @brief Gets year and days of year from elapsed days from first year (1st of January 0001).
@@ -687,19 +939,62 @@ namespace dtlib {
     * @endverbatim
     * One is added to year because there is no year 0
     *
-    * @param days Days elapsed from first year (1st of January 0001).
+    * ## Branch free calculation
+    * Calculation described above is used only when DT_LEGACY_CALENDAR is defined. By default, calculation
+    * based on Euclidean affine functions (C. Neri and L. Schneider, "Euclidean affine functions and their application
+    * to calendar algorithms") is used. Days are shifted to be always positive (by DT_CAL_SHIFT_DAYS) and year is
+    * counted from the 1st of March, so leap day is the last day of year. All divisions are then done by constants
+    * or replaced by multiplication and shift, which is much more faster, mainly on 32-bit MCUs. There is no branch.
+    * Result is the same as result of calculation described above for all days from range MIN_DAYS to MAX_DAYS, except
+    * the 31st of December of leap years BC (except year 1BC), which was returned as day 364 by old calculation.
+    *
+    * @param days Days elapsed from first year (1st of January 0001). Value can be in range from MIN_DAYS to MAX_DAYS.
     * @return Returns year and days of year.
     */
+#ifndef DT_LEGACY_CALENDAR
+    DT_CONSTEXPR14 year_day_tuple getYearFromDays(int32_t days) {
+        //Days elapsed from the 1st of March of shifted year 0
+        uint32_t n = (uint32_t)(days + (int32_t)(DT_CAL_MARCH_OFFSET + DT_CAL_SHIFT_DAYS));
+
+        uint32_t n1 = 4 * n + 3;
+        uint32_t centuries = n1 / 146097;
+        uint32_t n2 = (n1 % 146097) | 3;
+        uint64_t p2 = (uint64_t)2939745 * n2;
+        uint32_t yearOfCentury = (uint32_t)(p2 >> 32);
+        uint32_t dayOfMarchYear = (uint32_t)p2 / 2939745 / 4; //Day of year, where the 1st of March is day 0
+
+        uint32_t janFeb = dayOfMarchYear >= 306; //January or February belongs to next year
+        uint32_t y = centuries * 100 + yearOfCentury + janFeb;
+        uint32_t isLeap = (y & ((y % 100) != 0 ? 3 : 15)) == 0;
+
+        int32_t year = (int32_t)(y - DT_CAL_SHIFT_YEARS);
+        return year_day_tuple(year - (year <= 0), //Skip year 0
+            (uint16_t)(dayOfMarchYear + 59 + isLeap - janFeb * (365 + isLeap)));
+    }
+#else
     year_day_tuple getYearFromDays(int32_t days);
+#endif // !DT_LEGACY_CALENDAR
 
     /**
     * @brief Gets month and day of month from day of year. For example 43 => 13th of February.
-    * @note This version uses binary search, which is much more faster than linear search using loop.
+    * @note This version uses multiplication and shift instead of searching (binary search when DT_LEGACY_CALENDAR is defined).
     * @param day Day of year from range 0-364 and 0-365 for leap year. The 1st of January is day 0.
     * @param leapYear True if year is leap year.
     * @return Returns structure, which contains month from rage 1-12 and day of month from range 1-31/30/28.
     */
+#ifndef DT_LEGACY_CALENDAR
+    DT_CONSTEXPR14 month_day_tuple getMonthFromDayOfYear(uint16_t day, bool leapYear) {
+        //Moving day of year to start at the 1st of March
+        uint32_t march = 59 + leapYear;
+        uint32_t janFeb = day < march;
+        uint32_t dayOfMarchYear = day - march + janFeb * (365 + leapYear);
+
+        uint32_t n3 = dayOfMarchYear * 2141 + 197913;
+        return month_day_tuple((uint8_t)((n3 >> 16) - janFeb * 12), (uint8_t)((n3 & 0xFFFF) / 2141 + 1));
+    }
+#else
     month_day_tuple getMonthFromDayOfYear(uint16_t day, bool leapYear);
+#endif // !DT_LEGACY_CALENDAR
 
     /**
     * @brief Gets day of year of first month day.
@@ -707,7 +1002,50 @@ namespace dtlib {
     * @param leapYear True if year is leap year.
     * @return Returns day of year of first month day. Value can be in range 0-364 and 0-365 for leap years. The 1st of January is day 0.
     */
+#ifndef DT_LEGACY_CALENDAR
+    DT_CONSTEXPR14 uint16_t getDayOfYearFromMonth(Month month, bool leapYear) {
+        //Value limit - for sure
+        uint32_t m = ((uint8_t)(month - 1) > 11) ? 12 : (uint8_t)month;
+
+        //Months are counted from March, January and February are 13th and 14th month
+        uint32_t janFeb = m < 3;
+        uint32_t dayOfMarchYear = ((m + janFeb * 12) * 979 - 2918) >> 5;
+        return (uint16_t)(dayOfMarchYear + 59 + leapYear - janFeb * (365 + leapYear));
+    }
+#else
     uint16_t getDayOfYearFromMonth(Month month, bool leapYear);
+#endif // !DT_LEGACY_CALENDAR
+
+    /**
+    * @brief Gets date from elapsed days from first year (1st of January 0001).
+    * @note This function is faster than calling getYearFromDays() and getMonthFromDayOfYear().
+    * @param days Days elapsed from first year (1st of January 0001). Value can be in range from MIN_DAYS to MAX_DAYS.
+    * @return Returns date structure including day of week.
+    */
+#ifndef DT_LEGACY_CALENDAR
+    DT_CONSTEXPR14 date_s getDateFromDays(int32_t days) {
+        //Days elapsed from the 1st of March of shifted year 0
+        uint32_t n = (uint32_t)(days + (int32_t)(DT_CAL_MARCH_OFFSET + DT_CAL_SHIFT_DAYS));
+
+        uint32_t n1 = 4 * n + 3;
+        uint32_t centuries = n1 / 146097;
+        uint32_t n2 = (n1 % 146097) | 3;
+        uint64_t p2 = (uint64_t)2939745 * n2;
+        uint32_t yearOfCentury = (uint32_t)(p2 >> 32);
+        uint32_t dayOfMarchYear = (uint32_t)p2 / 2939745 / 4;
+
+        uint32_t n3 = dayOfMarchYear * 2141 + 197913;
+        uint32_t janFeb = dayOfMarchYear >= 306;
+
+        int32_t year = (int32_t)(centuries * 100 + yearOfCentury + janFeb - DT_CAL_SHIFT_YEARS);
+        return date_s(year - (year <= 0), //Skip year 0
+            (uint8_t)((n3 >> 16) - janFeb * 12),
+            (uint8_t)((n3 & 0xFFFF) / 2141 + 1),
+            (uint8_t)((n - DT_CAL_MARCH_OFFSET + 1) % 7 + 1)); //DT_CAL_SHIFT_DAYS is divisible by 7
+    }
+#else
+    date_s getDateFromDays(int32_t days);
+#endif // !DT_LEGACY_CALENDAR
 
 
 
@@ -718,14 +1056,66 @@ namespace dtlib {
     * @param raw Raw value of microseconds since year 1 (start of calendar). This value can be also negative, which means years BC.
     * @return Returns date time structure.
     */
-    date_time_s rawToDateTime(int64_t raw);
+    DT_CAL_CONSTEXPR date_time_s rawToDateTime(int64_t raw) {
+        date_time_s time;
+
+        int32_t days = 0;
+        int64_t micr = 0; //Remaining microseconds
+        //calculate days from microseconds
+        bool neg = raw < 0;
+        if (neg) {
+            raw++;
+            days = (int32_t)((raw / DAY) - 1);
+            micr = DAY + (raw % DAY) - 1;
+        }
+        else {
+            days = (int32_t)(raw / DAY);
+            micr = raw % DAY;
+        }
+
+        //Time calculation
+        time.hours.setHours24((uint8_t)(micr / HOUR));
+        micr = micr % HOUR;
+        time.minutes = (uint8_t)(micr / MINUTE);
+        int32_t micr32 = micr % MINUTE; //Using micr32 as int32_t to calculate using 32 bit arithmetic
+        time.seconds = (uint8_t)(micr32 / SECOND);
+        micr32 = micr32 % SECOND;
+        time.milliseconds = (uint16_t)(micr32 / MILLISECOND);
+        micr32 = micr32 % MILLISECOND;
+        time.microseconds = micr32;
+
+        //Date calculation
+        date_s date = getDateFromDays(days);
+        time.year = date.year;
+        time.month = date.month;
+        time.day = date.day;
+        time.dayOfWeek = date.dayOfWeek;
+        return time;
+    }
 
     /**
     * @brief Converts date time structure to raw value.
-    * @param dateTime Date time structure with valid values. dayOfWeek field is ignored.
+    * @param time Date time structure with valid values. dayOfWeek field is ignored.
     * @return Returns raw value of microseconds since year 1 (start of calendar). This value can be also negative, which means years BC.
     */
-    int64_t dateTimeToRaw(date_time_s dateTime);
+    DT_CAL_CONSTEXPR int64_t dateTimeToRaw(date_time_s time) {
+        //Time calculation
+        int32_t raw32 = time.microseconds * MICROSECOND;
+        raw32 += time.milliseconds * MILLISECOND;
+        raw32 += time.seconds * SECOND;
+        int64_t raw = time.minutes * MINUTE;
+        time.hours.convertTo24(); //Converting to 24 hour format.
+        raw += time.hours * HOUR;
+        raw += raw32;
+
+        //Date calculation
+        int32_t days = (time.day - 1);
+        days += getDayOfYearFromMonth(time.month, isLeapYear(time.year));
+        days += getDaysUntilYear(time.year);
+        raw += days * DAY;
+
+        return raw;
+    }
 
     /**
     * @brief Converts raw value to date structure.
@@ -733,7 +1123,20 @@ namespace dtlib {
     * @param raw Raw value of microseconds since year 1 (start of calendar). This value can be also negative, which means years BC.
     * @return Returns date structure.
     */
-    date_s rawToDate(int64_t raw);
+    DT_CAL_CONSTEXPR date_s rawToDate(int64_t raw) {
+        int32_t days = 0;
+        bool neg = raw < 0;
+        if (neg) {
+            raw++;
+            days = (int32_t)((raw / DAY) - 1);
+        }
+        else {
+            days = (int32_t)(raw / DAY);
+        }
+
+        //Date calculation
+        return getDateFromDays(days);
+    }
 
     /**
     * @brief Converts date structure to raw value.
@@ -741,14 +1144,30 @@ namespace dtlib {
     * @param date Date structure with valid values. dayOfWeek field is ignored.
     * @return Returns raw value of microseconds since year 1 (start of calendar). This value can be also negative, which means years BC.
     */
-    int64_t dateToRaw(date_s date);
+    DT_CAL_CONSTEXPR int64_t dateToRaw(date_s date) {
+        //Date calculation
+        int32_t days = (date.day - 1);
+        days += getDayOfYearFromMonth(date.month, isLeapYear(date.year));
+        days += getDaysUntilYear(date.year);
+        return ((int64_t)days) * DAY;
+    }
+
+    DT_CONSTEXPR14 int64_t getMicrosOfDayFromRaw(int64_t raw); //Defined below
 
     /**
     * @brief Converts date structure to raw value. Time fields are kept.
     * @param date Date structure with valid values. dayOfWeek field is ignored.
     * @return Returns raw value of microseconds since year 1 (start of calendar). This value can be also negative, which means years BC.
     */
-    void setDateToRaw(int64_t& raw, date_s date);
+    DT_CAL_CONSTEXPR void setDateToRaw(int64_t& raw, date_s date) {
+        int64_t rem_micr = getMicrosOfDayFromRaw(raw);
+
+        int32_t days = (date.day - 1);
+        days += getDayOfYearFromMonth(date.month, isLeapYear(date.year));
+        days += getDaysUntilYear(date.year);
+
+        raw = rem_micr + ((int64_t)days) * DAY;
+    }
 
     /**
     * @brief Converts raw value to time structure.
@@ -756,7 +1175,33 @@ namespace dtlib {
     * @param raw Raw value of microseconds since year 1 (start of calendar). This value can be also negative, which means years BC.
     * @return Returns time structure.
     */
-    time_s rawToTime(int64_t raw);
+    DT_CONSTEXPR14 time_s rawToTime(int64_t raw) {
+        time_s time;
+
+        int64_t micr = 0; //Remaining microseconds
+        //calculate days from microseconds
+        bool neg = raw < 0;
+        if (neg) {
+            raw++;
+            micr = DAY + (raw % DAY) - 1;
+        }
+        else {
+            micr = raw % DAY;
+        }
+
+        //Time calculation
+        time.hours.setHours24((uint8_t)(micr / HOUR));
+        micr = micr % HOUR;
+        time.minutes = (uint8_t)(micr / MINUTE);
+        int32_t micr32 = micr % MINUTE; //Using micr32 as int32_t to calculate using 32 bit arithmetic
+        time.seconds = (uint8_t)(micr32 / SECOND);
+        micr32 = micr32 % SECOND;
+        time.milliseconds = (uint16_t)(micr32 / MILLISECOND);
+        micr32 = micr32 % MILLISECOND;
+        time.microseconds = micr32;
+
+        return time;
+    }
 
     /**
     * @brief Converts time structure to raw value.
@@ -764,14 +1209,34 @@ namespace dtlib {
     * @param time Time structure with valid values. dayOfWeek field is ignored.
     * @return Returns raw value of microseconds since year 1 (start of calendar). This value can be also negative, which means years BC.
     */
-    int64_t timeToRaw(time_s time);
+    DT_CONSTEXPR14 int64_t timeToRaw(time_s time) {
+        int32_t raw32 = time.microseconds * MICROSECOND;
+        raw32 += time.milliseconds * MILLISECOND;
+        raw32 += time.seconds * SECOND;
+        int64_t raw = time.minutes * MINUTE;
+        time.hours.convertTo24(); //Converting to 24 hour format
+        raw += time.hours * HOUR;
+        raw += raw32;
+        return raw;
+    }
 
     /**
     * @brief Converts time structure to raw value. Date fields are kept.
     * @param time Time structure with valid values. dayOfWeek field is ignored.
     * @return Returns raw value of microseconds since year 1 (start of calendar). This value can be also negative, which means years BC.
     */
-    void setTimeToRaw(int64_t& raw, time_s time);
+    DT_CONSTEXPR14 void setTimeToRaw(int64_t& raw, time_s time) {
+        raw -= getMicrosOfDayFromRaw(raw); //Setting microseconds of year to 0
+
+        //Calculating new microseconds of year
+        int32_t raw32 = time.microseconds * MICROSECOND;
+        raw32 += time.milliseconds * MILLISECOND;
+        raw32 += time.seconds * SECOND;
+        raw += time.minutes * MINUTE;
+        time.hours.convertTo24(); //Converting to 24 hour format
+        raw += time.hours * HOUR;
+        raw += raw32;
+    }
 
 
 
@@ -784,7 +1249,19 @@ namespace dtlib {
     * @param raw Raw value of microseconds since year 1 (start of calendar). This value can be also negative, which means years BC.
     * @return Returns hours field value in range from 0 to 23.
     */
-    hour_t getHoursFromRaw(int64_t raw);
+    DT_CONSTEXPR14 hour_t getHoursFromRaw(int64_t raw) {
+        int64_t micr = 0; //Remaining microseconds
+        bool neg = raw < 0;
+        if (neg) {
+            raw++;
+            micr = DAY + (raw % DAY) - 1;
+        }
+        else {
+            micr = raw % DAY;
+        }
+
+        return hour_t((uint8_t)(micr / HOUR));
+    }
 
     /**
     * @brief Sets new hours field value to raw value.
@@ -793,7 +1270,19 @@ namespace dtlib {
     * @param[in,out] raw Raw value of microseconds since year 1 (start of calendar). This value can be also negative, which means years BC.
     * @param val New value to set. Value can be in range from 0 to 23.
     */
-    void setHoursToRaw(int64_t& raw, hour_t val);
+    DT_CONSTEXPR14 void setHoursToRaw(int64_t& raw, hour_t val) {
+        int64_t micr = 0; //Remaining microseconds
+        bool neg = raw < 0;
+        if (neg) {
+            micr = DAY + ((raw + 1) % DAY) - 1;
+        }
+        else {
+            micr = raw % DAY;
+        }
+        int8_t hours = (int8_t)(micr / HOUR);
+        val.convertTo24(); //Converting to 24 hour format
+        raw -= ((int64_t)(hours - (int8_t)val)) * HOUR;
+    }
 
     /**
     * @brief Adds hours to raw value.
@@ -801,7 +1290,7 @@ namespace dtlib {
     * @param[in,out] raw Raw value of microseconds since year 1 (start of calendar). This value can be also negative, which means years BC.
     * @param val Value to add. This value can be also negative, which means, that it will be subtracted.
     */
-    inline void addHoursToRaw(int64_t& raw, int32_t val) {
+    DT_CONSTEXPR14 void addHoursToRaw(int64_t& raw, int32_t val) {
         raw += (int64_t)val * HOUR;
     }
 
@@ -811,7 +1300,7 @@ namespace dtlib {
     * @param[in,out] raw Raw value of microseconds since year 1 (start of calendar). This value can be also negative, which means years BC.
     * @param val Value to add. This value can be also negative, which means, that it will be subtracted.
     */
-    inline void addHoursToRaw(int64_t& raw, int64_t val) {
+    DT_CONSTEXPR14 void addHoursToRaw(int64_t& raw, int64_t val) {
         raw += val * HOUR;
     }
 
@@ -822,7 +1311,19 @@ namespace dtlib {
     * @param raw Raw value of microseconds since year 1 (start of calendar). This value can be also negative, which means years BC.
     * @return Returns minutes field value in range from 0 to 59.
     */
-    uint8_t getMinutesFromRaw(int64_t raw);
+    DT_CONSTEXPR14 uint8_t getMinutesFromRaw(int64_t raw) {
+        int64_t micr = 0; //Remaining microseconds
+        bool neg = raw < 0;
+        if (neg) {
+            raw++;
+            micr = HOUR + (raw % HOUR) - 1;
+        }
+        else {
+            micr = raw % HOUR;
+        }
+
+        return (uint8_t)(micr / MINUTE);
+    }
 
     /**
     * @brief Sets minute field value to raw value.
@@ -831,7 +1332,18 @@ namespace dtlib {
     * @param[in,out] raw Raw value of microseconds since year 1 (start of calendar). This value can be also negative, which means years BC.
     * @param val New value to set. Value can be in range from 0 to 59.
     */
-    void setMinutesToRaw(int64_t& raw, uint8_t val);
+    DT_CONSTEXPR14 void setMinutesToRaw(int64_t& raw, uint8_t val) {
+        int64_t micr = 0; //Remaining microseconds
+        bool neg = raw < 0;
+        if (neg) {
+            micr = HOUR + ((raw + 1) % HOUR) - 1;
+        }
+        else {
+            micr = raw % HOUR;
+        }
+        int8_t min = (int8_t)(micr / MINUTE);
+        raw -= ((int64_t)(min - (int8_t)val)) * MINUTE;
+    }
 
     /**
     * @brief Adds minutes to raw value.
@@ -839,7 +1351,7 @@ namespace dtlib {
     * @param[in,out] raw Raw value of microseconds since year 1 (start of calendar). This value can be also negative, which means years BC.
     * @param val Value to add. This value can be also negative, which means, that it will be subtracted.
     */
-    inline void addMinutesToRaw(int64_t& raw, int32_t val) {
+    DT_CONSTEXPR14 void addMinutesToRaw(int64_t& raw, int32_t val) {
         raw += (int64_t)val * MINUTE;
     }
 
@@ -849,7 +1361,7 @@ namespace dtlib {
     * @param[in,out] raw Raw value of microseconds since year 1 (start of calendar). This value can be also negative, which means years BC.
     * @param val Value to add. This value can be also negative, which means, that it will be subtracted.
     */
-    inline void addMinutesToRaw(int64_t& raw, int64_t val) {
+    DT_CONSTEXPR14 void addMinutesToRaw(int64_t& raw, int64_t val) {
         raw += val * MINUTE;
     }
 
@@ -860,7 +1372,19 @@ namespace dtlib {
     * @param raw Raw value of microseconds since year 1 (start of calendar). This value can be also negative, which means years BC.
     * @return Returns seconds field value in range from 0 to 59.
     */
-    uint8_t getSecondsFromRaw(int64_t raw);
+    DT_CONSTEXPR14 uint8_t getSecondsFromRaw(int64_t raw) {
+        int32_t micr = 0; //Remaining microseconds
+        bool neg = raw < 0;
+        if (neg) {
+            raw++;
+            micr = MINUTE + (raw % MINUTE) - 1;
+        }
+        else {
+            micr = raw % MINUTE;
+        }
+
+        return (uint8_t)(micr / SECOND);
+    }
 
     /**
     * @brief Sets seconds field value to raw value.
@@ -869,7 +1393,18 @@ namespace dtlib {
     * @param[in,out] raw Raw value of microseconds since year 1 (start of calendar). This value can be also negative, which means years BC.
     * @param val New value to set. Value can be in range from 0 to 59.
     */
-    void setSecondsToRaw(int64_t& raw, uint8_t val);
+    DT_CONSTEXPR14 void setSecondsToRaw(int64_t& raw, uint8_t val) {
+        int64_t micr = 0; //Remaining microseconds
+        bool neg = raw < 0;
+        if (neg) {
+            micr = MINUTE + ((raw + 1) % MINUTE) - 1;
+        }
+        else {
+            micr = raw % MINUTE;
+        }
+        int8_t sec = (int8_t)(micr / SECOND);
+        raw -= ((int64_t)(sec - (int8_t)val)) * SECOND;
+    }
 
     /**
     * @brief Adds seconds to raw value.
@@ -877,7 +1412,7 @@ namespace dtlib {
     * @param[in,out] raw Raw value of microseconds since year 1 (start of calendar). This value can be also negative, which means years BC.
     * @param val Value to add. This value can be also negative, which means, that it will be subtracted.
     */
-    inline void addSecondsToRaw(int64_t& raw, int32_t val) {
+    DT_CONSTEXPR14 void addSecondsToRaw(int64_t& raw, int32_t val) {
         raw += (int64_t)val * SECOND;
     }
 
@@ -887,7 +1422,7 @@ namespace dtlib {
     * @param[in,out] raw Raw value of microseconds since year 1 (start of calendar). This value can be also negative, which means years BC.
     * @param val Value to add. This value can be also negative, which means, that it will be subtracted.
     */
-    inline void addSecondsToRaw(int64_t& raw, int64_t val) {
+    DT_CONSTEXPR14 void addSecondsToRaw(int64_t& raw, int64_t val) {
         raw += val * SECOND;
     }
 
@@ -898,7 +1433,19 @@ namespace dtlib {
     * @param raw Raw value of microseconds since year 1 (start of calendar). This value can be also negative, which means years BC.
     * @return Returns milliseconds field value in range from 0 to 999.
     */
-    uint16_t getMillisFromRaw(int64_t raw);
+    DT_CONSTEXPR14 uint16_t getMillisFromRaw(int64_t raw) {
+        int32_t micr = 0; //Remaining microseconds
+        bool neg = raw < 0;
+        if (neg) {
+            raw++;
+            micr = SECOND + (raw % SECOND) - 1;
+        }
+        else {
+            micr = raw % SECOND;
+        }
+
+        return (uint16_t)(micr / MILLISECOND);
+    }
 
     /**
     * @brief Sets milliseconds field value to raw value.
@@ -907,7 +1454,18 @@ namespace dtlib {
     * @param[in,out] raw Raw value of microseconds since year 1 (start of calendar). This value can be also negative, which means years BC.
     * @param val New value to set. Value can be in range from 0 to 999.
     */
-    void setMillisToRaw(int64_t& raw, uint16_t val);
+    DT_CONSTEXPR14 void setMillisToRaw(int64_t& raw, uint16_t val) {
+        int64_t micr = 0; //Remaining microseconds
+        bool neg = raw < 0;
+        if (neg) {
+            micr = SECOND + ((raw + 1) % SECOND) - 1;
+        }
+        else {
+            micr = raw % SECOND;
+        }
+        int16_t mils = (int16_t)(micr / MILLISECOND);
+        raw -= ((int64_t)(mils - (int16_t)val)) * MILLISECOND;
+    }
 
     /**
     * @brief Adds milliseconds to raw value.
@@ -915,7 +1473,7 @@ namespace dtlib {
     * @param[in,out] raw Raw value of microseconds since year 1 (start of calendar). This value can be also negative, which means years BC.
     * @param val Value to add. This value can be also negative, which means, that it will be subtracted.
     */
-    inline void addMillisToRaw(int64_t& raw, int32_t val) {
+    DT_CONSTEXPR14 void addMillisToRaw(int64_t& raw, int32_t val) {
         raw += (int64_t)val * MILLISECOND;
     }
 
@@ -925,7 +1483,7 @@ namespace dtlib {
     * @param[in,out] raw Raw value of microseconds since year 1 (start of calendar). This value can be also negative, which means years BC.
     * @param val Value to add. This value can be also negative, which means, that it will be subtracted.
     */
-    inline void addMillisToRaw(int64_t& raw, int64_t val) {
+    DT_CONSTEXPR14 void addMillisToRaw(int64_t& raw, int64_t val) {
         raw += val * MILLISECOND;
     }
 
@@ -936,7 +1494,19 @@ namespace dtlib {
     * @param raw Raw value of microseconds since year 1 (start of calendar). This value can be also negative, which means years BC.
     * @return Returns microseconds field value in range from 0 to 999.
     */
-    uint16_t getMicrosFromRaw(int64_t raw);
+    DT_CONSTEXPR14 uint16_t getMicrosFromRaw(int64_t raw) {
+        int32_t micr = 0; //Remaining microseconds
+        bool neg = raw < 0;
+        if (neg) {
+            raw++;
+            micr = MILLISECOND + (raw % MILLISECOND) - 1;
+        }
+        else {
+            micr = raw % MILLISECOND;
+        }
+
+        return micr / MICROSECOND;
+    }
 
     /**
     * @brief Sets microseconds field value to raw value.
@@ -945,7 +1515,17 @@ namespace dtlib {
     * @param[in,out] raw Raw value of microseconds since year 1 (start of calendar). This value can be also negative, which means years BC.
     * @param val New value to set. Value can be in range from 0 to 999.
     */
-    void setMicrosToRaw(int64_t& raw, uint16_t val);
+    DT_CONSTEXPR14 void setMicrosToRaw(int64_t& raw, uint16_t val) {
+        bool neg = raw < 0;
+        if (neg) {
+            int64_t rem1 = (raw + 1) % MILLISECOND - 1;
+            raw = raw - rem1 - (MILLISECOND - val);
+        }
+        else {
+            int64_t rem1 = raw % MILLISECOND;
+            raw = raw - rem1 + val;
+        }
+    }
 
     /**
     * @brief Adds microseconds to raw value.
@@ -953,7 +1533,7 @@ namespace dtlib {
     * @param[in,out] raw Raw value of microseconds since year 1 (start of calendar). This value can be also negative, which means years BC.
     * @param val Value to add. This value can be also negative, which means, that it will be subtracted.
     */
-    inline void addMicrosToRaw(int64_t& raw, int32_t val) {
+    DT_CONSTEXPR14 void addMicrosToRaw(int64_t& raw, int32_t val) {
         raw += val;
     }
 
@@ -963,7 +1543,7 @@ namespace dtlib {
     * @param[in,out] raw Raw value of microseconds since year 1 (start of calendar). This value can be also negative, which means years BC.
     * @param val Value to add. This value can be also negative, which means, that it will be subtracted.
     */
-    inline void addMicrosToRaw(int64_t& raw, int64_t val) {
+    DT_CONSTEXPR14 void addMicrosToRaw(int64_t& raw, int64_t val) {
         raw += val * MICROSECOND;
     }
 
@@ -973,7 +1553,17 @@ namespace dtlib {
     * @return Returns count of days that elapsed from year 1 (calendar start). Value can be in range from MIN_DAYS to MAX_DAYS. It
     * can be also negative, which means, that current date is B.C.
     */
-    int32_t getDaysFromRaw(int64_t raw);
+    DT_CONSTEXPR14 int32_t getDaysFromRaw(int64_t raw) {
+        int32_t days = 0;
+        bool neg = raw < 0;
+        if (neg) {
+            days = (int32_t)(((raw + 1) / DAY) - 1);
+        }
+        else {
+            days = (int32_t)(raw / DAY);
+        }
+        return days;
+    }
 
     /**
     * @brief Sets days, that elapsed from start of the epoch..
@@ -981,7 +1571,18 @@ namespace dtlib {
     * @param val Count of days, that elapsed from from year 1 (calendar start). This value can be in range from MIN_DAYS to MAX_DAYS. It
     * can be also negative, which means, that current date is B.C.
     */
-    void setDaysToRaw(int64_t& raw, int32_t val);
+    DT_CONSTEXPR14 void setDaysToRaw(int64_t& raw, int32_t val) {
+        bool neg = raw < 0;
+        int64_t rem1 = 0;
+        if (neg) {
+            rem1 = (raw + 1) % DAY - 1;
+            raw = rem1 + ((int64_t)val) * DAY + DAY;
+        }
+        else {
+            rem1 = raw % DAY;
+            raw = rem1 + ((int64_t)val) * DAY;
+        }
+    }
 
     /**
     * @brief Adds days to raw value.
@@ -989,7 +1590,7 @@ namespace dtlib {
     * @param[in,out] raw Raw value of microseconds since year 1 (start of calendar). This value can be also negative, which means years BC.
     * @param val Value to add. This value can be also negative, which means, that it will be subtracted.
     */
-    inline void addDaysToRaw(int64_t& raw, int32_t val) {
+    DT_CONSTEXPR14 void addDaysToRaw(int64_t& raw, int32_t val) {
         raw += (int64_t)val * DAY;
     }
 
@@ -998,14 +1599,34 @@ namespace dtlib {
     * @param raw Raw value of microseconds since year 1 (start of calendar). This value can be also negative, which means years BC.
     * @return Returns count of microseconds, that elapsed since start of current year. This value can be in range from 0 to (DAY - 1).
     */
-    int64_t getMicrosOfDayFromRaw(int64_t raw);
+    DT_CONSTEXPR14 int64_t getMicrosOfDayFromRaw(int64_t raw) {
+        int64_t micr = 0;
+        bool neg = raw < 0;
+        if (neg) {
+            micr = DAY + ((raw + 1) % DAY) - 1;
+        }
+        else {
+            micr = raw % DAY;
+        }
+        return micr;
+    }
 
     /**
     * @brief Sets count of microseconds, that elapsed since start of current day.
     * @param[in,out] raw Raw value of microseconds since year 1 (start of calendar). This value can be also negative, which means years BC.
     * @param val Count of microseconds, that elapsed since start of current year. This value can be in range from 0 to (DAY - 1).
     */
-    void setMicrosOfDayToRaw(int64_t& raw, int64_t val);
+    DT_CONSTEXPR14 void setMicrosOfDayToRaw(int64_t& raw, int64_t val) {
+        int64_t micr = 0;
+        bool neg = raw < 0;
+        if (neg) {
+            micr = DAY + ((raw + 1) % DAY) - 1;
+        }
+        else {
+            micr = raw % DAY;
+        }
+        raw = raw - micr + val;
+    }
 
     /**
     * @brief Gets day of month or basically day.
@@ -1015,7 +1636,14 @@ namespace dtlib {
     * @param raw Raw value of microseconds since year 1 (start of calendar). This value can be also negative, which means years BC.
     * @return Returns day in range from 1 to 28/29/30/31.
     */
-    uint8_t getMonthDayFromRaw(int64_t raw);
+    DT_CAL_CONSTEXPR uint8_t getMonthDayFromRaw(int64_t raw) {
+        int32_t days = getDaysFromRaw(raw);
+
+        //Date calculation
+        year_day_tuple yd = getYearFromDays(days);
+        month_day_tuple md = getMonthFromDayOfYear(yd.dayOfYear, isLeapYear(yd.year));
+        return md.day;
+    }
 
     /**
     * @brief Sets day of month or basically day.
@@ -1026,7 +1654,24 @@ namespace dtlib {
     * @param val New value of day to be set. Value can be in range from 1 to 28/29/30/31. To get maximum value that can be set,
     * use getMonthLength() function.
     */
-    void setMonthDayToRaw(int64_t& raw, uint8_t val);
+    DT_CAL_CONSTEXPR void setMonthDayToRaw(int64_t& raw, uint8_t val) {
+        //Current values establishment
+        int32_t days = getDaysFromRaw(raw);
+        year_day_tuple yd = getYearFromDays(days);
+        bool isLeap = isLeapYear(yd.year);
+        month_day_tuple md = getMonthFromDayOfYear(yd.dayOfYear, isLeap);
+
+        //Maximum day limit
+        uint8_t maxDay = md.month.getMonthLength(isLeap);
+        if (val > maxDay) val = maxDay;
+        else if (val < 1) val = 1;
+
+        //Days difference calculation
+        int8_t val_dif = (int8_t)md.day - (int8_t)val;
+
+        //Applying difference
+        raw -= (int64_t)val_dif * DAY;
+    }
 
     /**
     * @brief Gets month.
@@ -1036,7 +1681,12 @@ namespace dtlib {
     * @param raw Raw value of microseconds since year 1 (start of calendar). This value can be also negative, which means years BC.
     * @return Returns month from raw value. Value can be in range from 1 to 12.
     */
-    Month getMonthFromRaw(int64_t raw);
+    DT_CAL_CONSTEXPR Month getMonthFromRaw(int64_t raw) {
+        int32_t days = getDaysFromRaw(raw);
+        year_day_tuple yd = getYearFromDays(days);
+        month_day_tuple md = getMonthFromDayOfYear(yd.dayOfYear, isLeapYear(yd.year));
+        return md.month;
+    }
 
     /**
     * @brief Sets month.
@@ -1046,7 +1696,28 @@ namespace dtlib {
     * @param[in,out] raw Raw value of microseconds since year 1 (start of calendar). This value can be also negative, which means years BC.
     * @param val New value of month to be set. Value can be in range from 1 to 12.
     */
-    void setMonthToRaw(int64_t& raw, Month val);
+    DT_CAL_CONSTEXPR void setMonthToRaw(int64_t& raw, Month val) {
+        //Limits
+        if (val < 1) val = 1;
+        else if (val > 12) val = 12;
+
+        //Current values establishment
+        int32_t days = getDaysFromRaw(raw);
+        year_day_tuple yd = getYearFromDays(days);
+        bool isLeap = isLeapYear(yd.year);
+        month_day_tuple md = getMonthFromDayOfYear(yd.dayOfYear, isLeap);
+
+        //Maximum day limit
+        uint8_t maxDay = val.getMonthLength(isLeap);
+        if (md.day > maxDay) md.day = maxDay;
+
+        //Days difference calculation
+        int16_t newDayOfYear = getDayOfYearFromMonth(val, isLeap) + md.day - 1; //New day of year, which need to be set
+        int16_t oldDayOfYear = yd.dayOfYear; //Old day of year
+        int16_t dayDifference = oldDayOfYear - newDayOfYear;
+
+        raw -= (int64_t)dayDifference * DAY;
+    }
 
     /**
     * @brief Adds count of months to raw value. This function calculates the resulting month and year, taking into account leap years and
@@ -1055,7 +1726,50 @@ namespace dtlib {
     * @param[in,out] raw Raw value of microseconds since year 1 (start of calendar). This value can be also negative, which means years BC.
     * @param val Value to add. This value can be also negative, which means, that it will be subtracted.
     */
-    void addMonthsToRaw(int64_t& raw, int32_t val);
+    DT_CAL_CONSTEXPR void addMonthsToRaw(int64_t& raw, int32_t val) {
+        int32_t days = 0;
+        int64_t micr = 0; //Remaining microseconds
+        //calculate days from microseconds
+        bool neg = raw < 0;
+        if (neg) {
+            raw++;
+            days = (int32_t)((raw / DAY) - 1);
+            micr = DAY + (raw % DAY) - 1;
+        }
+        else {
+            days = (int32_t)(raw / DAY);
+            micr = raw % DAY;
+        }
+
+        //Date calculation
+        year_day_tuple yd = getYearFromDays(days);
+        month_day_tuple md = getMonthFromDayOfYear(yd.dayOfYear, isLeapYear(yd.year));
+        int32_t newMonthDiff = md.month - 1 + val;
+        int32_t yearDiff = newMonthDiff / 12;
+        newMonthDiff %= 12;
+        if (newMonthDiff < 0) {
+            newMonthDiff = 12 + newMonthDiff; //Negative
+        }
+        else {
+            newMonthDiff++;
+        }
+
+        int32_t newYearVal = yearDiff + yd.year; //Getting new year
+        if (newYearVal <= 0 && yd.year > 0) newYearVal--; //Skip year 0
+        else if (newYearVal >= 0 && yd.year < 0) newYearVal++; //Skip year 0
+
+        bool newIsLeap = isLeapYear(newYearVal);
+        uint8_t monthLength = Month::getMonthLength(newMonthDiff, newIsLeap);
+        if (md.day > monthLength) {
+            md.day = monthLength;
+        }
+
+        days = (md.day - 1);
+        days += getDayOfYearFromMonth(newMonthDiff, newIsLeap);
+        days += getDaysUntilYear(newYearVal);
+
+        raw = micr + ((int64_t)days) * DAY;
+    }
 
     /**
     * @brief Gets year.
@@ -1066,7 +1780,7 @@ namespace dtlib {
     * @return Returns year from raw value. Value can be in range from MIN_YEAR to MAX_YEAR except 0, because year 0 does not exists. Value
     * can be also negative, which means, that this is year BC.
     */
-    inline int32_t getYearFromRaw(int64_t raw) {
+    DT_CAL_CONSTEXPR int32_t getYearFromRaw(int64_t raw) {
         int32_t days = getDaysFromRaw(raw);
         year_day_tuple yd = getYearFromDays(days);
         return yd.year;
@@ -1081,7 +1795,31 @@ namespace dtlib {
     * @param val New value of year to be set. Value can be in range from MIN_YEAR to MAX_YEAR except 0, because year 0 does not exists. Value
     * can be also negative, which means, that this is year BC.
     */
-    void setYearToRaw(int64_t& raw, int32_t val);
+    DT_CAL_CONSTEXPR void setYearToRaw(int64_t& raw, int32_t val) {
+        //Current values establishment
+        int32_t days = getDaysFromRaw(raw);
+        year_day_tuple yd = getYearFromDays(days);
+        bool newIsLeap = isLeapYear(val);
+        bool oldIsLeap = isLeapYear(yd.year);
+
+        //Leap day offset, to keep same month and day of month values
+        if (newIsLeap != oldIsLeap) {
+            if (newIsLeap && yd.dayOfYear >= 59) {
+                yd.dayOfYear++;
+            }
+            else if (oldIsLeap && yd.dayOfYear >= 60) {
+                yd.dayOfYear--;
+            }
+        }
+
+        //Days difference calculation
+        int32_t newDays = getDaysUntilYear(val) + yd.dayOfYear;
+        int32_t oldDays = days;
+        int32_t dayDifference = oldDays - newDays;
+
+        //Applying difference
+        raw -= (int64_t)dayDifference * DAY;
+    }
 
     /**
     * @brief Adds amount of years to raw value. Only year field is affected, others stays unchanged.
@@ -1089,14 +1827,45 @@ namespace dtlib {
     * @param[in,out] raw Raw value of microseconds since year 1 (start of calendar). This value can be also negative, which means years BC.
     * @param val Value to add. This value can be also negative, which means, that it will be subtracted.
     */
-    void addYearsToRaw(int64_t& raw, int32_t val);
+    DT_CAL_CONSTEXPR void addYearsToRaw(int64_t& raw, int32_t val) {
+        //Current values establishment
+        int32_t days = getDaysFromRaw(raw);
+        year_day_tuple yd = getYearFromDays(days);
+
+        //Calculation of new year value
+        int32_t newYearVal = val + yd.year; //Getting new year
+        if (newYearVal <= 0 && yd.year > 0) newYearVal--; //Skip year 0
+        else if (newYearVal >= 0 && yd.year < 0) newYearVal++; //Skip year 0
+
+        //Leap year check
+        bool newIsLeap = isLeapYear(newYearVal);
+        bool oldIsLeap = isLeapYear(yd.year);
+
+        //Leap day offset, to keep same month and day of month values
+        if (newIsLeap != oldIsLeap) {
+            if (newIsLeap && yd.dayOfYear >= 59) {
+                yd.dayOfYear++;
+            }
+            else if (oldIsLeap && yd.dayOfYear >= 60) {
+                yd.dayOfYear--;
+            }
+        }
+
+        //Days difference calculation
+        int32_t newDays = getDaysUntilYear(newYearVal) + yd.dayOfYear;
+        int32_t oldDays = days;
+        int32_t dayDifference = oldDays - newDays;
+
+        //Applying difference
+        raw -= (int64_t)dayDifference * DAY;
+    }
 
     /**
     * @brief Gets day of week from raw value.
     * @param raw Raw value of microseconds since year 1 (start of calendar). This value can be also negative, which means years BC.
     * @return Returns day of week, which is in range from 1 to 7. See enum DayOfWeek.
     */
-    inline DayOfWeek getDayOfWeekFromRaw(int64_t raw) {
+    DT_CONSTEXPR14 DayOfWeek getDayOfWeekFromRaw(int64_t raw) {
         int32_t days = getDaysFromRaw(raw);
         if (days < 0) {
             //BC
@@ -1114,7 +1883,24 @@ namespace dtlib {
     * @param firstDayOfWeek First day of week. In some countries week starts with Sunday, some with Monday.
     * @returns Week of the year from 1 to 52.
     */
-    uint8_t getWeekOfYearFromRaw(int64_t raw, DayOfWeek firstDayOfWeek);
+    DT_CAL_CONSTEXPR uint8_t getWeekOfYearFromRaw(int64_t raw, DayOfWeek firstDayOfWeek) {
+        //Current date info
+        int32_t days = getDaysFromRaw(raw);
+        year_day_tuple yd = getYearFromDays(days);
+        int32_t daysUntilFirstDayOfYear = days - yd.dayOfYear;
+
+        uint8_t dayOfWeekOffset = 0; //Day of week offset at first day of month
+        if (days < 0) {
+            //BC
+            dayOfWeekOffset = (7 + ((daysUntilFirstDayOfYear - 4 + (7 - firstDayOfWeek)) % 7));
+        }
+        else {
+            //AD
+            dayOfWeekOffset = (((daysUntilFirstDayOfYear + 9 - firstDayOfWeek) % 7) + 1);
+        }
+
+        return ((yd.dayOfYear + dayOfWeekOffset - 1) / 7) + 1;
+    }
 
     /**
     * @brief Gets week number of the month.
@@ -1134,7 +1920,29 @@ namespace dtlib {
     * @param firstDayOfWeek First day of week. In some countries week starts with Sunday, some with Monday.
     * @returns Week of the month from 1(first) to 6(sixth).
     */
-    uint8_t getWeekOfMonthFromRaw(int64_t raw, DayOfWeek firstDayOfWeek);
+    DT_CAL_CONSTEXPR uint8_t getWeekOfMonthFromRaw(int64_t raw, DayOfWeek firstDayOfWeek) {
+        //Current date info
+        int32_t days = getDaysFromRaw(raw);
+        year_day_tuple yd = getYearFromDays(days);
+        bool isLeap = isLeapYear(yd.year);
+        month_day_tuple md = getMonthFromDayOfYear(yd.dayOfYear, isLeap);
+
+        int32_t dayOfYearUntilMonth = getDayOfYearFromMonth(md.month, isLeap);
+        int32_t daysUntilFirstDayOfMonth = days - (yd.dayOfYear - dayOfYearUntilMonth);
+
+        uint8_t dayOfWeekOffset = 0; //Day of week offset at first day of month
+        if (daysUntilFirstDayOfMonth < 0) {
+            //BC
+            dayOfWeekOffset = (7 + ((daysUntilFirstDayOfMonth - 4 + (7 - firstDayOfWeek)) % 7));
+        }
+        else {
+            //AD
+            dayOfWeekOffset = (((daysUntilFirstDayOfMonth + 9 - firstDayOfWeek) % 7) + 1);
+        }
+
+        int8_t dayOfMonth = md.day + dayOfWeekOffset - 2; //zero based
+        return (dayOfMonth / 7) + 1;
+    }
 
     /**
     * @brief Gets week day of the month. So, it gets count of how many times was same day of week as today in current month.
@@ -1153,7 +1961,10 @@ namespace dtlib {
     * @param raw Raw value of microseconds since year 1 (start of calendar). This value can be also negative, which means years BC.
     * @returns Week day of the month from 1(first) to 5(fifth).
     */
-    uint8_t getWeekDayOfMonthFromRaw(int64_t raw);
+    DT_CAL_CONSTEXPR uint8_t getWeekDayOfMonthFromRaw(int64_t raw) {
+        uint8_t md = getMonthDayFromRaw(raw);
+        return ((md - 1) / 7) + 1;
+    }
 
 
     /**
@@ -1162,7 +1973,7 @@ namespace dtlib {
     * @return Returns count of days, that elapsed from first day in current year. This value can be in range from 0 to 364 for basic years
     * and in range from 0 to 365 for leap years.
     */
-    inline uint16_t getDayOfYearFromRaw(int64_t raw) {
+    DT_CAL_CONSTEXPR uint16_t getDayOfYearFromRaw(int64_t raw) {
         int32_t days = getDaysFromRaw(raw);
         year_day_tuple yd = getYearFromDays(days);
         return yd.dayOfYear;
@@ -1174,7 +1985,22 @@ namespace dtlib {
     * @param val Count of days, that elapsed from first day in current year. This value can be in range from 0 to 364 for basic years
     * and in range from 0 to 365 for leap years.
     */
-    void setDayOfYearToRaw(int64_t& raw, uint32_t val);
+    DT_CAL_CONSTEXPR void setDayOfYearToRaw(int64_t& raw, uint32_t val) {
+        //Current values establishment
+        int32_t days = getDaysFromRaw(raw);
+        year_day_tuple yd = getYearFromDays(days);
+        bool isLeap = isLeapYear(yd.year);
+
+        //Limits check
+        if (isLeap && val > 365) val = 365;
+        else if (val > 364) val = 364;
+
+        //Days difference calculation
+        int32_t dayDifference = yd.dayOfYear - val;
+
+        //Applying difference
+        raw -= (int64_t)dayDifference * DAY;
+    }
 
     /**
     * @brief Converts positive integer with 1 or 2 digits to char array.
@@ -1212,6 +2038,21 @@ namespace dtlib {
     */
     char* ms_usFractToStr(char* buffer, size_t bufferSize, int32_t microseconds, int8_t width, bool strictWidth);
 
+    /**
+    * @brief Converts time zone or DST to string.
+    * @warning Null terminator is not inserted to the end of string.
+    * @param buffer Buffer, where string will be written.
+    * @param bufferSize Size of buffer without null terminator.
+    * @param val Time zone or DST offset in minutes.
+    * @param options There are 4 options:
+    * + 1 - Prints offset hours without leading zeros. Example: +07:00 => +7
+    * + 2 - Prints offset hours with leading zeros. Example: +07:00 => +07
+    * + 3 - Prints offset hours and minutes with leading zeros and separator ':'. Example: +07:00 => +07:00
+    * + 4 - Prints offset hours and minutes with leading zeros without separator. Example: +07:00 => +0700
+    * @return Returns pointer in buffer to new position after last digit.
+    */
+    char* tzToStr(char* buffer, size_t bufferSize, int16_t val, uint8_t options);
+
     /**
     * @brief Converts DateTime to string.
     * @param buffer Buffer, where string will be written.
@@ -1457,6 +2298,52 @@ namespace dtlib {
     */
     char* dateTimeToArray(char* buffer, size_t bufferSize, const char* format, date_s date, time_s time, int16_t timeZoneOffset = 0, int16_t DSTOffset = 0, const char* const* monthNames = NULL, const char* const* weekDayNames = NULL);
 
+    /**
+    * @enum ISOOffset
+    * @brief Specifies, how time zone offset is written by iso8601ToArray().
+    */
+    enum ISOOffset : uint8_t {
+        ISO_OFFSET_NONE = 0,    /**< Offset is not written. */
+        ISO_OFFSET_NUMERIC = 1, /**< Offset is always written as +hh:mm or -hh:mm. */
+        ISO_OFFSET_UTC_Z = 2    /**< Zero offset is written as 'Z', other offsets as +hh:mm or -hh:mm (RFC 3339). */
+    };
+
+    /**
+    * @brief Converts date and time fields to ISO 8601 string, for example 2009-06-15T13:45:30.123456+02:00.
+    * All fields are written using two-digit lookup table, so result has fixed width and no per-character branching is used.
+    * Years from 0001 to 9999 are written as four digits, other years are written in expanded form with sign and six digits
+    * using astronomical year numbering (1 BC is +000000, 2 BC is -000001).
+    * @note Fraction of second is truncated, not rounded, so it never overflows to seconds. For years from 0001 to 9999
+    * result is the same as result of dateTimeToArray() with format "yyyy-MM-ddTHH:mm:ss.ffffffZZZ" (with 6 fraction digits).
+    * @param buffer Buffer, where string will be written.
+    * @param bufferSize Size of buffer including null terminator. If it is smaller than ISO8601_MAX_LENGTH + 1, string is truncated.
+    * @param year Year from MIN_YEAR to MAX_YEAR except 0.
+    * @param month Month from 1 to 12.
+    * @param day Day of month from 1 to 31.
+    * @param hour Hour from 0 to 23.
+    * @param minute Minute from 0 to 59.
+    * @param second Second from 0 to 59.
+    * @param microsecond Microseconds of second from 0 to 999999.
+    * @param fractionDigits Count of written fraction digits from 0 to 6. If it is 0, fraction and decimal point are not written.
+    * @param offset Time zone offset (including DST offset) in minutes.
+    * @param offsetMode Specifies, how offset is written.
+    * @return Returns pointer to buffer, where null terminator was inserted.
+    */
+    char* iso8601ToArray(char* buffer, size_t bufferSize, int32_t year, uint8_t month, uint8_t day, uint8_t hour, uint8_t minute, uint8_t second, uint32_t microsecond, uint8_t fractionDigits = 6, int16_t offset = 0, ISOOffset offsetMode = ISO_OFFSET_NUMERIC);
+
+    /**
+    * @brief Converts raw date and time value to ISO 8601 string, for example 2009-06-15T13:45:30.123456+02:00.
+    * See iso8601ToArray() with date and time fields for details.
+    * @param buffer Buffer, where string will be written.
+    * @param bufferSize Size of buffer including null terminator. If it is smaller than ISO8601_MAX_LENGTH + 1, string is truncated.
+    * @param value Raw date and time value (microseconds since 1.1.0001) in local time.
+    * @param fractionDigits Count of written fraction digits from 0 to 6. If it is 0, fraction and decimal point are not written.
+    * @param offset Time zone offset (including DST offset) in minutes.
+    * @param offsetMode Specifies, how offset is written.
+    * @return Returns pointer to buffer, where null terminator was inserted.
+    */
+    char* iso8601ToArray(char* buffer, size_t bufferSize, int64_t value, uint8_t fractionDigits = 6, int16_t offset = 0, ISOOffset offsetMode = ISO_OFFSET_NUMERIC);
+
 
     /**
     * @brief Converts DateTime to string.
@@ -1710,6 +2597,562 @@ namespace dtlib {
     std::string dateTimeToString(const char* format, date_s date, time_s time, int16_t timeZoneOffset = 0, int16_t DSTOffset = 0, const char* const* monthNames = NULL, const char* const* weekDayNames = NULL);
     #endif // ARDUINO
 
+    /**
+    * @brief Parses unsigned number from string.
+    * @warning Null terminator is not inserted to the end of string.
+    * @param buffer Buffer, where string with number is located.
+    * @param bufferSize Size of buffer without null terminator.
+    * @param parsedValue Parsed unsigned integer value. If parsing failed, negative value is returned.
+    * @param expectedDigits Expected count of digits. If parameter exactDigCnt is true, exact digits count has to be found
+    * in string, else parsedValue will be false. If parameter exactDigCnt is false, parameter expectedDigits is maximum count of digits.
+    * @param exactDigCnt True, to fill with zeros until width parameter.
+    * @return Returns pointer in buffer to new position after last parsed digit.
+    */
+    DT_CONSTEXPR14 const char* parseNumber(const char* buffer, size_t bufferSize, int& parsedValue, uint8_t expectedDigits, bool exactDigCnt) {
+        if (bufferSize <= 0 || expectedDigits <= 0) {
+            parsedValue = -1;
+            return buffer;
+        }
+
+        parsedValue = 0;
+        bool firstFound = false;
+        while (expectedDigits > 0 && bufferSize > 0) {
+            char c = *buffer;
+            if (c >= '0' && c <= '9') { //Number found
+                parsedValue *= 10;
+                parsedValue += c - '0';
+                firstFound = true;
+            }
+            else { //Non number character found
+                if (exactDigCnt) {
+                    //expectedDigits is exact count of digits
+                    if (expectedDigits > 0) {
+                        parsedValue = -1; //Parsing error, unexpected character
+                        return buffer;
+                    }
+                }
+                else {
+                    //expectedDigits is maximum count of digits
+                    if (!firstFound) parsedValue = -1;
+                    return buffer;
+                }
+            }
+            buffer++;
+            bufferSize--;
+            expectedDigits--;
+        }
+        if (!firstFound || (exactDigCnt && expectedDigits > 0)) {
+            parsedValue = -1; //Parsing error, unexpected character
+        }
+        return buffer;
+    }
+
+    /**
+    * @brief Converts char to lower variant
+    */
+    DT_CONSTEXPR14 char toLowerChar(char c) {
+        if (c >= 'A' && c <= 'Z') return c + 32;
+        else return c;
+    }
+
+    /**
+    * @struct parse_state_s
+    * @brief Values parsed by parseDateTime() or DateTimeParser, which are shared by all specifiers of parsed string.
+    */
+    struct parse_state_s {
+        date_time_s value;
+        int16_t timeZoneOffset = 0;
+        int16_t DSTOffset = 0;
+        int16_t TZandDSToffset = 0;
+        bool negativeYear = false;
+        bool isAM = false;
+    };
+
+    /**
+    * @enum ParseResult
+    * @brief Result of parsing of one format specifier.
+    */
+    enum ParseResult : uint8_t {
+        PARSE_HANDLED = 0,  /**< Specifier was parsed. */
+        PARSE_TEXT = 1,     /**< Character is not specifier, so it has to be skipped as text. */
+        PARSE_FAILED = 2    /**< Parsing failed at current position of buffer. */
+    };
+
+    /**
+    * @brief Parses one format specifier, see parseDateTime() for all specifiers.
+    * @param specifier Specifier character.
+    * @param count Count of repeated specifier characters.
+    * @param buffer Current position in parsed buffer. It is moved after parsed characters.
+    * @param bufferSize Remaining size of buffer. It is decreased by count of parsed characters.
+    * @param state Parsed values.
+    * @param monthNames Array with month names. This array has to contain exactly 12 strings.
+    * @return Returns result of parsing.
+    */
+    DT_CONSTEXPR14 ParseResult parseSpecifier(char specifier, int8_t count, const char*& buffer, int& bufferSize, parse_state_s& state, const char* const* monthNames) {
+        switch (specifier) {
+        case 'f': //Fraction
+        case 'F': {
+            int parsedVal = 0;
+            int digitsFound = 0;
+            int maxDigits = (specifier == 'f' && count < 6) ? count : 6;
+            while (bufferSize > 0) {
+                char c = *buffer;
+                if (c >= '0' && c <= '9') { //Number found
+                    if (digitsFound < maxDigits) { //Captre only firts 6 digits
+                        parsedVal *= 10;
+                        parsedVal += c - '0';
+                    }
+                    digitsFound++;
+                }
+                else { //Non number character found
+                    if (specifier == 'f' && digitsFound != count) {
+                        return PARSE_FAILED;
+                    }
+                    else {
+                        break;
+                    }
+                }
+                buffer++;
+                bufferSize--;
+            }
+
+            for (uint8_t i = digitsFound; i < 6; i++) {
+                parsedVal *= 10;
+            }
+
+            if (bufferSize <= 0 && specifier == 'f' && digitsFound != count) {
+                return PARSE_FAILED;
+            }
+
+            state.value.milliseconds = parsedVal / 1000;
+            state.value.microseconds = parsedVal % 1000;
+
+            break;
+        }
+
+        case 'G':
+        case 'g': // B.C. or A.C.
+            //B.C. or A.D. expected
+            if (*buffer == 'A' || *buffer == 'a') {
+                if (bufferSize >= 4 && buffer[1] == '.' && (buffer[2] == 'D' || buffer[2] == 'd') && buffer[3] == '.') {
+                    //A.D. or a.d. found
+                    state.negativeYear = false;
+                    bufferSize -= 4;
+                    buffer += 4;
+                }
+                else {
+                    return PARSE_FAILED;
+                }
+            }
+            else if (*buffer == 'B' || *buffer == 'b') {
+                if (bufferSize >= 4 && buffer[1] == '.' && (buffer[2] == 'C' || buffer[2] == 'c') && buffer[3] == '.') {
+                    //A.D. or a.d. found
+                    state.negativeYear = true;
+                    bufferSize -= 4;
+                    buffer += 4;
+                }
+                else {
+                    return PARSE_FAILED;
+                }
+            }
+            else {
+                if (specifier == 'g') {
+                    return PARSE_FAILED;
+                }
+                else {
+                    state.negativeYear = false;
+                }
+            }
+            break;
+
+        case 'N':
+        case 'n': // B.C. or A.C. represented by sign
+            if (specifier == 'n') {
+                //Plus or minus char excpted
+                if (*buffer == '+' || *buffer == '-') {
+                    state.negativeYear = *buffer == '-';
+                    bufferSize--;
+                    buffer++;
+                }
+                else {
+                    return PARSE_FAILED;
+                }
+            }
+            else {
+                //Minus or any other char excpted
+                if (*buffer == '+' || *buffer == '-') {
+                    state.negativeYear = *buffer == '-';
+                    bufferSize--;
+                    buffer++;
+                }
+                else {
+                    state.negativeYear = false;
+                }
+            }
+            break;
+        case 'l':  //DTS offset
+        case 'Z':  //Time zone and DST offset
+        case 'z': {//Time zone offset
+            int parsedVal1 = 0;
+            int parsedVal2 = 0;
+            const char* newBuffer = NULL;
+
+            bool minusFound = buffer[0] == '-';
+            if (minusFound || buffer[0] == '+') {
+                bufferSize--;
+                buffer++;
+                if (bufferSize < 1) {
+                    return PARSE_FAILED;
+                }
+            }
+
+            int offsVal = 0;
+            if (buffer[0] == 'z' || buffer[0] == 'Z') { //UTC time
+                offsVal = 0;
+                bufferSize--;
+                buffer++;
+            }
+            else {
+                if (count == 1 || count == 2) {
+                    newBuffer = parseNumber(buffer, bufferSize, parsedVal1, 2, count == 2);
+                    if (parsedVal1 < 0 || parsedVal1 > 14) {
+                        return PARSE_FAILED;
+                    }
+                }
+                else {
+                    newBuffer = parseNumber(buffer, bufferSize, parsedVal1, 2, false);
+                    if (parsedVal1 < 0 || parsedVal1 > 14) {
+                        return PARSE_FAILED;
+                    }
+                    bufferSize -= (int)(newBuffer - buffer);
+                    buffer = newBuffer;
+                    if (count == 3) {
+                        if (*buffer != ':') {
+                            return PARSE_FAILED;
+                        }
+                        bufferSize--;
+                        buffer++;
+                    }
+                    newBuffer = parseNumber(buffer, bufferSize, parsedVal2, 2, false);
+                    if (parsedVal2 < 0 || parsedVal1 > 59) {
+                        return PARSE_FAILED;
+                    }
+                }
+                offsVal = parsedVal1 * 60 + parsedVal2;
+                if (minusFound) offsVal = -offsVal;
+
+                bufferSize -= (int)(newBuffer - buffer);
+                buffer = newBuffer;
+            }
+
+            switch (specifier) {
+            case 'z': state.timeZoneOffset = offsVal; break;//Time zone offset
+            case 'Z': state.TZandDSToffset = offsVal; break;//Time zone and DST offset
+            case 'l': state.DSTOffset = offsVal; break;//DTS offset
+            }
+            break;
+        }
+        case 'd':   //day of month
+        case 'u':   //microseconds
+        case 'i':   //milliseconds
+        case 's':   //seconds
+        case 'm':   //minutes
+        case 'H':   //24-hour format
+        case 'h': {	//12-hour format
+            int parsedVal = 0;
+            const char* newBuffer = NULL;
+            bool ms_or_us = specifier == 'u' || specifier == 'i';
+            if (count == 1) {
+                //Unknown count of digits
+                newBuffer = parseNumber(buffer, bufferSize, parsedVal, ms_or_us ? 3 : 2, false);
+            }
+            else {
+                //Exact excepted count of digits
+                newBuffer = parseNumber(buffer, bufferSize, parsedVal, count, true);
+            }
+            bufferSize -= (int)(newBuffer - buffer);
+            if (parsedVal < 0 || (ms_or_us && parsedVal > 999) || (specifier == 'H' && parsedVal > 23) || (specifier == 'h' && (parsedVal > 12 || parsedVal < 1)) || (specifier == 'd' && (parsedVal > 31 || parsedVal < 1)) || parsedVal > 60) {
+                return PARSE_FAILED;
+            }
+            buffer = newBuffer;
+
+            switch (specifier) {
+            case 'd': state.value.day = parsedVal; break; //day of month
+            case 'u': state.value.microseconds = parsedVal; break; //microseconds
+            case 'i': state.value.milliseconds = parsedVal; break; //milliseconds
+            case 's': state.value.seconds = parsedVal; break; //seconds
+            case 'm': state.value.minutes = parsedVal; break; //minutes
+            case 'H': state.value.hours.setHours24(parsedVal); break; //24-hour format
+            case 'h': state.value.hours.setHours12(parsedVal, false); break; //12-hour format
+            }
+            break;
+        }
+        case 'M': //month
+            if (count == 1 || count == 2) {
+                int parsedVal = 0;
+                const char* newBuffer = NULL;
+                if (count == 1) {
+                    //Unknown count of digits
+                    newBuffer = parseNumber(buffer, bufferSize, parsedVal, 2, false);
+                }
+                else {
+                    //Exact excepted count of digits
+                    newBuffer = parseNumber(buffer, bufferSize, parsedVal, count, true);
+                }
+                bufferSize -= (int)(newBuffer - buffer);
+                if (parsedVal < 0) {
+                    bufferSize--; //Position of error is reported one character before the number
+                    return PARSE_FAILED;
+                }
+                else if (parsedVal < 1 || parsedVal > 12) {
+                    return PARSE_FAILED;
+                }
+                buffer = newBuffer;
+                state.value.month = parsedVal;
+            }
+            else if (count == 3) {
+                if (bufferSize < 3) {
+                    return PARSE_FAILED;
+                }
+                bool found = false;
+                for (uint8_t i = 0; i < 12; i++) {
+                    bool match = toLowerChar(monthNames[i][0]) == toLowerChar(buffer[0]) && toLowerChar(monthNames[i][1]) == toLowerChar(buffer[1]) && toLowerChar(monthNames[i][2]) == toLowerChar(buffer[2]);
+                    if (match) {
+                        found = true;
+                        state.value.month = i + 1;
+                        break;
+                    }
+                }
+                if (!found) {
+                    return PARSE_FAILED;
+                }
+                bufferSize -= 3;
+                buffer += 3;
+            }
+            else if (count == 4) {
+                bool found = false;
+                for (uint8_t i = 0; i < 12; i++) {
+                    uint8_t j = 0;
+                    for (; monthNames[i][j] != 0 && bufferSize > j && toLowerChar(monthNames[i][j]) == toLowerChar(buffer[j]); j++);
+                    bool match = monthNames[i][j] == 0;
+                    if (match) {
+                        found = true;
+                        state.value.month = i + 1;
+                        bufferSize -= j;
+                        buffer += j;
+                        break;
+                    }
+                }
+                if (!found) {
+                    return PARSE_FAILED;
+                }
+            }
+            break;
+        case 't': {//AM/PM
+            bool aFound = buffer[0] == 'A' || buffer[0] == 'a';
+            bool apFound = aFound || buffer[0] == 'P' || buffer[0] == 'p';
+            if (!apFound || bufferSize < 1) {
+                return PARSE_FAILED;
+            }
+            if (count == 2) {
+                if (bufferSize >= 2 && (buffer[1] == 'M' || buffer[1] == 'm')) {
+                    state.isAM = aFound;
+                }
+                else {
+                    return PARSE_FAILED;
+                }
+                buffer += 2;
+                bufferSize -= 2;
+            }
+            else {
+                state.isAM = aFound;
+                buffer++;
+                bufferSize--;
+            }
+        }
+                break;
+
+        case 'y': {	//year
+            int parsedVal = 0;
+            const char* newBuffer = NULL;
+            if (count == 1) {
+                //Unknown count of digits
+                newBuffer = parseNumber(buffer, bufferSize, parsedVal, 6, false);
+            }
+            else {
+                //Exact excepted count of digits
+                newBuffer = parseNumber(buffer, bufferSize, parsedVal, count, false);
+            }
+            bufferSize -= (int)(newBuffer - buffer);
+            if (parsedVal < 0) {
+                return PARSE_FAILED;
+            }
+            else if (count == 2 || count == 3) {
+                //Two or three digit year notation
+                parsedVal += 2000;
+            }
+            buffer = newBuffer;
+            state.value.year = parsedVal;
+            break;
+        }
+
+        default:
+            return PARSE_TEXT;
+        }
+        return PARSE_HANDLED;
+    }
+
+    /**
+    * @brief Checks, if character is format specifier handled by parseSpecifier().
+    */
+    DT_CONSTEXPR14 bool isParseSpecifier(char c) {
+        switch (c) {
+        case 'f': case 'F': case 'G': case 'g': case 'N': case 'n': case 'l': case 'Z': case 'z':
+        case 'd': case 'u': case 'i': case 's': case 'm': case 'H': case 'h': case 'M': case 't': case 'y':
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    /**
+    * @brief Skips text characters of format in parsed buffer.
+    * @param c Text character.
+    * @param count Count of repeated text characters.
+    * @param buffer Current position in parsed buffer. It is moved after skipped characters.
+    * @param bufferSize Remaining size of buffer. It is decreased by count of skipped characters.
+    * @param matchText True to exactly match text characters.
+    * @return Returns false, if parsing failed.
+    */
+    DT_CONSTEXPR14 bool parseText(char c, int8_t count, const char*& buffer, int& bufferSize, bool matchText) {
+        if (bufferSize < count) {
+            return false;
+        }
+        for (; count > 0; count--) {
+            if (*buffer == '\0' || (matchText && *buffer != c)) {
+                return false;
+            }
+            buffer++;
+            bufferSize--;
+        }
+        return true;
+    }
+
+    /**
+    * @brief Applies era and AM/PM designator to parsed values. It is called after all specifiers were parsed.
+    * @param state Parsed values.
+    */
+    DT_CONSTEXPR14 void finishParsing(parse_state_s& state) {
+        if (state.negativeYear) state.value.year = -state.value.year;
+        if (state.value.hours.is12()) {
+            state.value.hours.setHours12(state.value.hours.getHours(), state.isAM);
+        }
+    }
+
+    /**
+    * @brief Parses date and time from string. See parseDateTime() with separated parsed values for details.
+    * @param buffer Buffer, where DateTime is written in text form.
+    * @param bufferSize Size of buffer including null terminator.
+    * @param format Custom date and time format of DateTime in text form.
+    * @param state Parsed values.
+    * @param matchText True to exactly match text characters. If set to false, just count and position of text characters is checked.
+    * @param monthNames Array with custom month names. This array has to contain exactly 12 strings. If set to NULL, English names are used.
+    * @return Returns value greather than 0, when parsing was successful. This value is count of parsed characters from buffer.
+    *         Returns negative or 0, when parsing failed. This value is zero based position of character from buffer, where parsing failed.
+    */
+    DT_CONSTEXPR14 int parseDateTime(const char* buffer, int bufferSize, const char* format, parse_state_s& state, bool matchText = false, const char* const* monthNames = NULL) {
+        if (bufferSize == 0) return false;
+        //bufferSize--;
+
+        if (monthNames == NULL) {
+            monthNames = dt_month_names;
+        }
+
+        state = parse_state_s();
+
+        int oldBufferSize = bufferSize;
+
+        char lastChar = 0;
+        int8_t sameCnt = 1;
+
+        int i = 1;
+        bool escape = false;
+        bool isText = false;
+        bool doubleQ = false;
+        lastChar = format[0];
+        do {
+            char c = format[i];
+            if (lastChar == c) {
+                //Same character found
+                sameCnt++;
+            }
+            else {
+                //New character found
+                bool handled = false;
+                if (escape || isText) {
+                    handled = false;
+                    bool curentIsDQ = lastChar == '"';
+                    if (!escape && isText && (lastChar == '\'' || curentIsDQ)) {
+                        isText = !(curentIsDQ == doubleQ);
+                        handled = !isText;
+                    }
+                    escape = !escape && lastChar == '\\';
+                    if (escape) handled = escape;
+                }
+                else {
+                    handled = true;
+                    switch (lastChar) {
+                    case '\\':
+                        escape = true;
+                        break;
+
+                    case '\'': //Text mark
+                        isText = !(isText && !doubleQ);
+                        doubleQ = false;
+                        break;
+
+                    case '"': //Text mark
+                        isText = !(isText && !doubleQ);
+                        doubleQ = true;
+                        break;
+
+                    default: {
+                        ParseResult result = parseSpecifier(lastChar, sameCnt, buffer, bufferSize, state, monthNames);
+                        if (result == PARSE_FAILED) {
+                            return bufferSize - oldBufferSize; //Parsing error
+                        }
+                        handled = result == PARSE_HANDLED;
+                        break;
+                    }
+                    }
+                }
+
+                if (!handled) {
+                    //Skipping text characters
+                    if (!parseText(lastChar, sameCnt, buffer, bufferSize, matchText)) {
+                        return bufferSize - oldBufferSize; //Parsing failed
+                    }
+                }
+
+                sameCnt = 1;
+                lastChar = c;
+                if (*buffer == '\0' && c != 'G' && c != 'N') {
+                    break; //End of buffer reached
+                }
+            }
+            i++;
+        } while (lastChar != '\0' && bufferSize > 0);
+
+        finishParsing(state);
+
+        if (lastChar == '\0') {
+            return oldBufferSize - bufferSize; //Returns positive position if not failed
+        }
+        else {
+            return bufferSize - oldBufferSize; //Returns negative position if failed
+        }
+    }
+
     /**
     * @brief Parses date and time from string.
     * @param buffer Buffer, where DateTime is written in text form.
@@ -1789,10 +3232,56 @@ namespace dtlib {
     * @return Returns value greather than 0, when parsing was successful. This value is count of parsed characters from buffer.
     *         Returns negative or 0, when parsing failed. This value is zero based position of character from buffer, where parsing failed.
     */
-    int parseDateTime(const char* buffer, int bufferSize, const char* format, date_time_s& parsedValue, int16_t& timeZoneOffset, int16_t& DSTOffset, int16_t& TZandDSToffset, bool matchText = false, const char* const* monthNames = NULL);
+    DT_CONSTEXPR14 int parseDateTime(const char* buffer, int bufferSize, const char* format, date_time_s& parsedValue, int16_t& timeZoneOffset, int16_t& DSTOffset, int16_t& TZandDSToffset, bool matchText = false, const char* const* monthNames = NULL) {
+        if (bufferSize == 0) return false;
+
+        parse_state_s state;
+        int ret = parseDateTime(buffer, bufferSize, format, state, matchText, monthNames);
+        parsedValue = state.value;
+        timeZoneOffset = state.timeZoneOffset;
+        DSTOffset = state.DSTOffset;
+        TZandDSToffset = state.TZandDSToffset;
+        return ret;
+    }
 
 
 
+    /**
+    * @brief Parses date and time in ISO 8601 format, which is used by _dt literal. Parsing is done by parseDateTime() with one of those
+    * formats: "Ny-MM-dd", "Ny-MM-ddTHH:mm", "Ny-MM-ddTHH:mm:ss" or "Ny-MM-ddTHH:mm:ss.F". Time formats can be followed by time zone
+    * offset "ZZZ" (for example Z, +01:00 or -05:30). Text characters have to match exactly.
+    * @note Unlike parseDateTime(), this function also checks, if day exists in the month and if minutes and seconds are in range 0-59.
+    * @param buffer Buffer, where date and time is written in text form.
+    * @param length Length of text in buffer without null terminator.
+    * @param[out] raw Parsed raw value. If time zone offset is present, value is converted to UTC.
+    * @return Returns true if whole text was parsed and value is valid, else returns false.
+    */
+    DT_CAL_CONSTEXPR bool parseDateTimeLiteral(const char* buffer, size_t length, int64_t& raw) {
+        const char* const formats[] = { //Longer formats have to be first, parseDateTime() does not need to parse whole buffer
+            "Ny-MM-ddTHH:mm:ss.FZZZ", "Ny-MM-ddTHH:mm:ss.F",
+            "Ny-MM-ddTHH:mm:ssZZZ", "Ny-MM-ddTHH:mm:ss",
+            "Ny-MM-ddTHH:mmZZZ", "Ny-MM-ddTHH:mm",
+            "Ny-MM-dd"
+        };
+
+        for (uint8_t i = 0; i < sizeof(formats) / sizeof(formats[0]); i++) {
+            date_time_s dt;
+            int16_t tzOffset = 0;
+            int16_t DSTOffset = 0;
+            int16_t tz_DST_Offset = 0;
+            int ret = parseDateTime(buffer, (int)length + 1, formats[i], dt, tzOffset, DSTOffset, tz_DST_Offset, true);
+            if (ret <= 0 || ret != (int)length) continue;
+
+            //Range checks, which are not done by parseDateTime()
+            if (dt.year == 0 || dt.year > MAX_YEAR || dt.year < MIN_YEAR) return false;
+            if (dt.day > dt.month.getMonthLength(isLeapYear(dt.year))) return false;
+            if (dt.minutes > 59 || dt.seconds > 59) return false;
+
+            raw = dateTimeToRaw(dt) - (int64_t)tz_DST_Offset * MINUTE;
+            return true;
+        }
+        return false;
+    }
 #ifdef ARDUINO
 
     template<class T>
@@ -1836,6 +3325,7 @@ METHOD_CHECKER(has_getDSTOffsetMinutes, getCurrentDSTOffsetMinutes, int16_t, ())
 METHOD_CHECKER(has_getTimeZone, getTimeZone, TimeZone, ());
 METHOD_CHECKER(has_getDST, getDST, DSTAdjustment, ());
 MTYPE_CHECKER_ANY(has_setTimeZone, setTimeZone);
+METHOD_CHECKER_ANY(has_setTimeZoneNoRecalc, setTimeZone, (dtlib::declval<TimeZone>(), false)); //Also matches overloaded setTimeZone() of DateTimeTZ
 METHOD_CHECKER(has_isDST, isDST, bool, ());
 
 METHOD_CHECKER(has_getRawSyncTime, getRawSyncTime, DT_SYNC_TYPE, ());
@@ -0,0 +1,325 @@
+#include "DateTimeParser.h"
+
+int DateTimeParser::parse(const char* buffer, int bufferSize, dtlib::parse_state_s& state) const {
+	if (bufferSize == 0) return false;
+
+	state = dtlib::parse_state_s();
+
+	if (error != DateTimeFormat::FORMAT_OK) {
+		return 0;
+	}
+
+	int oldBufferSize = bufferSize;
+	char next = '\0';
+
+	for (uint8_t i = 0; i < opsCount; i++) {
+		const parse_op_s& op = ops[i];
+		bool handled = true;
+		switch (op.code) {
+		case OP_SPECIFIER: {
+			dtlib::ParseResult result = dtlib::parseSpecifier(op.c, op.count, buffer, bufferSize, state, monthNames);
+			if (result == dtlib::PARSE_FAILED) {
+				return bufferSize - oldBufferSize; //Parsing error
+			}
+			handled = result == dtlib::PARSE_HANDLED;
+			break;
+		}
+
+		case OP_MONTH_NAME3:
+			if (!parseMonthName3(buffer, bufferSize, state)) {
+				return bufferSize - oldBufferSize; //Parsing error
+			}
+			break;
+
+		case OP_TEXT:
+			handled = false;
+			break;
+
+		default:
+			break;
+		}
+
+		if (!handled) {
+			//Skipping text characters
+			if (!dtlib::parseText(op.c, op.count, buffer, bufferSize, matchText)) {
+				return bufferSize - oldBufferSize; //Parsing failed
+			}
+		}
+
+		//End of buffer is checked the same way as in dtlib::parseDateTime(), buffer does not have to be null terminated
+		next = (i + 1 < opsCount) ? ops[i + 1].c : '\0';
+		if (bufferSize <= 0 || (*buffer == '\0' && next != 'G' && next != 'N')) {
+			break; //End of buffer reached
+		}
+	}
+
+	dtlib::finishParsing(state);
+
+	if (next == '\0') {
+		return oldBufferSize - bufferSize; //Returns positive position if not failed
+	}
+	else {
+		return bufferSize - oldBufferSize; //Returns negative position if failed
+	}
+}
+
+bool DateTimeParser::parseMonthName3(const char*& buffer, int& bufferSize, dtlib::parse_state_s& state) const {
+	if (bufferSize < 3) {
+		return false;
+	}
+	uint32_t key = ((uint32_t)(uint8_t)dtlib::toLowerChar(buffer[0]))
+		| ((uint32_t)(uint8_t)dtlib::toLowerChar(buffer[1]) << 8)
+		| ((uint32_t)(uint8_t)dtlib::toLowerChar(buffer[2]) << 16);
+	for (uint8_t i = 0; i < 12; i++) {
+		if (monthKeys[i] == key) {
+			state.value.month = i + 1;
+			bufferSize -= 3;
+			buffer += 3;
+			return true;
+		}
+	}
+	return false;
+}
+
+namespace dtlib {
+
+	//Masks of bytes in 8-byte word, the first character of word is in the lowest byte
+#define WORD_BYTES(b)		(0x0101010101010101ULL * (uint8_t)(b))
+#define DATE_SEP_MASK		(0x00000000FF0000FFULL)	//"-MM-DDTH", separators '-'
+#define DATE_DIGIT_MASK		(0x0000FFFF00FFFF00ULL)	//"-MM-DDTH", digits of month and day
+#define TIME_SEP_MASK		(0x0000FF0000FF0000ULL)	//"HH:MM:SS", separators ':'
+#define TIME_DIGIT_MASK		(0xFFFF00FFFF00FFFFULL)	//"HH:MM:SS", digits of hours, minutes and seconds
+
+	/**
+	* @brief Loads 8 characters to word, the first character is in the lowest byte (independently on endianness).
+	* Compilers replace it by one load on little endian platforms.
+	*/
+	static inline uint64_t loadWord(const char* buffer) {
+		uint64_t word = 0;
+		for (uint8_t i = 0; i < 8; i++) {
+			word |= ((uint64_t)(uint8_t)buffer[i]) << (8 * i);
+		}
+		return word;
+	}
+
+	/**
+	* @brief Checks if all bytes of word are digits.
+	*/
+	static inline bool allDigits(uint64_t word) {
+		//High nibble has to be 3 and low nibble has to be lower than 10 (adding 6 does not change high nibble)
+		return ((word & WORD_BYTES(0xF0)) | (((word + WORD_BYTES(0x06)) & WORD_BYTES(0xF0)) >> 4)) == WORD_BYTES(0x33);
+	}
+
+	/**
+	* @brief Converts digits of word to two digit numbers. Byte i of result is number made from digits i and i+1.
+	*/
+	static inline uint64_t digitPairs(uint64_t word) {
+		word -= WORD_BYTES('0');
+		return word * 10 + (word >> 8);
+	}
+
+	/**
+	* @brief Gets count of leading digits in word.
+	*/
+	static inline uint8_t countDigits(uint64_t word) {
+		//High bit of byte is set if character is lower than '0' (borrow), greater than '9' (overflow over 0x7F) or it is not ASCII.
+		//Carry and borrow propagate only to following characters, so the first non digit character is always detected correctly.
+		uint64_t mask = ((word + WORD_BYTES(0x46)) | (word - WORD_BYTES('0')) | word) & WORD_BYTES(0x80);
+		if (mask == 0) return 8;
+#ifdef __GNUC__
+		return (uint8_t)(__builtin_ctzll(mask) >> 3);
+#else
+		uint8_t cnt = 0;
+		while (!(mask & 0x80)) {
+			mask >>= 8;
+			cnt++;
+		}
+		return cnt;
+#endif // __GNUC__
+	}
+
+	/**
+	* @brief Converts 8 digits of word to number.
+	*/
+	static inline uint32_t eightDigitsToInt(uint64_t word) {
+		word = ((word & WORD_BYTES(0x0F)) * 2561) >> 8;
+		word = ((word & 0x00FF00FF00FF00FFULL) * 6553601) >> 16;
+		return (uint32_t)(((word & 0x0000FFFF0000FFFFULL) * 42949672960001ULL) >> 32);
+	}
+
+	static inline bool isDigit(char c) {
+		return c >= '0' && c <= '9';
+	}
+
+	/**
+	* @brief Parses exactly count digits, returns -1 if any of characters is not digit.
+	*/
+	static inline int32_t parseDigits(const char* buffer, uint8_t count) {
+		int32_t val = 0;
+		for (uint8_t i = 0; i < count; i++) {
+			if (!isDigit(buffer[i])) return -1;
+			val = val * 10 + (buffer[i] - '0');
+		}
+		return val;
+	}
+
+	int parseISO8601(const char* buffer, size_t length, int64_t& raw, int16_t& offset, bool& hasOffset) {
+		size_t pos = 0;
+		int32_t year = 0;
+		uint8_t month = 0, day = 0, hour = 0, minute = 0, second = 0;
+		uint32_t microsecond = 0;
+
+		//Year
+		if (length > 0 && (buffer[0] == '+' || buffer[0] == '-')) {
+			//Expanded representation with 6 digits
+			if (length < 7) return -(int)length;
+			year = parseDigits(buffer + 1, 6);
+			if (year < 0) return -1;
+			if (buffer[0] == '-') year = -year;
+			pos = 7;
+		}
+		else {
+			if (length < 4) return -(int)length;
+			year = parseDigits(buffer, 4);
+			if (year < 0) return 0;
+			pos = 4;
+		}
+		if (year <= 0) year--; //Astronomical year numbering, year 0 is 1 BC
+		if (year < MIN_YEAR || year > MAX_YEAR) return -1; //Only expanded year can be out of range
+
+		bool hasTime = false;
+		const char* p = buffer + pos;
+		if (length - pos >= 15) {
+			//Fast path, month, day, hours, minutes and seconds are validated and converted at once
+			uint64_t date = loadWord(p);
+			uint64_t time = loadWord(p + 7);
+			char sep = p[6];
+			uint64_t dateDigits = (date & DATE_DIGIT_MASK) | (WORD_BYTES('0') & ~DATE_DIGIT_MASK);
+			uint64_t timeDigits = (time & TIME_DIGIT_MASK) | (WORD_BYTES('0') & ~TIME_DIGIT_MASK);
+			if ((date & DATE_SEP_MASK) == (WORD_BYTES('-') & DATE_SEP_MASK) &&
+				(time & TIME_SEP_MASK) == (WORD_BYTES(':') & TIME_SEP_MASK) &&
+				(sep == 'T' || sep == 't' || sep == ' ') &&
+				allDigits(dateDigits) && allDigits(timeDigits)) {
+
+				uint64_t datePairs = digitPairs(dateDigits);
+				uint64_t timePairs = digitPairs(timeDigits);
+				month = (uint8_t)(datePairs >> 8);
+				day = (uint8_t)(datePairs >> 32);
+				hour = (uint8_t)timePairs;
+				minute = (uint8_t)(timePairs >> 24);
+				second = (uint8_t)(timePairs >> 48);
+				if (month < 1 || month > 12) return -(int)(pos + 1);
+				if (day < 1 || day > Month::getMonthLength(month, isLeapYear(year))) return -(int)(pos + 4);
+				if (hour > 23) return -(int)(pos + 7);
+				if (minute > 59) return -(int)(pos + 10);
+				if (second > 59) return -(int)(pos + 13);
+				pos += 15;
+				hasTime = true;
+			}
+		}
+
+		if (!hasTime) {
+			//Slow path, date without time or time without seconds is also accepted and exact position of error is found
+			int32_t val = 0;
+			if (pos >= length || buffer[pos] != '-') return -(int)pos;
+			if (pos + 3 > length || (val = parseDigits(buffer + pos + 1, 2)) < 1 || val > 12) return -(int)(pos + 1);
+			month = (uint8_t)val;
+			pos += 3;
+			if (pos >= length || buffer[pos] != '-') return -(int)pos;
+			if (pos + 3 > length || (val = parseDigits(buffer + pos + 1, 2)) < 1 || val > Month::getMonthLength(month, isLeapYear(year))) return -(int)(pos + 1);
+			day = (uint8_t)val;
+			pos += 3;
+
+			if (pos >= length || !(buffer[pos] == 'T' || buffer[pos] == 't' || buffer[pos] == ' ') ||
+				(buffer[pos] == ' ' && (pos + 1 >= length || !isDigit(buffer[pos + 1])))) {
+				//Date only
+				hasOffset = false;
+				offset = 0;
+				raw = (int64_t)(getDaysUntilYear(year) + getDayOfYearFromMonth(month, isLeapYear(year)) + day - 1) * DAY;
+				return (int)pos;
+			}
+			pos++;
+
+			if (pos + 2 > length || (val = parseDigits(buffer + pos, 2)) < 0 || val > 23) return -(int)pos;
+			hour = (uint8_t)val;
+			pos += 2;
+			if (pos >= length || buffer[pos] != ':') return -(int)pos;
+			if (pos + 3 > length || (val = parseDigits(buffer + pos + 1, 2)) < 0 || val > 59) return -(int)(pos + 1);
+			minute = (uint8_t)val;
+			pos += 3;
+			if (pos < length && buffer[pos] == ':') {
+				if (pos + 3 > length || (val = parseDigits(buffer + pos + 1, 2)) < 0 || val > 59) return -(int)(pos + 1);
+				second = (uint8_t)val;
+				pos += 3;
+				hasTime = true; //Fraction is allowed only after seconds
+			}
+		}
+
+		//Fraction of second
+		if (hasTime && pos < length && (buffer[pos] == '.' || buffer[pos] == ',')) {
+			pos++;
+			uint8_t cnt = 0;
+			if (length - pos >= 8) {
+				uint64_t word = loadWord(buffer + pos);
+				cnt = countDigits(word);
+				if (cnt > 0) {
+					//Digits after first 6 are truncated, missing digits are replaced by zeros
+					uint64_t keep = (cnt >= 6) ? 0x0000FFFFFFFFFFFFULL : ((1ULL << (8 * cnt)) - 1);
+					word = (word & keep) | (WORD_BYTES('0') & ~keep);
+					microsecond = eightDigitsToInt(word) / 100;
+				}
+			}
+			else {
+				uint32_t mul = 100000;
+				for (; pos + cnt < length && isDigit(buffer[pos + cnt]); cnt++) {
+					microsecond += (buffer[pos + cnt] - '0') * mul;
+					mul /= 10;
+				}
+			}
+			if (cnt == 0) return -(int)pos;
+			pos += cnt;
+			while (pos < length && isDigit(buffer[pos])) pos++;
+		}
+
+		//Offset
+		offset = 0;
+		hasOffset = false;
+		if (pos < length) {
+			char c = buffer[pos];
+			if (c == 'Z' || c == 'z') {
+				hasOffset = true;
+				pos++;
+			}
+			else if (c == '+' || c == '-') {
+				int32_t ho = (pos + 3 <= length) ? parseDigits(buffer + pos + 1, 2) : -1;
+				if (ho < 0 || ho > 23) return -(int)(pos + 1);
+				int32_t mins = 0;
+				size_t next = pos + 3;
+				if (next < length && buffer[next] == ':') {
+					mins = (next + 3 <= length) ? parseDigits(buffer + next + 1, 2) : -1;
+					if (mins < 0 || mins > 59) return -(int)(next + 1);
+					next += 3;
+				}
+				else if (next + 2 <= length && isDigit(buffer[next])) {
+					mins = parseDigits(buffer + next, 2);
+					if (mins < 0 || mins > 59) return -(int)next;
+					next += 2;
+				}
+				offset = (int16_t)(ho * 60 + mins);
+				if (c == '-') offset = -offset;
+				hasOffset = true;
+				pos = next;
+			}
+		}
+
+		int32_t days = getDaysUntilYear(year) + getDayOfYearFromMonth(month, isLeapYear(year)) + day - 1;
+		raw = (int64_t)days * DAY + hour * HOUR + minute * MINUTE + second * SECOND + microsecond;
+		return (int)pos;
+	}
+
+#undef WORD_BYTES
+#undef DATE_SEP_MASK
+#undef DATE_DIGIT_MASK
+#undef TIME_SEP_MASK
+#undef TIME_DIGIT_MASK
+}
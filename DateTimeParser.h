@@ -0,0 +1,285 @@
+/**
+ * @file DateTimeParser.h
+ * @brief This file contains class DateTimeParser, which is custom date and time parse format compiled to list of operations,
+ * and parser of fixed ISO 8601 / RFC 3339 layout.
+ *
+ * Format string is scanned only once, when DateTimeParser is constructed. Parsing then only executes prepared operations,
+ * result is the same as result of dtlib::parseDateTime() with the same format.
+ * DateTimeParser does not use dynamic memory, capacity is given by DT_PARSER_MAX_OPS.
+ *
+ * @see DateTimeParser
+ *
+ * # Credits
+ * @author Matej Fitoš
+ */
+
+#ifndef _DATE_TIME_PARSER_H
+#define _DATE_TIME_PARSER_H
+
+#include "DateTimeHelpers.h"
+#include "DateTimeFormat.h"
+
+#ifndef DT_PARSER_MAX_OPS
+#define DT_PARSER_MAX_OPS	(32)	//Maximum count of operations (specifiers, blocks of text and text marks) in one parse format
+#endif // !DT_PARSER_MAX_OPS
+
+/**
+* @class DateTimeParser
+* @brief Custom date and time parse format, which is compiled to list of operations.
+* Format specifiers are the same as specifiers used by parse() function of DateTime, result is also the same.
+*
+* Parser is usually created once and then used many times:
+* @code{.cpp}
+* static const DateTimeParser logParser("yyyy-MM-dd HH:mm:ss.FFFFFF", true);
+* dt.parse(line, lineLength + 1, logParser);
+* @endcode
+*/
+class DateTimeParser
+{
+public:
+
+	/**
+	* @brief Compiles date and time parse format.
+	* @param format Custom date and time format, see DateTimeRawBase::parse() for format specifiers.
+	* @param matchText True to exactly match text characters. If set to false, just count and position of text characters is checked.
+	* @param monthNames Array with custom month names. This array has to contain exactly 12 strings. If set to NULL, English names are used.
+	* @note Array with names is not copied, so it has to exist until DateTimeParser is used.
+	*/
+	explicit DT_CONSTEXPR14 DateTimeParser(const char* format, bool matchText = false, const char* const* monthNames = NULL) :
+		monthNames(monthNames == NULL ? dt_month_names : monthNames),
+		matchText(matchText)
+	{
+		for (uint8_t i = 0; i < 12; i++) {
+			monthKeys[i] = getMonthKey(this->monthNames[i]);
+		}
+		compile(format);
+	}
+
+	/**
+	* @brief Checks, if format was compiled without errors.
+	* @return Returns true if format is valid. Parsing using invalid format always fails.
+	*/
+	constexpr bool isValid() const {
+		return error == DateTimeFormat::FORMAT_OK;
+	}
+
+	/**
+	* @brief Gets error found during compilation. Only DateTimeFormat::FORMAT_TOO_MANY_OPS and DateTimeFormat::FORMAT_INVALID_COUNT can be found.
+	*/
+	constexpr DateTimeFormat::FormatError getError() const {
+		return error;
+	}
+
+	/**
+	* @brief Gets position of character in format string, where error was found.
+	* @return Returns index of character or 0 if format is valid.
+	*/
+	constexpr uint16_t getErrorPosition() const {
+		return errorPosition;
+	}
+
+	/**
+	* @brief Parses date and time from string.
+	* Character at position bufferSize - 1 is always handled as null terminator, so text does not have to be null terminated
+	* (for example line of larger buffer can be parsed in place), but that position has to be readable.
+	* @param buffer Buffer, where DateTime is written in text form.
+	* @param bufferSize Size of buffer including null terminator.
+	* @param[out] state Parsed values.
+	* @return Returns value greather than 0, when parsing was successful. This value is count of parsed characters from buffer.
+	*         Returns negative or 0, when parsing failed. This value is zero based position of character from buffer, where parsing failed.
+	*/
+	int parse(const char* buffer, int bufferSize, dtlib::parse_state_s& state) const;
+
+	/**
+	* @brief Parses date and time from string. Result is the same as result of dtlib::parseDateTime().
+	* @param buffer Buffer, where DateTime is written in text form.
+	* @param bufferSize Size of buffer including null terminator.
+	* @param parsedValue Parsed fields of DateTime.
+	* @param timeZoneOffset Time zone offset in minutes.
+	* @param DSTOffset DST offset in minutes.
+	* @param TZandDSToffset Time zone and DST offset (sometimes called as UTC offset) in minutes.
+	* @return Returns value greather than 0, when parsing was successful. This value is count of parsed characters from buffer.
+	*         Returns negative or 0, when parsing failed. This value is zero based position of character from buffer, where parsing failed.
+	*/
+	int parse(const char* buffer, int bufferSize, date_time_s& parsedValue, int16_t& timeZoneOffset, int16_t& DSTOffset, int16_t& TZandDSToffset) const {
+		if (bufferSize == 0) return false;
+
+		dtlib::parse_state_s state;
+		int ret = parse(buffer, bufferSize, state);
+		parsedValue = state.value;
+		timeZoneOffset = state.timeZoneOffset;
+		DSTOffset = state.DSTOffset;
+		TZandDSToffset = state.TZandDSToffset;
+		return ret;
+	}
+
+private:
+
+	/**
+	* @enum OpCode
+	* @brief Operation of compiled format.
+	*/
+	enum OpCode : uint8_t {
+		OP_MARK = 0,		//Escape character or text mark, nothing is parsed
+		OP_TEXT,			//Text characters, which are skipped
+		OP_SPECIFIER,		//Specifier parsed by dtlib::parseSpecifier()
+		OP_MONTH_NAME3		//Abbreviated month name, matched using prepared keys
+	};
+
+	/**
+	* @struct parse_op_s
+	* @brief One operation of compiled format.
+	*/
+	struct parse_op_s {
+		char c = 0;			//Format character
+		int8_t count = 0;	//Count of repeated format characters
+		uint8_t code = OP_MARK;
+	};
+
+	/**
+	* @brief Gets first 3 characters of month name in lower case packed to one number.
+	*/
+	static DT_CONSTEXPR14 uint32_t getMonthKey(const char* name) {
+		uint32_t key = 0;
+		for (uint8_t i = 0; i < 3 && name[i] != '\0'; i++) {
+			key |= ((uint32_t)(uint8_t)dtlib::toLowerChar(name[i])) << (8 * i);
+		}
+		return key;
+	}
+
+	/**
+	* @brief Parses abbreviated month name. Result is the same as result of "MMM" specifier of dtlib::parseSpecifier().
+	*/
+	bool parseMonthName3(const char*& buffer, int& bufferSize, dtlib::parse_state_s& state) const;
+
+	DT_CONSTEXPR14 void setError(DateTimeFormat::FormatError err, uint16_t position) {
+		if (error == DateTimeFormat::FORMAT_OK) {
+			error = err;
+			errorPosition = position;
+		}
+	}
+
+	DT_CONSTEXPR14 void addOp(char c, int8_t count, uint8_t code, uint16_t position) {
+		if (opsCount >= DT_PARSER_MAX_OPS) {
+			setError(DateTimeFormat::FORMAT_TOO_MANY_OPS, position);
+			return;
+		}
+		ops[opsCount].c = c;
+		ops[opsCount].count = count;
+		ops[opsCount].code = code;
+		opsCount++;
+	}
+
+	/**
+	* @brief Compiles format. Characters are grouped and escape characters and text marks are resolved the same way as in dtlib::parseDateTime().
+	*/
+	DT_CONSTEXPR14 void compile(const char* format) {
+		if (format[0] == '\0') return;
+
+		char lastChar = format[0];
+		uint16_t sameCnt = 1;
+		uint16_t groupStart = 0;
+
+		uint16_t i = 1;
+		bool escape = false;
+		bool isText = false;
+		bool doubleQ = false;
+		while (lastChar != '\0' && error == DateTimeFormat::FORMAT_OK) {
+			char c = format[i];
+			if (lastChar == c) {
+				//Same character found
+				sameCnt++;
+			}
+			else {
+				//New character found
+				if (sameCnt > DT_FORMAT_MAX_SAME_COUNT) {
+					setError(DateTimeFormat::FORMAT_INVALID_COUNT, groupStart);
+					return;
+				}
+
+				uint8_t code = OP_MARK;
+				if (escape || isText) {
+					bool handled = false;
+					bool curentIsDQ = lastChar == '"';
+					if (!escape && isText && (lastChar == '\'' || curentIsDQ)) {
+						isText = !(curentIsDQ == doubleQ);
+						handled = !isText;
+					}
+					escape = !escape && lastChar == '\\';
+					if (escape) handled = escape;
+					code = handled ? OP_MARK : OP_TEXT;
+				}
+				else {
+					switch (lastChar) {
+					case '\\':
+						escape = true;
+						break;
+
+					case '\'': //Text mark
+						isText = !(isText && !doubleQ);
+						doubleQ = false;
+						break;
+
+					case '"': //Text mark
+						isText = !(isText && !doubleQ);
+						doubleQ = true;
+						break;
+
+					default:
+						if (!dtlib::isParseSpecifier(lastChar)) {
+							code = OP_TEXT;
+						}
+						else if (lastChar == 'M' && sameCnt == 3) {
+							code = OP_MONTH_NAME3;
+						}
+						else {
+							code = OP_SPECIFIER;
+						}
+						break;
+					}
+				}
+
+				addOp(lastChar, (int8_t)sameCnt, code, groupStart);
+
+				sameCnt = 1;
+				lastChar = c;
+				groupStart = i;
+			}
+			i++;
+		}
+	}
+
+	parse_op_s ops[DT_PARSER_MAX_OPS] = {};
+	uint32_t monthKeys[12] = {};
+	const char* const* monthNames;
+	uint16_t errorPosition = 0;
+	uint8_t opsCount = 0;
+	bool matchText;
+	DateTimeFormat::FormatError error = DateTimeFormat::FORMAT_OK;
+};
+
+namespace dtlib {
+
+	/**
+	* @brief Parses date and time written in fixed ISO 8601 / RFC 3339 layout, for example 2009-06-15T13:45:30.123456+02:00.
+	* Date and time fields are validated and converted using 8-byte words (all digits of date and time at once),
+	* so it is much faster than parseDateTime().
+	*
+	* Accepted layout is: date "yyyy-MM-dd" or "+yyyyyy-MM-dd" / "-yyyyyy-MM-dd" (expanded year, astronomical year numbering),
+	* optionally followed by 'T', 't' or ' ' and time "HH:mm" or "HH:mm:ss", optionally followed by fraction of second
+	* ('.' or ',' and at least one digit, only first 6 digits are used) and optionally followed by offset
+	* ('Z', 'z', "+HH", "+HHmm" or "+HH:mm"). Text after parsed value is not checked.
+	* @note Unlike parseDateTime(), this function checks, if day exists in the month and if hours, minutes and seconds are in range.
+	* Expanded year has to be in range from MIN_YEAR to MAX_YEAR.
+	* @param buffer Buffer, where date and time is written in text form.
+	* @param length Length of text in buffer. Null terminator is not required.
+	* @param[out] raw Parsed raw value in local time (offset is not applied).
+	* @param[out] offset Parsed offset in minutes. It is 0 if offset was not found.
+	* @param[out] hasOffset True if offset was found.
+	* @return Returns value greather than 0, when parsing was successful. This value is count of parsed characters from buffer.
+	*         Returns negative or 0, when parsing failed. This value is zero based position of character from buffer, where parsing failed.
+	*/
+	int parseISO8601(const char* buffer, size_t length, int64_t& raw, int16_t& offset, bool& hasOffset);
+}
+
+#endif // !_DATE_TIME_PARSER_H
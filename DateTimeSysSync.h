@@ -187,7 +187,7 @@ public:
 		DateTimeSysSync utc = (DateTimeSysSync)time;
 
 		TimeZoneInfo::loadSystemTZInfo();
-		TimeZoneInfo& tzinfo = TimeZoneInfo::getSystemTZInfo();
+		const TimeZoneInfo& tzinfo = TimeZoneInfo::getSystemTZInfo();
 		utc -= tzinfo.timeZone.getTimeZoneOffset();
 		if (isDST) {
 			utc -= tzinfo.DST.getDSTOffset();
@@ -0,0 +1,309 @@
+/**
+ * @file DateTimeTZRef.h
+ * @brief This file contains class DateTimeTZRef, which is compact DateTime with time zone and DST adjustment.
+ *
+ * DateTimeTZRef stores raw value, 16-bit index of zone from TimeZoneRegistry and DST flag, so it has only 16 bytes
+ * (DateTimeTZ has 24 bytes and DateTimeTZSysSync 40 bytes). It is useful for large tables, where most of values share few zones.
+ *
+ * @see DateTimeTZRef
+ * @see TimeZoneRegistry
+ *
+ * # Credits
+ * @author Matej Fitoš
+ */
+
+#ifndef DATE_TIME_TZ_REF_H
+#define DATE_TIME_TZ_REF_H
+
+#include "DateTimeTZ.h"
+#include "TimeZoneRegistry.h"
+
+/**
+* @class DateTimeTZRef
+* @brief DateTime with time zone and DST adjustment, which are referenced by index of zone from TimeZoneRegistry.
+* It behaves like DateTimeTZ, date and time fields are computed from raw value the same way, DST flag is cached in instance,
+* so only DST adjustment is read from registry, when DST region has to be checked.
+* @code{.cpp}
+* TimeZoneRegistry::Index berlin;
+* TimeZoneRegistry::add(TimeZones::CET, DSTAdjustment::CentralEurope, berlin);
+* DateTimeTZRef dt(DateTime(2024, 7, 1, 12), berlin, true); //Summer time, DST is applyied
+* DateTime utc = dt.getUTC(); //2024/07/01 10:00:00
+* @endcode
+*
+* @see DateTimeTZ
+* @see TimeZoneRegistry
+*/
+class DateTimeTZRef : public DateTimeRawBase<DateTimeTZRef>
+{
+public:
+
+	/**
+	* @brief Default constructor, which set DateTime to the 0001/01/01 00:00:00.000000 in UTC zone.
+	*/
+	DateTimeTZRef() : DateTimeRawBase<DateTimeTZRef>()
+	{ }
+
+	/**
+	* @brief Constructor, which sets DateTime from raw value with zone.
+	* @param raw Raw value in microseconds from the begin of epoch (0001/1/1) in specified zone.
+	* @param zone Index of zone from TimeZoneRegistry.
+	* @param DST_app True if DST is applyied to date and time.
+	*/
+	DateTimeTZRef(int64_t raw, TimeZoneRegistry::Index zone, bool DST_app = false) :
+		zoneIndex(zone),
+		DSTFlag(DST_app)
+	{
+		DateTimeBase<DateTimeTZRef>::setRawTime(raw);
+	}
+
+	/**
+	* @brief Constructor, which sets DateTime from date and time fields with zone.
+	* @param dt_s Date and time fields in specified zone.
+	* @param zone Index of zone from TimeZoneRegistry.
+	* @param DST_app True if DST is applyied to date and time.
+	*/
+	DateTimeTZRef(date_time_s dt_s, TimeZoneRegistry::Index zone, bool DST_app = false) :
+		zoneIndex(zone),
+		DSTFlag(DST_app)
+	{
+		DateTimeRawBase<DateTimeTZRef>::set(dt_s);
+	}
+
+	/**
+	* @brief Constructor, which sets DateTime from DateTime with zone.
+	* @param dt DateTime in specified zone.
+	* @param zone Index of zone from TimeZoneRegistry.
+	* @param DST_app True if DST is applyied to date and time.
+	*/
+	DateTimeTZRef(const DateTime& dt, TimeZoneRegistry::Index zone, bool DST_app = false) :
+		zoneIndex(zone),
+		DSTFlag(DST_app)
+	{
+		DateTimeBase<DateTimeTZRef>::setRawTime(dt.getRaw());
+	}
+
+	/**
+	* @brief Construct DateTimeTZRef from any other DateTimeBase with time zone and DST adjustment (for example DateTimeTZ),
+	* which is converted to specified zone.
+	* @param dt Any other DateTimeBase.
+	* @param zone Index of zone from TimeZoneRegistry.
+	*/
+	template<class T, typename dtlib::enable_if<has_getTimeZone<T>::value, int>::type = 0>
+	DateTimeTZRef(const DateTimeBase<T>& dt, TimeZoneRegistry::Index zone) :
+		zoneIndex(zone)
+	{
+		setUTC(static_cast<const T*>(&dt)->getUTC());
+	}
+
+	/**
+	* @brief Gets index of zone from TimeZoneRegistry.
+	*/
+	inline TimeZoneRegistry::Index getZone() const {
+		return zoneIndex;
+	}
+
+	/**
+	* @brief Sets zone.
+	* @param zone Index of zone from TimeZoneRegistry.
+	* @param recalculateTime If true, current time will be converted to UTC and then converted to new zone.
+	* Else time stays unchanged.
+	*/
+	void setZone(TimeZoneRegistry::Index zone, bool recalculateTime = true) {
+		if (recalculateTime) {
+			DateTime utc = getUTC();
+			zoneIndex = zone;
+			setUTC(utc);
+		}
+		else {
+			zoneIndex = zone;
+			DSTFlag = false;
+			DateTimeBase<DateTimeTZRef>::setRawTime(DateTimeBase<DateTimeTZRef>::getRawTime());
+		}
+	}
+
+	/**
+	* @brief Gets time zone info.
+	*/
+	inline TimeZone getTimeZone() const {
+		return TimeZoneRegistry::getTimeZone(zoneIndex);
+	}
+
+	/**
+	* @brief Gets time zone offset represented by TimeSpan.
+	*/
+	inline TimeSpan getTimeZoneOffset() const {
+		return getTimeZone().getTimeZoneOffset();
+	}
+
+	/**
+	* @brief Gets time zone offset in minutes.
+	*/
+	inline int16_t getTimeZoneOffsetMinutes() const {
+		return getTimeZone().getTimeZoneOffsetTotalMinutes();
+	}
+
+	/**
+	* @brief Gets DST adjustment with current DST flag.
+	*/
+	inline DSTAdjustment getDST() const {
+		return DSTAdjustment(TimeZoneRegistry::getDST(zoneIndex), DSTFlag);
+	}
+
+	/**
+	* @brief Gets current DST offset represented by TimeSpan. If DST is not applyied, 0 is returned.
+	*/
+	inline TimeSpan getCurrentDSTOffset() const {
+		return ((int64_t)getCurrentDSTOffsetMinutes()) * MINUTE;
+	}
+
+	/**
+	* @brief Gets current DST offset in minutes. If DST is not applyied, 0 is returned.
+	*/
+	inline int16_t getCurrentDSTOffsetMinutes() const {
+		return DSTFlag ? TimeZoneRegistry::getDST(zoneIndex).getDSTOffsetTotalMinutes() : 0;
+	}
+
+	/**
+	* @brief Gets DST offset represented by TimeSpan.
+	*/
+	inline TimeSpan getDSTOffset() const {
+		return ((int64_t)getDSTOffsetMinutes()) * MINUTE;
+	}
+
+	/**
+	* @brief Gets DST offset in minutes.
+	*/
+	inline int16_t getDSTOffsetMinutes() const {
+		return TimeZoneRegistry::getDST(zoneIndex).getDSTOffsetTotalMinutes();
+	}
+
+	/**
+	* @brief Checks if DST is applyied.
+	*/
+	inline bool isDST() const {
+		return DSTFlag;
+	}
+
+	/**
+	* @brief Gets UTC DateTime.
+	*/
+	DateTime getUTC() const {
+		int64_t offset = ((int64_t)(getTimeZoneOffsetMinutes() + getCurrentDSTOffsetMinutes())) * MINUTE;
+		return DateTime(DateTimeBase<DateTimeTZRef>::getRawTime() - offset);
+	}
+
+	/**
+	* @brief Sets UTC DateTime.
+	* @param dt UTC DateTime. Time zone or DST is ignored here, only value as it is is used.
+	*/
+	template<class T>
+	void setUTC(const DateTimeBase<T>& dt) {
+		const DSTAdjustment& adj = TimeZoneRegistry::getDST(zoneIndex);
+		int64_t dateTime = dt.getRaw() + ((int64_t)getTimeZoneOffsetMinutes()) * MINUTE;
+		DSTFlag = adj.checkDSTRegion(dateTime);
+		if (DSTFlag) {
+			dateTime += ((int64_t)adj.getDSTOffsetTotalMinutes()) * MINUTE;
+		}
+		DateTimeBase<DateTimeTZRef>::setRawTimeNoTD(dateTime);
+	}
+
+	/**
+	* @brief Gets DateTime of next transition.
+	* @param[out] nextTransIsDST True if next transition is to DST or false if not.
+	* @return Returns DateTime of next transition. This value has DST applyied only if nextTransIsDST is false.
+	*/
+	inline DateTime getNextTransitionDate(bool& nextTransIsDST) const {
+		return TimeZoneRegistry::getDST(zoneIndex).getNextTransitionDate(*this, nextTransIsDST);
+	}
+
+	template<typename T, typename dtlib::enable_if<has_getCurrentDSTOffsetMinutes<T>::value && has_getTimeZoneOffsetMinutes<T>::value, int>::type = 0>
+	TimeSpan operator-(const DateTimeBase<T>& raw) const {
+		int16_t ofs1 = getTimeZoneOffsetMinutes() + getCurrentDSTOffsetMinutes();
+		int16_t ofs2 = static_cast<const T*>(&raw)->getTimeZoneOffsetMinutes() + static_cast<const T*>(&raw)->getCurrentDSTOffsetMinutes();
+		int64_t offset = ((int64_t)(ofs1 - ofs2)) * MINUTE;
+		return TimeSpan(DateTimeBase<DateTimeTZRef>::getRawTime() - raw.getRaw() - offset);
+	}
+
+	//Comparison operators
+
+	template<class T, typename dtlib::enable_if<has_getCurrentDSTOffsetMinutes<T>::value && has_getTimeZoneOffsetMinutes<T>::value, int>::type = 0>
+	bool operator==(const DateTimeBase<T>& dt2) const {
+		return getUTCRawOf(*this) == getUTCRawOf(dt2);
+	}
+
+	template<class T, typename dtlib::enable_if<has_getCurrentDSTOffsetMinutes<T>::value && has_getTimeZoneOffsetMinutes<T>::value, int>::type = 0>
+	bool operator!=(const DateTimeBase<T>& dt2) const {
+		return getUTCRawOf(*this) != getUTCRawOf(dt2);
+	}
+
+	template<class T, typename dtlib::enable_if<has_getCurrentDSTOffsetMinutes<T>::value && has_getTimeZoneOffsetMinutes<T>::value, int>::type = 0>
+	bool operator>=(const DateTimeBase<T>& dt2) const {
+		return getUTCRawOf(*this) >= getUTCRawOf(dt2);
+	}
+
+	template<class T, typename dtlib::enable_if<has_getCurrentDSTOffsetMinutes<T>::value && has_getTimeZoneOffsetMinutes<T>::value, int>::type = 0>
+	bool operator<=(const DateTimeBase<T>& dt2) const {
+		return getUTCRawOf(*this) <= getUTCRawOf(dt2);
+	}
+
+	template<class T, typename dtlib::enable_if<has_getCurrentDSTOffsetMinutes<T>::value && has_getTimeZoneOffsetMinutes<T>::value, int>::type = 0>
+	bool operator<(const DateTimeBase<T>& dt2) const {
+		return getUTCRawOf(*this) < getUTCRawOf(dt2);
+	}
+
+	template<class T, typename dtlib::enable_if<has_getCurrentDSTOffsetMinutes<T>::value && has_getTimeZoneOffsetMinutes<T>::value, int>::type = 0>
+	bool operator>(const DateTimeBase<T>& dt2) const {
+		return getUTCRawOf(*this) > getUTCRawOf(dt2);
+	}
+
+protected:
+
+	template<class T> friend class DateTimeBase;
+	template<class T, typename Y> friend struct has_getTimeZoneOffsetMinutes;
+	template<class T, typename Y> friend struct has_getCurrentDSTOffsetMinutes;
+	template<class T, typename Y> friend struct has_setRawTimeTD;
+	template<class T, typename Y> friend struct has_addRawTimeTD;
+
+	/**
+	* @brief Gets raw value converted to UTC.
+	*/
+	template<class T>
+	static int64_t getUTCRawOf(const DateTimeBase<T>& dt) {
+		int16_t ofs = static_cast<const T*>(&dt)->getTimeZoneOffsetMinutes() + static_cast<const T*>(&dt)->getCurrentDSTOffsetMinutes();
+		return dt.getRaw() - ((int64_t)ofs) * MINUTE;
+	}
+
+	void setRawTimeTD(int64_t val) {
+		//This function is called when some field is set. We will check here if DST is applyied.
+		const DSTAdjustment& adj = TimeZoneRegistry::getDST(zoneIndex);
+		int64_t dstOffset = ((int64_t)adj.getDSTOffsetTotalMinutes()) * MINUTE;
+		int64_t dtToCheck = DSTFlag ? val - dstOffset : val; //Getting time without DST
+		bool newDST = adj.checkDSTRegion(dtToCheck);
+		if (DSTFlag != newDST) {
+			val += newDST ? dstOffset : -dstOffset;
+			DSTFlag = newDST;
+		}
+		DateTimeBase<DateTimeTZRef>::setRawTimeNoTD(val); //This does not call setRawTimeTD(), because it would cause endless recursion
+	}
+
+	void addRawTimeTD(int64_t val) {
+		//This function is called when some add function is called. We will check here if DST is applyied.
+		const DSTAdjustment& adj = TimeZoneRegistry::getDST(zoneIndex);
+		int64_t dstOffset = ((int64_t)adj.getDSTOffsetTotalMinutes()) * MINUTE;
+		int64_t dtToCheck = val + DateTimeBase<DateTimeTZRef>::getRawTime();
+		if (DSTFlag) {
+			dtToCheck -= dstOffset; //Getting time without DST
+		}
+		bool newDST = adj.checkDSTRegion(dtToCheck);
+		if (DSTFlag != newDST) {
+			val += newDST ? dstOffset : -dstOffset;
+			DSTFlag = newDST;
+		}
+		DateTimeBase<DateTimeTZRef>::addRawTimeNoTD(val); //This does not call addRawTimeTD(), because it would cause endless recursion
+	}
+
+	TimeZoneRegistry::Index zoneIndex = TimeZoneRegistry::UTC;
+	bool DSTFlag = false;
+};
+
+#endif // !DATE_TIME_TZ_REF_H
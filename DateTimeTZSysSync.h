@@ -1557,6 +1557,8 @@ protected:
 	template<class T> friend class ::DateTimeBase;
 	template<class T> friend class ::DateTimeTZBase;
 	friend class DateTimeSysSync;
+	friend class SharedClock;
+	friend class DSTScheduler;
 	template<class T, typename Y> friend struct has_getRawTimeSync;
 	template<class T, typename Y> friend struct has_preSetSync;
 	template<class T, typename Y> friend struct has_getAndPreSetSync;
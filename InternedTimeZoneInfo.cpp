@@ -0,0 +1,79 @@
+#include "InternedTimeZoneInfo.h"
+
+#if DT_UNDER_OS > 0
+#include <cstring>
+#include <tuple>
+
+/**
+* @brief Gets DST transition rule as number, so rules can be ordered.
+*/
+static uint32_t getRuleBits(const DSTTransitionRule& rule) {
+	static_assert(sizeof(DSTTransitionRule) == sizeof(uint32_t), "DSTTransitionRule has to be 32-bit");
+	uint32_t bits;
+	memcpy(&bits, (const void*)&rule, sizeof(bits));
+	return bits;
+}
+
+bool InternedTimeZoneInfo::record_s::operator<(const record_s& r) const {
+	int16_t tz = timeZone.getTimeZoneOffsetTotalMinutes();
+	int16_t rTz = r.timeZone.getTimeZoneOffsetTotalMinutes();
+	int16_t dst = DST.getDSTOffsetTotalMinutes();
+	int16_t rDst = r.DST.getDSTOffsetTotalMinutes();
+	bool isDST = DST.isDST();
+	bool rIsDST = r.DST.isDST();
+	uint32_t start = getRuleBits(DST.DaylightTransitionStart);
+	uint32_t rStart = getRuleBits(r.DST.DaylightTransitionStart);
+	uint32_t end = getRuleBits(DST.DaylightTransitionEnd);
+	uint32_t rEnd = getRuleBits(r.DST.DaylightTransitionEnd);
+	return std::tie(tz, dst, isDST, start, end, keyName, standardABR, daylightABR, standardName, daylightName) <
+		std::tie(rTz, rDst, rIsDST, rStart, rEnd, r.keyName, r.standardABR, r.daylightABR, r.standardName, r.daylightName);
+}
+
+InternedTimeZoneInfo::InternedTimeZoneInfo(const TimeZoneInfo& tzinfo) {
+	record_s rec;
+	rec.timeZone = tzinfo.timeZone;
+	rec.DST = tzinfo.DST;
+	rec.standardName = tzinfo.standardName;
+	rec.daylightName = tzinfo.daylightName;
+	rec.keyName = tzinfo.keyName;
+	//Abbreviations do not have to be null terminated, when they fill whole buffer
+	rec.standardABR.assign(tzinfo.standardABR, strnlen(tzinfo.standardABR, TIME_ZONE_INFO_TZ_ABR_NAME_SIZE));
+	rec.daylightABR.assign(tzinfo.daylightABR, strnlen(tzinfo.daylightABR, TIME_ZONE_INFO_TZ_ABR_NAME_SIZE));
+
+	//Empty info is not pooled, so it is equal to default constructed one
+	static const record_s empty = record_s();
+	if (!(rec < empty) && !(empty < rec)) return;
+
+	std::lock_guard<std::mutex> lock(getMutex());
+	//Nodes of set are never moved, so pointer stays valid
+	record = &*getPool().insert(rec).first;
+}
+
+TimeZoneInfo InternedTimeZoneInfo::toTimeZoneInfo() const {
+	TimeZoneInfo tzinfo;
+	tzinfo.timeZone = getTimeZone();
+	tzinfo.DST = getDST();
+	tzinfo.standardName = getStandardName();
+	tzinfo.daylightName = getDaylightName();
+	tzinfo.keyName = getKeyName();
+	strncpy(tzinfo.standardABR, getStandardABR(), TIME_ZONE_INFO_TZ_ABR_NAME_SIZE);
+	strncpy(tzinfo.daylightABR, getDaylightABR(), TIME_ZONE_INFO_TZ_ABR_NAME_SIZE);
+	return tzinfo;
+}
+
+size_t InternedTimeZoneInfo::getPooledCount() {
+	std::lock_guard<std::mutex> lock(getMutex());
+	return getPool().size();
+}
+
+std::mutex& InternedTimeZoneInfo::getMutex() {
+	static std::mutex mutex;
+	return mutex;
+}
+
+InternedTimeZoneInfo::pool_t& InternedTimeZoneInfo::getPool() {
+	static pool_t pool;
+	return pool;
+}
+
+#endif // DT_UNDER_OS > 0
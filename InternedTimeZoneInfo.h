@@ -0,0 +1,165 @@
+/**
+ * @file InternedTimeZoneInfo.h
+ * @brief This file contains class InternedTimeZoneInfo, which is compact and immutable representation of TimeZoneInfo.
+ *
+ * Each distinct time zone info (time zone, DST adjustment, names and abbreviations) is stored only once in process-wide pool,
+ * so InternedTimeZoneInfo is only pointer to pooled record. It can be copied without any allocation.
+ *
+ * @see InternedTimeZoneInfo
+ *
+ * # Credits
+ * @author Matej Fitoš
+ */
+
+#ifndef _INTERNED_TIME_ZONE_INFO_H
+#define _INTERNED_TIME_ZONE_INFO_H
+
+#include "TimeZone.h"
+
+#if DT_UNDER_OS > 0
+#include <mutex>
+#include <set>
+#include <string>
+#include <type_traits>
+
+/**
+* @class InternedTimeZoneInfo
+* @brief Immutable time zone info, which lives in pool. Class is trivially copyable handle with size of one pointer.
+*
+* Pooled records are never released, so pointers returned by getters are valid until end of program.
+* Two equal interned infos share the same record, so comparison compares only one pointer.
+* @code{.cpp}
+* InternedTimeZoneInfo tzinfo(TimeZoneInfo::getSystemTZInfo()); //Names are pooled here
+* InternedTimeZoneInfo copy = tzinfo; //No allocation
+* TimeZoneInfo full = copy.toTimeZoneInfo();
+* @endcode
+*/
+class InternedTimeZoneInfo {
+public:
+
+	/**
+	* @brief Creates empty time zone info.
+	*/
+	InternedTimeZoneInfo() = default;
+
+	/**
+	* @brief Creates interned time zone info. Strings, which are not in pool yet, are copied to pool.
+	* @param tzinfo Time zone info to intern.
+	*/
+	explicit InternedTimeZoneInfo(const TimeZoneInfo& tzinfo);
+
+	/**
+	* @brief Converts interned time zone info back to TimeZoneInfo.
+	*/
+	TimeZoneInfo toTimeZoneInfo() const;
+
+	/**
+	* @brief Converts interned time zone info back to TimeZoneInfo.
+	*/
+	explicit operator TimeZoneInfo() const {
+		return toTimeZoneInfo();
+	}
+
+	/**
+	* @brief Gets time zone offset.
+	*/
+	inline TimeZone getTimeZone() const {
+		return (record != NULL) ? record->timeZone : TimeZone();
+	}
+
+	/**
+	* @brief Gets DST adjustment rules and offset.
+	*/
+	inline DSTAdjustment getDST() const {
+		return (record != NULL) ? record->DST : DSTAdjustment();
+	}
+
+	/**
+	* @brief Gets name of time zone without DST.
+	*/
+	inline const wchar_t* getStandardName() const {
+		return (record != NULL) ? record->standardName.c_str() : L"";
+	}
+
+	/**
+	* @brief Gets name of time zone with DST.
+	*/
+	inline const wchar_t* getDaylightName() const {
+		return (record != NULL) ? record->daylightName.c_str() : L"";
+	}
+
+	/**
+	* @brief Gets key name of time zone, for example "Europe/Paris".
+	*/
+	inline const char* getKeyName() const {
+		return (record != NULL) ? record->keyName.c_str() : "";
+	}
+
+	/**
+	* @brief Gets abbreviation time zone name, for example: "CET".
+	*/
+	inline const char* getStandardABR() const {
+		return (record != NULL) ? record->standardABR.c_str() : "";
+	}
+
+	/**
+	* @brief Gets abbreviation time zone name with DST, for example: "CEST".
+	*/
+	inline const char* getDaylightABR() const {
+		return (record != NULL) ? record->daylightABR.c_str() : "";
+	}
+
+	/**
+	* @brief Compares two interned time zone infos. Only pointers to pooled records are compared.
+	*/
+	bool operator==(const InternedTimeZoneInfo& tzinfo) const {
+		return record == tzinfo.record;
+	}
+
+	/**
+	* @brief Compares two interned time zone infos. Only pointers to pooled records are compared.
+	*/
+	bool operator!=(const InternedTimeZoneInfo& tzinfo) const {
+		return !(*this == tzinfo);
+	}
+
+	/**
+	* @brief Gets count of distinct time zone infos in pool.
+	*/
+	static size_t getPooledCount();
+
+private:
+	/**
+	* @struct record_s
+	* @brief Pooled time zone info. Abbreviations are always null terminated.
+	*/
+	struct record_s {
+		TimeZone timeZone;
+		DSTAdjustment DST;
+		std::wstring standardName;
+		std::wstring daylightName;
+		std::string keyName;
+		std::string standardABR;
+		std::string daylightABR;
+
+		/**
+		* @brief Orders records by all fields, so equal infos are found in pool.
+		*/
+		bool operator<(const record_s& r) const;
+	};
+
+	typedef std::set<record_s> pool_t;
+
+	static std::mutex& getMutex();
+
+	static pool_t& getPool();
+
+	const record_s* record = NULL;	//Record in pool, NULL for empty info
+};
+
+static_assert(std::is_trivially_copyable<InternedTimeZoneInfo>::value, "InternedTimeZoneInfo has to be trivially copyable");
+static_assert(sizeof(InternedTimeZoneInfo) == sizeof(void*), "InternedTimeZoneInfo has to be only pointer");
+
+#endif // DT_UNDER_OS > 0
+
+#endif // !_INTERNED_TIME_ZONE_INFO_H
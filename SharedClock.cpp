@@ -0,0 +1,100 @@
+#include "SharedClock.h"
+
+#if DT_UNDER_OS > 0 || defined(ESP32)
+#include <string.h>
+
+//Readers copy state into copy of this clock, because default constructor of DateTimeTZSysSync reads sync clock
+static const DateTimeTZSysSync blankClock;
+
+SharedClock::SharedClock() {
+	seq.store(0, std::memory_order_relaxed);
+	store(DateTimeTZSysSync());
+}
+
+SharedClock::SharedClock(const DateTimeTZSysSync& clock) {
+	seq.store(0, std::memory_order_relaxed);
+	store(clock);
+}
+
+void SharedClock::load(DateTimeTZSysSync& clock) const {
+	uint32_t buffer[WORDS];
+	uint32_t seqBefore;
+	uint32_t seqAfter;
+	do {
+		seqBefore = seq.load(std::memory_order_acquire);
+		for (size_t i = 0; i < WORDS; i++) {
+			buffer[i] = words[i].load(std::memory_order_relaxed);
+		}
+		std::atomic_thread_fence(std::memory_order_acquire);
+		seqAfter = seq.load(std::memory_order_relaxed);
+	} while ((seqBefore & 1) != 0 || seqBefore != seqAfter); //Writer was publishing, buffer can be torn
+	memcpy((void*)&clock, buffer, sizeof(DateTimeTZSysSync));
+}
+
+void SharedClock::store(const DateTimeTZSysSync& clock) {
+	uint32_t buffer[WORDS] = {};
+	memcpy(buffer, (const void*)&clock, sizeof(DateTimeTZSysSync));
+	uint32_t s = seq.load(std::memory_order_relaxed);
+	seq.store(s + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	for (size_t i = 0; i < WORDS; i++) {
+		words[i].store(buffer[i], std::memory_order_relaxed);
+	}
+	seq.store(s + 2, std::memory_order_release);
+}
+
+DateTimeTZSysSync SharedClock::get() const {
+	DateTimeTZSysSync clock(blankClock);
+	load(clock);
+	return clock;
+}
+
+DateTime SharedClock::now(bool& isDST) const {
+	DateTimeTZSysSync clock(blankClock);
+	load(clock);
+	DateTime_DST_tuple tup = clock.getDateTimeEnh();
+	isDST = tup.isDST;
+	return DateTime(tup.value);
+}
+
+DateTime SharedClock::nowUTC() const {
+	DateTimeTZSysSync clock(blankClock);
+	load(clock);
+	DateTime_DST_tuple tup = clock.getDateTimeEnh();
+	int64_t offset = (int64_t)clock.getTimeZoneOffset();
+	if (tup.isDST) {
+		offset += (int64_t)clock.getDSTOffset();
+	}
+	return DateTime(tup.value - offset);
+}
+
+TimeZone SharedClock::getTimeZone() const {
+	return get().getTimeZone();
+}
+
+DSTAdjustment SharedClock::getDST() const {
+	return get().getDST();
+}
+
+DateTime SharedClock::getNextDSTTransition() const {
+	return get().nextDSTTransitionDT;
+}
+
+void SharedClock::set(const DateTimeTZSysSync& clock) {
+	std::lock_guard<std::mutex> lock(writeMutex);
+	store(clock);
+}
+
+int64_t SharedClock::recalcDST() {
+	std::lock_guard<std::mutex> lock(writeMutex);
+	DateTimeTZSysSync clock(blankClock);
+	load(clock);
+	DateTimeTZSysSync old = clock;
+	int64_t ret = clock.recalcDST();
+	if (memcmp((const void*)&old, (const void*)&clock, sizeof(DateTimeTZSysSync)) != 0) {
+		store(clock);
+	}
+	return ret;
+}
+
+#endif // DT_UNDER_OS > 0 || defined(ESP32)
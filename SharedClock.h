@@ -0,0 +1,158 @@
+/**
+ * @file SharedClock.h
+ * @brief This file contains class SharedClock, which is DateTimeTZSysSync clock shared between threads.
+ *
+ * Base raw value, sync time, time zone, DST adjustment and next DST transition are published together under a seqlock.
+ * Readers never lock and never write shared memory, they only repeat reading when writer was publishing at the same time.
+ * Writers are serialized by mutex.
+ *
+ * @see SharedClock
+ *
+ * # Credits
+ * @author Matej Fitoš
+ */
+
+#ifndef _SHARED_CLOCK_H
+#define _SHARED_CLOCK_H
+
+#include "DateTimeTZSysSync.h"
+
+#if DT_UNDER_OS > 0 || defined(ESP32)
+#include <atomic>
+#include <mutex>
+#include <type_traits>
+
+/**
+* @class SharedClock
+* @brief DateTimeTZSysSync, which can be read and modified from many threads at once.
+*
+* Each reader gets consistent copy of the whole clock, so value, sync time, DST flag and next DST transition
+* always belong to the same state, even if another thread is just calling recalcDST() or setting new time.
+* @code{.cpp}
+* SharedClock clock(DateTimeTZSysSync::now());
+*
+* //Any thread:
+* bool isDST;
+* DateTime local = clock.now(isDST);
+* DateTimeTZSysSync copy = clock.get(); //Copy can be then used without any synchronization
+*
+* //Writer threads:
+* clock.recalcDST();
+* clock.set(DateTimeTZSysSync::now()); //Resync
+* clock.update([](DateTimeTZSysSync& dt) { dt.setTimeZone(TimeZone(TimeZones::CET)); });
+* @endcode
+*/
+class SharedClock {
+public:
+
+	/**
+	* @brief Default constructor, which sets clock to default value of DateTimeTZSysSync.
+	*/
+	SharedClock();
+
+	/**
+	* @brief Constructor, which sets clock from DateTimeTZSysSync.
+	* @param clock Clock to share.
+	*/
+	SharedClock(const DateTimeTZSysSync& clock);
+
+	SharedClock(const SharedClock&) = delete;
+	SharedClock& operator=(const SharedClock&) = delete;
+
+	/**
+	* @brief Gets consistent copy of shared clock.
+	* @return Returns copy, which is still synchronized with system clock.
+	*/
+	DateTimeTZSysSync get() const;
+
+	/**
+	* @brief Gets current local date and time.
+	* @param[out] isDST True if DST offset is applied to returned value.
+	* @return Returns current local date and time.
+	*/
+	DateTime now(bool& isDST) const;
+
+	/**
+	* @brief Gets current local date and time.
+	* @return Returns current local date and time.
+	*/
+	inline DateTime now() const {
+		bool isDST;
+		return now(isDST);
+	}
+
+	/**
+	* @brief Gets current UTC date and time.
+	* @return Returns current UTC date and time.
+	*/
+	DateTime nowUTC() const;
+
+	/**
+	* @brief Gets time zone of shared clock.
+	*/
+	TimeZone getTimeZone() const;
+
+	/**
+	* @brief Gets DST adjustment rules of shared clock.
+	*/
+	DSTAdjustment getDST() const;
+
+	/**
+	* @brief Gets next DST transition date and time. It is local time, which is compared with current value of clock.
+	* @return Returns next DST transition or DateTime::MaxValue if there is no DST.
+	*/
+	DateTime getNextDSTTransition() const;
+
+	/**
+	* @brief Replaces shared clock by new one. It can be used for setting of time or for resynchronization.
+	* @param clock New clock.
+	*/
+	void set(const DateTimeTZSysSync& clock);
+
+	/**
+	* @brief Calls DateTimeTZSysSync::recalcDST() of shared clock. New state is published only if it was changed.
+	* @return Returns raw value at time, when calculation was done.
+	*/
+	int64_t recalcDST();
+
+	/**
+	* @brief Modifies shared clock by given function. Function gets copy of clock, which is published after function returns.
+	* @param func Function or lambda with parameter DateTimeTZSysSync&.
+	* @note Other writers are blocked until function returns, readers are not blocked.
+	*/
+	template<class F>
+	void update(F func) {
+		std::lock_guard<std::mutex> lock(writeMutex);
+		DateTimeTZSysSync clock;
+		load(clock);
+		func(clock);
+		store(clock);
+	}
+
+private:
+	static_assert(std::is_trivially_copyable<DateTimeTZSysSync>::value, "DateTimeTZSysSync has to be trivially copyable");
+
+	//32-bit words, because 64-bit atomics are not lock-free on 32-bit MCUs (ESP32)
+	static constexpr size_t WORDS = (sizeof(DateTimeTZSysSync) + sizeof(uint32_t) - 1) / sizeof(uint32_t);
+
+	/**
+	* @brief Reads consistent state of clock. Reading is repeated only if writer was publishing at the same time.
+	* @param[out] clock Read clock.
+	*/
+	void load(DateTimeTZSysSync& clock) const;
+
+	/**
+	* @brief Publishes new state of clock.
+	* @param clock Clock to publish.
+	* @note Write mutex has to be locked.
+	*/
+	void store(const DateTimeTZSysSync& clock);
+
+	std::atomic<uint32_t> seq;				//Sequence counter, it is odd while state is published
+	std::atomic<uint32_t> words[WORDS];		//State of DateTimeTZSysSync
+	std::mutex writeMutex;
+};
+
+#endif // DT_UNDER_OS > 0 || defined(ESP32)
+
+#endif // !_SHARED_CLOCK_H
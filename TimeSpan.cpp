@@ -1,124 +1,11 @@
 #include "TimeSpan.h"
 
-TimeSpan::TimeSpan(int32_t days, int32_t hours, int32_t minutes, int32_t seconds, int32_t milliseconds, int32_t microseconds) {
-	set(days, hours, minutes, seconds, milliseconds, microseconds);
-}
-
-//Days can be negative, other fields has to be always positive
-void TimeSpan::set(int32_t days, int32_t hours, int32_t minutes, int32_t seconds, int32_t milliseconds, int32_t microseconds) {
-	raw_time = (int64_t)days * DAY;
-	raw_time += (int64_t)hours * HOUR;
-	raw_time += (int64_t)minutes * MINUTE;
-	raw_time += (int64_t)seconds * SECOND;
-	raw_time += (int64_t)milliseconds * MILLISECOND;
-	raw_time += (int64_t)microseconds * MICROSECOND;
-}
-
-void TimeSpan::set(time_span_s ts) {
-	raw_time = (int64_t)ts.days * DAY;
-	raw_time += (int64_t)ts.hours * HOUR;
-	raw_time += (int64_t)ts.minutes * MINUTE;
-	raw_time += (int64_t)ts.seconds * SECOND;
-	raw_time += (int64_t)ts.milliseconds * MILLISECOND;
-	raw_time += (int64_t)ts.microseconds * MICROSECOND;
-}
-
-time_span_s TimeSpan::getTimeSpanStruct() const {
-	time_span_s ret;
-	int64_t val = raw_time;
-	ret.days = (int32_t)(val / DAY);
-	val = val % DAY;
-	ret.hours = (int8_t)(val / HOUR);
-	val = val % HOUR;
-	ret.minutes = (int8_t)(val / MINUTE);
-	val = val % MINUTE;
-	ret.seconds = (int8_t)(val / SECOND);
-	val = val % SECOND;
-	ret.milliseconds = (int16_t)(val / MILLISECOND);
-	val = val % MILLISECOND;
-	ret.microseconds = (int16_t)val;
-	return ret;
-}
-
-void TimeSpan::setDays(int32_t days) {
-	raw_time = raw_time % DAY + ((int64_t)days) * DAY;
-	
-	/*bool oldPositive = raw_time >= 0;
-	bool currentPositive = days >= 0;
-
-	if (oldPositive != currentPositive) {
-		//Negation of other fields needed
-		raw_time = -(raw_time % DAY) + ((int64_t)days) * DAY;
-	}
-	else {
-		//Just basic calculation
-		raw_time = raw_time % DAY + ((int64_t)days) * DAY;
-	}*/
-}
-
-int32_t TimeSpan::getDays() const {
-	return (int32_t)(raw_time / DAY);
-}
-
-void TimeSpan::setHours(int8_t hours) {
-	int64_t micr = raw_time % DAY;
-	int8_t old_hours = (int8_t)(micr / HOUR);
-	raw_time -= ((int64_t)(hours - (int8_t)old_hours)) * HOUR;
-}
-
-int8_t TimeSpan::getHours() const {
-	return (int8_t)((raw_time % DAY) / HOUR);
-}
-
-void TimeSpan::setMinutes(int8_t minutes) {
-	int64_t micr = raw_time % HOUR;
-	int8_t old_minutes = (int8_t)(micr / MINUTE);
-	raw_time -= ((int64_t)(minutes - (int8_t)old_minutes)) * MINUTE;
-}
-
-int8_t TimeSpan::getMinutes() const {
-	return (int8_t)((raw_time % HOUR) / MINUTE);
-}
-
-void TimeSpan::setSeconds(int8_t seconds) {
-	int64_t micr = raw_time % MINUTE;
-	int8_t old_seconds = (int8_t)(micr / SECOND);
-	raw_time -= ((int64_t)(seconds - (int8_t)old_seconds)) * SECOND;
-}
-
-int8_t TimeSpan::getSeconds() const {
-	return (int8_t)((raw_time % MINUTE) / SECOND);
-}
-
-void TimeSpan::setMilliseconds(int16_t milliseconds) {
-	int64_t micr = raw_time % SECOND;
-	int16_t old_milliseconds = (int8_t)(micr / MILLISECOND);
-	raw_time -= ((int64_t)(milliseconds - (int8_t)old_milliseconds)) * MILLISECOND;
-}
-
-int16_t TimeSpan::getMilliseconds() const {
-	return (int16_t)((raw_time % SECOND) / MILLISECOND);
-}
-
-void TimeSpan::setMicroseconds(int16_t microseconds) {
-	int64_t micr = raw_time % MILLISECOND;
-	int16_t old_microseconds = (int8_t)(micr / MILLISECOND);
-	raw_time -= ((int64_t)(microseconds - (int8_t)old_microseconds)) * MILLISECOND;
-}
-
-int16_t TimeSpan::getMicroseconds() const {
-	return (int16_t)((raw_time % MILLISECOND) / MICROSECOND);
-}
-
-TimeSpan TimeSpan::getDuration() const {
-	//Absolute value
-	if (raw_time >= 0) return *this;
-	else return TimeSpan(-raw_time);
-}
-
+#if DT_CPP_VERSION < 201703L
+//Before C++17 constants cannot be defined as inline variables in header
 const TimeSpan TimeSpan::MaxValue = TimeSpan(INT64_MAX);
 const TimeSpan TimeSpan::MinValue = TimeSpan(INT64_MIN);
-const TimeSpan TimeSpan::Zero = TimeSpan(0LL);
+const TimeSpan TimeSpan::Zero = TimeSpan((int64_t)0);
+#endif // DT_CPP_VERSION < 201703L
 
 char* TimeSpan::toArray(char* buffer, size_t bufferSize, const char* format) const {
 	if (bufferSize == 0) return buffer;
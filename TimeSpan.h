@@ -13,11 +13,13 @@
 #define _TIME_SPAN_H
 
 #include "DateTimeHelpers.h"
+#include "DateTimeFormat.h"
+#include "DTString.h"
 
 struct time_span_s {
-    time_span_s() {}
+    constexpr time_span_s() {}
 
-    time_span_s(int32_t days_, int8_t hours_, int8_t minutes_, int8_t seconds_, int16_t milliseconds_, int16_t microseconds_) :
+    constexpr time_span_s(int32_t days_, int8_t hours_, int8_t minutes_, int8_t seconds_, int16_t milliseconds_, int16_t microseconds_) :
         days(days_),
         hours(hours_),
         minutes(minutes_),
@@ -87,13 +89,13 @@ class TimeSpan
 {
 public:
     //constructors:
-    TimeSpan() : raw_time(0){ }
+    constexpr TimeSpan() : raw_time(0){ }
 
     /**
     * @brief Constructor, which constructs instance from raw value.
     * @param raw Raw value in microseconds.
     */
-    TimeSpan(int64_t raw) : raw_time(raw){ }
+    constexpr TimeSpan(int64_t raw) : raw_time(raw){ }
 
     /**
     * @brief Constructor, that sets all fields of the current TimeSpan. This is most efficient method how to set all fields.
@@ -106,7 +108,9 @@ public:
     * @param milliseconds Count of elapsed milliseconds.
     * @param microseconds Count of elapsed microseconds.
     */
-    TimeSpan(int32_t days, int32_t hours = 0, int32_t minutes = 0, int32_t seconds = 0, int32_t milliseconds = 0, int32_t microseconds = 0);
+    DT_CONSTEXPR14 TimeSpan(int32_t days, int32_t hours = 0, int32_t minutes = 0, int32_t seconds = 0, int32_t milliseconds = 0, int32_t microseconds = 0) {
+        set(days, hours, minutes, seconds, milliseconds, microseconds);
+    }
 
     /**
     * @brief Sets all fields of the current TimeSpan. This is most efficient method how to set all fields.
@@ -119,100 +123,167 @@ public:
     * @param milliseconds Count of elapsed milliseconds.
     * @param microseconds Count of elapsed microseconds.
     */
-    void set(int32_t days, int32_t hours = 0, int32_t minutes = 0, int32_t seconds = 0, int32_t milliseconds = 0, int32_t microseconds = 0);
+    DT_CONSTEXPR14 void set(int32_t days, int32_t hours = 0, int32_t minutes = 0, int32_t seconds = 0, int32_t milliseconds = 0, int32_t microseconds = 0) {
+        raw_time = (int64_t)days * DAY;
+        raw_time += (int64_t)hours * HOUR;
+        raw_time += (int64_t)minutes * MINUTE;
+        raw_time += (int64_t)seconds * SECOND;
+        raw_time += (int64_t)milliseconds * MILLISECOND;
+        raw_time += (int64_t)microseconds * MICROSECOND;
+    }
 
     /**
     * @brief Sets all time span fields from time_span_s structure.
     * @param ts TimeSpan structure.
     */
-    void set(time_span_s ts);
-
-    time_span_s getTimeSpanStruct() const;
-
-    void setDays(int32_t days);
-
-    inline void addDays(int32_t days) {
+    DT_CONSTEXPR14 void set(time_span_s ts) {
+        raw_time = (int64_t)ts.days * DAY;
+        raw_time += (int64_t)ts.hours * HOUR;
+        raw_time += (int64_t)ts.minutes * MINUTE;
+        raw_time += (int64_t)ts.seconds * SECOND;
+        raw_time += (int64_t)ts.milliseconds * MILLISECOND;
+        raw_time += (int64_t)ts.microseconds * MICROSECOND;
+    }
+
+    DT_CONSTEXPR14 time_span_s getTimeSpanStruct() const {
+        time_span_s ret;
+        int64_t val = raw_time;
+        ret.days = (int32_t)(val / DAY);
+        val = val % DAY;
+        ret.hours = (int8_t)(val / HOUR);
+        val = val % HOUR;
+        ret.minutes = (int8_t)(val / MINUTE);
+        val = val % MINUTE;
+        ret.seconds = (int8_t)(val / SECOND);
+        val = val % SECOND;
+        ret.milliseconds = (int16_t)(val / MILLISECOND);
+        val = val % MILLISECOND;
+        ret.microseconds = (int16_t)val;
+        return ret;
+    }
+
+    DT_CONSTEXPR14 void setDays(int32_t days) {
+        raw_time = raw_time % DAY + ((int64_t)days) * DAY;
+    }
+
+    DT_CONSTEXPR14 void addDays(int32_t days) {
         raw_time += (int64_t)days * DAY;
     }
 
-    int32_t getDays() const;
+    constexpr int32_t getDays() const {
+        return (int32_t)(raw_time / DAY);
+    }
 
 
-    void setHours(int8_t hours);
+    DT_CONSTEXPR14 void setHours(int8_t hours) {
+        int64_t micr = raw_time % DAY;
+        int8_t old_hours = (int8_t)(micr / HOUR);
+        raw_time -= ((int64_t)(hours - (int8_t)old_hours)) * HOUR;
+    }
 
-    inline void addHours(int32_t hours) {
+    DT_CONSTEXPR14 void addHours(int32_t hours) {
         raw_time += (int64_t)hours * HOUR;
     }
 
-    inline void addHours(int64_t hours) {
+    DT_CONSTEXPR14 void addHours(int64_t hours) {
         raw_time += (int64_t)hours * HOUR;
     }
 
-    int8_t getHours() const;
+    constexpr int8_t getHours() const {
+        return (int8_t)((raw_time % DAY) / HOUR);
+    }
 
-    void setMinutes(int8_t minutes);
+    DT_CONSTEXPR14 void setMinutes(int8_t minutes) {
+        int64_t micr = raw_time % HOUR;
+        int8_t old_minutes = (int8_t)(micr / MINUTE);
+        raw_time -= ((int64_t)(minutes - (int8_t)old_minutes)) * MINUTE;
+    }
 
-    inline void addMinutes(int32_t minutes) {
+    DT_CONSTEXPR14 void addMinutes(int32_t minutes) {
         raw_time += (int64_t)minutes * MINUTE;
     }
 
-    inline void addMinutes(int64_t minutes) {
+    DT_CONSTEXPR14 void addMinutes(int64_t minutes) {
         raw_time += (int64_t)minutes * MINUTE;
     }
 
-    int8_t getMinutes() const;
+    constexpr int8_t getMinutes() const {
+        return (int8_t)((raw_time % HOUR) / MINUTE);
+    }
 
 
-    void setSeconds(int8_t seconds);
+    DT_CONSTEXPR14 void setSeconds(int8_t seconds) {
+        int64_t micr = raw_time % MINUTE;
+        int8_t old_seconds = (int8_t)(micr / SECOND);
+        raw_time -= ((int64_t)(seconds - (int8_t)old_seconds)) * SECOND;
+    }
 
-    inline void addSeconds(int32_t seconds) {
+    DT_CONSTEXPR14 void addSeconds(int32_t seconds) {
         raw_time += (int64_t)seconds * SECOND;
     }
 
-    inline void addSeconds(int64_t seconds) {
+    DT_CONSTEXPR14 void addSeconds(int64_t seconds) {
         raw_time += (int64_t)seconds * SECOND;
     }
 
-    int8_t getSeconds() const;
+    constexpr int8_t getSeconds() const {
+        return (int8_t)((raw_time % MINUTE) / SECOND);
+    }
 
 
-    void setMilliseconds(int16_t milliseconds);
+    DT_CONSTEXPR14 void setMilliseconds(int16_t milliseconds) {
+        int64_t micr = raw_time % SECOND;
+        int16_t old_milliseconds = (int8_t)(micr / MILLISECOND);
+        raw_time -= ((int64_t)(milliseconds - (int8_t)old_milliseconds)) * MILLISECOND;
+    }
 
-    inline void addMilliseconds(int32_t milliseconds) {
+    DT_CONSTEXPR14 void addMilliseconds(int32_t milliseconds) {
         raw_time += (int64_t)milliseconds * MILLISECOND;
     }
 
-    inline void addMilliseconds(int64_t milliseconds) {
+    DT_CONSTEXPR14 void addMilliseconds(int64_t milliseconds) {
         raw_time += (int64_t)milliseconds * MILLISECOND;
     }
 
-    int16_t getMilliseconds() const;
+    constexpr int16_t getMilliseconds() const {
+        return (int16_t)((raw_time % SECOND) / MILLISECOND);
+    }
 
 
-    void setMicroseconds(int16_t microseconds);
+    DT_CONSTEXPR14 void setMicroseconds(int16_t microseconds) {
+        int64_t micr = raw_time % MILLISECOND;
+        int16_t old_microseconds = (int8_t)(micr / MILLISECOND);
+        raw_time -= ((int64_t)(microseconds - (int8_t)old_microseconds)) * MILLISECOND;
+    }
 
-    inline void addMicroseconds(int32_t microseconds) {
+    DT_CONSTEXPR14 void addMicroseconds(int32_t microseconds) {
         raw_time += microseconds;
     }
 
-    inline void addMicroseconds(int64_t microseconds) {
+    DT_CONSTEXPR14 void addMicroseconds(int64_t microseconds) {
         raw_time += microseconds;
     }
 
-    int16_t getMicroseconds() const;
+    constexpr int16_t getMicroseconds() const {
+        return (int16_t)((raw_time % MILLISECOND) / MICROSECOND);
+    }
 
 
-    TimeSpan getDuration() const;
+    DT_CONSTEXPR14 TimeSpan getDuration() const {
+        //Absolute value
+        if (raw_time >= 0) return *this;
+        else return TimeSpan(-raw_time);
+    }
 
-    inline bool isNegative() const {
+    constexpr bool isNegative() const {
         return raw_time < 0;
     }
 
-    inline void setRaw(int64_t raw) {
+    DT_CONSTEXPR14 void setRaw(int64_t raw) {
         raw_time = raw;
     }
 
-    inline int64_t getRaw() const {
+    constexpr int64_t getRaw() const {
         return raw_time;
     }
 
@@ -314,128 +385,273 @@ public:
     std::string toString(const char* format) const;
 #endif // ARDUINO
 
+    /**
+    * @brief Converts TimeSpan to string using precompiled format.
+    * @param buffer Buffer, where string will be written.
+    * @param bufferSize Size of buffer including null terminator. Size format.getMaxLength() + 1 is always enough.
+    * @param format Precompiled time span format, it has to be created with target DateTimeFormat::TARGET_TIME_SPAN.
+    * @return Returns pointer to buffer, where null terminator was inserted.
+    */
+    char* toArray(char* buffer, size_t bufferSize, const DateTimeFormat& format) const {
+        return format.timeSpanToArray(buffer, bufferSize, raw_time);
+    }
+
+    /**
+    * @brief Converts TimeSpan to string using precompiled format.
+    * @param format Precompiled time span format, it has to be created with target DateTimeFormat::TARGET_TIME_SPAN.
+    * @return Returns converted string.
+    */
+#ifdef ARDUINO
+    String toString(const DateTimeFormat& format) const {
+#else
+    std::string toString(const DateTimeFormat& format) const {
+#endif // ARDUINO
+        char buffer[DT_FORMAT_MAX_LENGTH + 1];
+        format.timeSpanToArray(buffer, sizeof(buffer) / sizeof(char), raw_time);
+        return buffer;
+    }
+
+    /**
+    * @brief Converts TimeSpan to string with fixed capacity, which is returned by value without heap allocation.
+    * @tparam N Capacity of returned string. Longer result is truncated.
+    * @param format Custom time span format, see toArray() for format specifiers.
+    * @return Returns converted string.
+    */
+    template<size_t N = DT_STRING_DEFAULT_CAPACITY>
+    DTString<N> toDTString(const char* format) const {
+        DTString<N> ret;
+        ret.setLength(toArray(ret.data(), N + 1, format) - ret.data());
+        return ret;
+    }
+
+    /**
+    * @brief Converts TimeSpan to string with fixed capacity using precompiled format. String is returned by value without heap allocation.
+    * @tparam N Capacity of returned string. Default capacity is always enough.
+    * @param format Precompiled time span format, it has to be created with target DateTimeFormat::TARGET_TIME_SPAN.
+    * @return Returns converted string.
+    */
+    template<size_t N = DT_FORMAT_MAX_LENGTH>
+    DTString<N> toDTString(const DateTimeFormat& format) const {
+        DTString<N> ret;
+        ret.setLength(format.timeSpanToArray(ret.data(), N + 1, raw_time) - ret.data());
+        return ret;
+    }
+
+    /**
+    * @brief Appends TimeSpan to the end of string. Result is written to stack buffer at first, so no memory is allocated,
+    * when string has enough capacity.
+    * @param str String, where TimeSpan will be appended.
+    * @param format Custom time span format, see toArray() for format specifiers.
+    */
+#ifdef ARDUINO
+    void appendTo(String& str, const char* format) const {
+#else
+    void appendTo(std::string& str, const char* format) const {
+#endif // ARDUINO
+        char buffer[DT_APPEND_BUFFER_SIZE];
+        char* newBuff = toArray(buffer, sizeof(buffer) / sizeof(char), format);
+        if ((size_t)(newBuff - buffer) < sizeof(buffer) / sizeof(char) - 1) {
+            str += buffer;
+        }
+        else {
+            str += toString(format); //Result could be truncated, so it is converted again without limit
+        }
+    }
+
+    /**
+    * @brief Appends TimeSpan to the end of string using precompiled format. No memory is allocated, when string has enough capacity.
+    * @param str String, where TimeSpan will be appended.
+    * @param format Precompiled time span format, it has to be created with target DateTimeFormat::TARGET_TIME_SPAN.
+    */
+#ifdef ARDUINO
+    void appendTo(String& str, const DateTimeFormat& format) const {
+#else
+    void appendTo(std::string& str, const DateTimeFormat& format) const {
+#endif // ARDUINO
+        char buffer[DT_FORMAT_MAX_LENGTH + 1];
+        format.timeSpanToArray(buffer, sizeof(buffer) / sizeof(char), raw_time);
+        str += buffer;
+    }
+
+    /**
+    * @brief Writes TimeSpan to output iterator, for example std::back_inserter() or pointer to character array.
+    * Result is written to stack buffer at first, so no memory is allocated by this function.
+    * @param out Output iterator, which accepts characters. Null terminator is not written.
+    * @param format Custom time span format, see toArray() for format specifiers.
+    * @return Returns output iterator after the last written character.
+    */
+    template<class OutputIt>
+    OutputIt formatTo(OutputIt out, const char* format) const {
+        char buffer[DT_APPEND_BUFFER_SIZE];
+        char* newBuff = toArray(buffer, sizeof(buffer) / sizeof(char), format);
+        if ((size_t)(newBuff - buffer) < sizeof(buffer) / sizeof(char) - 1) {
+            for (const char* c = buffer; c < newBuff; c++) {
+                *out++ = *c;
+            }
+        }
+        else {
+            //Result could be truncated, so it is converted again without limit
+            auto str = toString(format);
+            for (size_t i = 0; i < str.length(); i++) {
+                *out++ = str[i];
+            }
+        }
+        return out;
+    }
+
+    /**
+    * @brief Writes TimeSpan to output iterator using precompiled format.
+    * @param out Output iterator, which accepts characters. Null terminator is not written.
+    * @param format Precompiled time span format, it has to be created with target DateTimeFormat::TARGET_TIME_SPAN.
+    * @return Returns output iterator after the last written character.
+    */
+    template<class OutputIt>
+    OutputIt formatTo(OutputIt out, const DateTimeFormat& format) const {
+        char buffer[DT_FORMAT_MAX_LENGTH + 1];
+        char* newBuff = format.timeSpanToArray(buffer, sizeof(buffer) / sizeof(char), raw_time);
+        for (const char* c = buffer; c < newBuff; c++) {
+            *out++ = *c;
+        }
+        return out;
+    }
+
+#ifdef ARDUINO
+    /**
+    * @brief Prints TimeSpan to specified stream using precompiled format.
+    * @param[in] p Stream, where to print.
+    * @param format Precompiled time span format, it has to be created with target DateTimeFormat::TARGET_TIME_SPAN.
+    * @return Returns count of printed characters.
+    */
+    size_t printTo(Print& p, const DateTimeFormat& format) const {
+        char buffer[DT_FORMAT_MAX_LENGTH + 1];
+        char* newBuff = format.timeSpanToArray(buffer, sizeof(buffer) / sizeof(char), raw_time);
+        p.print(buffer);
+        return (size_t)(newBuff - buffer);
+    }
+#endif // ARDUINO
+
     const static TimeSpan MaxValue;
     const static TimeSpan MinValue;
     const static TimeSpan Zero;
 
-    static inline TimeSpan FromMicroseconds(int64_t micros) {
+    static constexpr TimeSpan FromMicroseconds(int64_t micros) {
         return TimeSpan(micros * MICROSECOND);
     }
 
-    static inline TimeSpan FromMilliseconds(int64_t milliseconds) {
+    static constexpr TimeSpan FromMilliseconds(int64_t milliseconds) {
         return TimeSpan(milliseconds * MILLISECOND);
     }
 
-    static inline TimeSpan FromSeconds(int64_t seconds) {
+    static constexpr TimeSpan FromSeconds(int64_t seconds) {
         return TimeSpan(seconds * SECOND);
     }
 
-    static inline TimeSpan FromMinutes(int64_t minutes) {
+    static constexpr TimeSpan FromMinutes(int64_t minutes) {
         return TimeSpan(minutes * MINUTE);
     }
 
-    static inline TimeSpan FromHours(int64_t hours) {
+    static constexpr TimeSpan FromHours(int64_t hours) {
         return TimeSpan(hours * HOUR);
     }
 
-    static inline TimeSpan FromDays(int64_t days) {
+    static constexpr TimeSpan FromDays(int64_t days) {
         return TimeSpan(days * DAY);
     }
 
     //operators:
-    explicit operator int64_t() const {
+    explicit constexpr operator int64_t() const {
         return raw_time;
     }
 
-    explicit operator int64_t() {
+    explicit DT_CONSTEXPR14 operator int64_t() {
         return raw_time;
     }
 
-    TimeSpan operator-() const{
+    constexpr TimeSpan operator-() const{
         return TimeSpan(-raw_time);
     }
 
-    TimeSpan operator+(const TimeSpan& ts2) const {
+    constexpr TimeSpan operator+(const TimeSpan& ts2) const {
         return TimeSpan(raw_time + ts2.getRaw());
     }
 
-    TimeSpan operator+(const int64_t raw) const {
+    constexpr TimeSpan operator+(const int64_t raw) const {
         return TimeSpan(raw_time + raw);
     }
 
-    TimeSpan operator-(const TimeSpan& ts2) const {
+    constexpr TimeSpan operator-(const TimeSpan& ts2) const {
         return TimeSpan(raw_time - ts2.getRaw());
     }
 
-    TimeSpan operator-(const int64_t raw) const {
+    constexpr TimeSpan operator-(const int64_t raw) const {
         return TimeSpan(raw_time - raw);
     }
 
-    TimeSpan& operator+=(TimeSpan& ts2) {
+    DT_CONSTEXPR14 TimeSpan& operator+=(const TimeSpan& ts2) {
         raw_time += ts2.getRaw();
         return *this;
     }
 
-    TimeSpan& operator+=(const int64_t _raw) {
+    DT_CONSTEXPR14 TimeSpan& operator+=(const int64_t _raw) {
         raw_time += _raw;
         return *this;
     }
 
-    TimeSpan& operator-=(TimeSpan& ts2) {
+    DT_CONSTEXPR14 TimeSpan& operator-=(const TimeSpan& ts2) {
         raw_time -= ts2.getRaw();
         return *this;
     }
 
-    TimeSpan& operator-=(const int64_t _raw) {
+    DT_CONSTEXPR14 TimeSpan& operator-=(const int64_t _raw) {
         raw_time -= _raw;
         return *this;
     }
 
-    bool operator==(const TimeSpan& ts2) const {
+    constexpr bool operator==(const TimeSpan& ts2) const {
         return raw_time == ts2.getRaw();
     }
 
-    bool operator==(const int64_t raw) const {
+    constexpr bool operator==(const int64_t raw) const {
         return raw_time == raw;
     }
 
-    bool operator!=(const TimeSpan& ts2) const {
+    constexpr bool operator!=(const TimeSpan& ts2) const {
         return raw_time != ts2.getRaw();
     }
 
-    bool operator!=(const int64_t raw) const {
+    constexpr bool operator!=(const int64_t raw) const {
         return raw_time != raw;
     }
 
-    bool operator>=(const TimeSpan& ts2) const {
+    constexpr bool operator>=(const TimeSpan& ts2) const {
         return raw_time >= ts2.getRaw();
     }
 
-    bool operator>=(const int64_t raw) const {
+    constexpr bool operator>=(const int64_t raw) const {
         return raw_time >= raw;
     }
 
-    bool operator<=(const TimeSpan& ts2) const {
+    constexpr bool operator<=(const TimeSpan& ts2) const {
         return raw_time <= ts2.getRaw();
     }
 
-    bool operator<=(const int64_t raw) const {
+    constexpr bool operator<=(const int64_t raw) const {
         return raw_time <= raw;
     }
 
-    bool operator<(const TimeSpan& ts2) const {
+    constexpr bool operator<(const TimeSpan& ts2) const {
         return raw_time < ts2.getRaw();
     }
 
-    bool operator<(const int64_t raw) const {
+    constexpr bool operator<(const int64_t raw) const {
         return raw_time < raw;
     }
 
-    bool operator>(const TimeSpan& ts2) const {
+    constexpr bool operator>(const TimeSpan& ts2) const {
         return raw_time > ts2.getRaw();
     }
 
-    bool operator>(const int64_t raw) const {
+    constexpr bool operator>(const int64_t raw) const {
         return raw_time > raw;
     }
 
@@ -443,4 +659,83 @@ private:
     int64_t raw_time = 0;
 };
 
+#if DT_CPP_VERSION >= 201703L
+inline constexpr TimeSpan TimeSpan::MaxValue = TimeSpan(INT64_MAX);
+inline constexpr TimeSpan TimeSpan::MinValue = TimeSpan(INT64_MIN);
+inline constexpr TimeSpan TimeSpan::Zero = TimeSpan((int64_t)0);
+#endif // DT_CPP_VERSION >= 201703L
+
+namespace dtlib {
+
+    /**
+    * @brief Called by TimeSpan literals, when value does not fit to TimeSpan. This function is not constexpr,
+    * so such literal fails to compile.
+    */
+    inline int64_t timeSpanLiteralOverflow() {
+        return 0;
+    }
+
+    /**
+    * @brief Multiplies value of TimeSpan literal by unit.
+    * @param val Value of literal.
+    * @param unit Unit of literal in microseconds.
+    * @return Returns raw value of TimeSpan.
+    */
+    constexpr int64_t timeSpanLiteralToRaw(unsigned long long val, int64_t unit) {
+        return val > (unsigned long long)(INT64_MAX / unit) ? timeSpanLiteralOverflow() : (int64_t)val * unit;
+    }
+
+    /**
+    * @brief User defined literals for TimeSpan. They can be used after "using namespace dtlib::literals;", for example:
+    * @code
+    * TimeSpan timeout = 1500_ms;
+    * TimeSpan period = 2_h + 30_min;
+    * @endcode
+    */
+    inline namespace literals {
+
+        /**
+        * @brief Creates TimeSpan from count of days.
+        */
+        DT_CONSTEVAL TimeSpan operator""_d(unsigned long long days) {
+            return TimeSpan(timeSpanLiteralToRaw(days, DAY));
+        }
+
+        /**
+        * @brief Creates TimeSpan from count of hours.
+        */
+        DT_CONSTEVAL TimeSpan operator""_h(unsigned long long hours) {
+            return TimeSpan(timeSpanLiteralToRaw(hours, HOUR));
+        }
+
+        /**
+        * @brief Creates TimeSpan from count of minutes.
+        */
+        DT_CONSTEVAL TimeSpan operator""_min(unsigned long long minutes) {
+            return TimeSpan(timeSpanLiteralToRaw(minutes, MINUTE));
+        }
+
+        /**
+        * @brief Creates TimeSpan from count of seconds.
+        */
+        DT_CONSTEVAL TimeSpan operator""_s(unsigned long long seconds) {
+            return TimeSpan(timeSpanLiteralToRaw(seconds, SECOND));
+        }
+
+        /**
+        * @brief Creates TimeSpan from count of milliseconds.
+        */
+        DT_CONSTEVAL TimeSpan operator""_ms(unsigned long long milliseconds) {
+            return TimeSpan(timeSpanLiteralToRaw(milliseconds, MILLISECOND));
+        }
+
+        /**
+        * @brief Creates TimeSpan from count of microseconds.
+        */
+        DT_CONSTEVAL TimeSpan operator""_us(unsigned long long microseconds) {
+            return TimeSpan(timeSpanLiteralToRaw(microseconds, MICROSECOND));
+        }
+    }
+}
+
 #endif // !_TIME_SPAN_H
\ No newline at end of file
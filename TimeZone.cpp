@@ -19,120 +19,28 @@
 #endif // defined(ARDUINO)
 
 
-#if DT_UNDER_OS == DT_LINUX ||  DT_UNDER_OS == DT_MAC
-//TODO those functions are HACK for Linux and Mac time zone and DST offset - there are used temporarily,
-//     remove them adter proper implementation for reading system TimeZone is done
-
-#include <ctime>
-#include <iomanip>
-#include <sstream>
-
-/**
-* @brief Gets UTC offset at specified time.
-* @param when Time, which UTC offset will be get.
-* @param[out] isDST True if DST is applyied to offset.
-* @return Returns UTC offset in minutes.
-*/
-static int getUTCOffset(time_t when, bool& isDST) {
-
-    struct tm timeinfo;
-#if _MSC_VER && !__INTEL_COMPILER
-    //Specific code for MVSC
-    localtime_s(&timeinfo, &when);
-#else
-    timeinfo = *localtime(&when);
-#endif
-
-    isDST = timeinfo.tm_isdst;
-
-    std::ostringstream os;
-    os << std::put_time(&timeinfo, "%z");
-    std::string s = os.str();
-    // s is in ISO 8601 format: "HHMM"
-    int h = std::stoi(s.substr(0, 3), nullptr, 10);
-    int m = std::stoi(s[0] + s.substr(3), nullptr, 10);
-    if (s.length() > 0 && s[0] == '-') {
-        //Negative offset
-        return h * 60 - m;
-    }
-    else {
-        //Positive offset
-        return h * 60 + m;
-    }
+#if DT_UNDER_OS == DT_LINUX || DT_UNDER_OS == DT_MAC
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "TimeZoneDB.h"
+#endif // DT_UNDER_OS == DT_LINUX || DT_UNDER_OS == DT_MAC
+
+#if DT_SUPPORTS_GET_SYSTZ != 0 || DT_SUPPORTS_SET_SYSTZ != 0
+#include <cstring>
+#if DT_UNDER_OS > 0 || defined(ESP32)
+#include <mutex>
+static std::mutex& getSysTZMutex() {
+    static std::mutex mutex;
+    return mutex;
 }
-
-/**
-* @brief Gets system time zone offset and DST offset.
-* and DST offset.
-* @param[out] TZ_mins Time zone offset without DST in minutes.
-* @param[out] DST_mins DST offset in minutes. If system does not use DST, it will be set to 0.
-*/
-static void getSysTZandDST(int& TZ_mins, int& DST_mins) {
-    int changeCnt = 0;
-
-    bool DST_old = false;
-    int tz_old = 0;
-    //Checking 5 dates and reading it's UTC offset
-    for (long long i = 0; i <= 86400LL * 365; i += 86400LL * 91) {
-        bool DST_new;
-        int tz_new = getUTCOffset(i, DST_new);
-        if (DST_old != DST_new || tz_old != tz_new) {
-            changeCnt++;
-            if (changeCnt == 2) {
-                if (DST_old != DST_new) {
-                    //DST flag works as expected
-                    if (DST_new) {
-                        DST_mins = tz_new - tz_old;
-                        TZ_mins = tz_old;
-                    }
-                    else {
-                        DST_mins = tz_old - tz_new;
-                        TZ_mins = tz_new;
-                    }
-                }
-                else {
-                    //DST flag does not works, but UTC offset has changed.
-                    //We are assumimg, that DST offset is positive
-                    if (tz_new > tz_old) {
-                        DST_mins = tz_new - tz_old;
-                        TZ_mins = tz_old;
-                    }
-                    else {
-                        DST_mins = tz_old - tz_new;
-                        TZ_mins = tz_new;
-                    }
-                }
-                return;
-            }
-
-            DST_old = DST_new;
-            tz_old = tz_new;
-        }
-    }
-    //No DST on current system time
-    TZ_mins = tz_old;
-    DST_mins = 0;
-}
-
-/**
-* @brief Gets system time zone.
-* @param includingDST True if time zone has to include DST offset.
-* @return Returns system time zone.
-*/
-static TimeZone getSysTZ(bool includingDST) {
-    int TZ_offset, DST_offset;
-    getSysTZandDST(TZ_offset, DST_offset);
-
-    if (includingDST) {
-        TimeZones tzs = (TZ_offset + DST_offset) / 15;
-        return TimeZone(tzs);
-    }
-    else {
-        TimeZones tzs = (TZ_offset) / 15;
-        return TimeZone(tzs);
-    }
-}
-#endif // DT_UNDER_OS == DT_LINUX
+#define DT_SYSTZ_LOCK() std::lock_guard<std::mutex> sysTZLock(getSysTZMutex()) //Serializes writers of system time zone snapshot
+#else
+#define DT_SYSTZ_LOCK()
+#endif // DT_UNDER_OS > 0 || defined(ESP32)
+#endif // DT_SUPPORTS_GET_SYSTZ != 0 || DT_SUPPORTS_SET_SYSTZ != 0
 
 
 #if DT_SUPPORTS_GET_SYSTZ != 0
@@ -186,44 +94,6 @@ void DSTAdjustment::setSystemDST(DSTAdjustment dst) {
 #endif // DT_SUPPORTS_GET_SYSTZ != 0
 
 
-void DSTTransitionRule::setFixed(hour_t transitionHour, uint16_t dayOfYear) {
-    transitionHour.convertTo24();
-    rawValue = (DSTTRT_Fixed & 0x03U) | ((dayOfYear & 0x03FFU) << 2) | (((uint32_t)(transitionHour & 0x3FU)) << 16);
-}
-
-void DSTTransitionRule::setDate(hour_t transitionHour, Month month, uint8_t dayOfMonth, int8_t dayOffset) {
-    transitionHour.convertTo24();
-    bool negativeOffset = dayOffset < 0;
-    uint8_t dayOffsetABS = (negativeOffset) ? (-1 - dayOffset) : dayOffset;
-    rawValue = (DSTTRT_Date & 0x03U) | ((month & 0x0FU) << 2) | (((uint32_t)(dayOfMonth & 0x3FU)) << 6) | (((uint32_t)(dayOffsetABS & 0x07U)) << 12) | (((uint32_t)negativeOffset) << 15) | (((uint32_t)(transitionHour & 0x3FU)) << 16);
-}
-
-void DSTTransitionRule::setFloating(hour_t transitionHour, Month month, DayOfWeek dayOfWeek, WeekOfMonth weekOfMonth, int8_t dayOffset) {
-    transitionHour.convertTo24();
-    bool negativeOffset = dayOffset < 0;
-    uint8_t dayOffsetABS = (negativeOffset) ? (-1 - dayOffset) : dayOffset;
-    rawValue = (DSTTRT_Floating & 0x03U) | ((month & 0x0FU) << 2) | ((dayOfWeek & 0x07U) << 6) | (((uint32_t)(weekOfMonth & 0x07U)) << 9) | (((uint32_t)(dayOffsetABS & 0x07U)) << 12) | (((uint32_t)negativeOffset) << 15) | (((uint32_t)(transitionHour & 0x3FU)) << 16);
-}
-
-int8_t DSTTransitionRule::getDaysOffset() const {
-    int8_t dayOffset = (rawValue >> 12) & 0x07U;
-    if (rawValue & 0x8000U) {
-        //Negative
-        return -dayOffset - 1;
-    }
-    else {
-        //Positive
-        return dayOffset;
-    }
-}
-
-void DSTTransitionRule::setDaysOffset(int8_t val) {
-    bool negativeOffset = val < 0;
-    uint8_t dayOffsetABS = (negativeOffset) ? (-1 - val) : val;
-    rawValue = (rawValue & (~(0x0FUL << 12UL))) | (((uint32_t)(dayOffsetABS & 0x07UL)) << 12) | (((uint32_t)negativeOffset) << 15);
-}
-
-
 uint16_t DSTTransitionRule::getDayOfYearOfTransition(int32_t year) const {
     if (noDST()) return 0;
 
@@ -263,81 +133,122 @@ int64_t DSTTransitionRule::getDateOfTransitionRaw(int32_t year) const {
     return rawTime;
 }
 
-uint16_t DSTTransitionRule::getDayOfYearOfTransitionHelper(int32_t daysUntilFirstDayOfYear, bool isLeap) const {
-    DSTTransitionRuleType type = getType();
-    uint16_t dayOfYearTrans = 0;
-    Month month = getMonth();
-    int32_t dayOfYearUntilMonth = dtlib::getDayOfYearFromMonth(month, isLeap);
-    int32_t daysUntilFirstDayOfMonth = daysUntilFirstDayOfYear + dayOfYearUntilMonth;
+const DSTTransitionRule DSTTransitionRule::NoDST = DSTTransitionRule();
 
-    uint8_t dayOfWeekOffset = 0; //Day of week offset at first day of month
-    if (daysUntilFirstDayOfMonth < 0) {
-        //BC
-        dayOfWeekOffset = (7 + ((daysUntilFirstDayOfMonth - 5) % 7));
+
+#if DT_UNDER_OS > 0 || defined(ESP32)
+#define DT_DST_YEAR_CACHE_STORAGE thread_local
+#else
+#define DT_DST_YEAR_CACHE_STORAGE
+#endif // DT_UNDER_OS > 0 || defined(ESP32)
+
+const DSTAdjustment::dst_year_s& DSTAdjustment::getDSTYear(int64_t rawDT) const {
+    static DT_DST_YEAR_CACHE_STORAGE dst_year_s cache[DT_DST_YEAR_CACHE_SIZE] = {};
+    static DT_DST_YEAR_CACHE_STORAGE uint8_t last = 0;
+
+    //Rules and offset identify DST adjustment
+    uint64_t key = getRulesKey();
+
+    //Consecutive calls usually check time from the same year, so year does not have to be computed
+    dst_year_s* entry = &cache[last];
+    if (entry->key == key && rawDT >= entry->yearStart && rawDT < entry->yearEnd) {
+        return *entry;
     }
-    else {
-        //AD
-        dayOfWeekOffset = (((daysUntilFirstDayOfMonth + 1) % 7) + 1);
-    }
-
-    if (type == DSTTRT_Floating) {
-        dayOfYearTrans = dtlib::getDayOfYearFromMonth(month, isLeap); //Getting count of days from month
-        uint8_t wom = (uint8_t)getWeekOfMonth() - 1;
-        uint8_t dow = getDayOfWeek();
-        uint8_t DoWoffset;
-        //dayOfWeekOffset is day of week of first day in month
-        if (dayOfWeekOffset <= dow) {
-            DoWoffset = dow - dayOfWeekOffset;
-        }
-        else {
-            DoWoffset = 7 - dayOfWeekOffset + dow;
-        }
-        uint8_t monthDaysAdd = wom * 7 + DoWoffset;
-        if (monthDaysAdd < month.getMonthLength(isLeap)) {
-            dayOfYearTrans += monthDaysAdd;
-        }
-        else {
-            dayOfYearTrans += 3 * 7 + DoWoffset;
-        }
-        dayOfYearTrans += getDaysOffset(); //Adding days offset
+
+    int32_t year = dtlib::getYearFromRaw(rawDT);
+    uint64_t hash = (key ^ (uint32_t)year) * 0x9E3779B97F4A7C15ULL;
+    last = (uint8_t)((hash >> 56) & (DT_DST_YEAR_CACHE_SIZE - 1));
+    entry = &cache[last];
+    if (entry->key != key || entry->year != year) {
+        computeDSTYear(year, *entry);
+        entry->key = key;
+    }
+    return *entry;
+}
+
+void DSTAdjustment::computeDSTYear(int32_t year, dst_year_s& entry) const {
+    bool isLeap = dtlib::isLeapYear(year);
+    int32_t daysUntilFirstDayOfYear = dtlib::getDaysUntilYear(year);
+    int64_t DSTOffset = ((int64_t)getDSTOffsetTotalMinutes()) * MINUTE;
+
+    uint16_t dayOfYearTransStart = 0;
+    uint16_t dayOfYearTransEnd = 0;
+    if (!getPresetTransitionDays(year, dayOfYearTransStart, dayOfYearTransEnd)) {
+        dayOfYearTransStart = DaylightTransitionStart.getDayOfYearOfTransitionHelper(daysUntilFirstDayOfYear, isLeap);
+        dayOfYearTransEnd = DaylightTransitionEnd.getDayOfYearOfTransitionHelper(daysUntilFirstDayOfYear, isLeap);
+    }
+    int64_t startTime = DaylightTransitionStart.getTransitionTime();
+    int64_t endTime = DaylightTransitionEnd.getTransitionTime();
+    int64_t startDay = ((int64_t)(daysUntilFirstDayOfYear + dayOfYearTransStart)) * DAY;
+    int64_t endDay = ((int64_t)(daysUntilFirstDayOfYear + dayOfYearTransEnd)) * DAY;
+
+    entry.year = year;
+    entry.yearStart = ((int64_t)daysUntilFirstDayOfYear) * DAY;
+    entry.yearEnd = entry.yearStart + (isLeap ? 366LL : 365LL) * DAY;
+    entry.startTrans = startDay + startTime * HOUR;
+    entry.endTrans = endDay + endTime * HOUR;
+
+    //Hour of transition greather than 23 is never reached in the day of transition, so it is over at the begining of next day
+    entry.start = startDay + ((startTime < 24) ? startTime : 24) * HOUR;
+    entry.end = endDay + ((endTime < 24) ? endTime : 24) * HOUR - DSTOffset; //End is checked using time with DST
+    entry.dayOfYearEnd = dayOfYearTransEnd;
+    entry.north = dayOfYearTransStart < dayOfYearTransEnd;
+
+    int16_t hourOfYearTransStart = dayOfYearTransStart * 24 + DaylightTransitionStart.getTransitionTime();
+    int16_t hourOfYearTransEnd = dayOfYearTransEnd * 24 + DaylightTransitionEnd.getTransitionTime();
+    int16_t hourOfYearTransEndNoDST = hourOfYearTransEnd - getDSTOffsetMinutes() / 60;
+    int16_t hoursPerYear = 365 * 24;
+    if (isLeap) hoursPerYear = 366 * 24;
+    if (entry.north) {
+        entry.alwaysDST = hourOfYearTransEndNoDST - hourOfYearTransStart >= hoursPerYear;
     }
-    else if (type == DSTTRT_Date) {
-        dayOfYearTrans = dtlib::getDayOfYearFromMonth(month, isLeap); //Getting count of days from month
-        dayOfYearTrans += (getDayOfMonth() - 1); //Adding days of month
-        dayOfYearTrans += getDaysOffset(); //Adding days offset
+    else {
+        entry.alwaysDST = hourOfYearTransStart - hourOfYearTransEndNoDST >= hoursPerYear;
     }
-    return dayOfYearTrans;
 }
 
-const DSTTransitionRule DSTTransitionRule::NoDST = DSTTransitionRule();
-
+bool DSTAdjustment::isOverEnd(const dst_year_s& entry, int64_t rawDT) const {
+    int64_t rawDTWithDST = rawDT + ((int64_t)getDSTOffsetTotalMinutes()) * MINUTE;
+    if (rawDTWithDST < entry.yearStart) {
+        //Negative DST offset moved time to the previous year, so day of year overflowed
+        return entry.dayOfYearEnd != 0xFFFFU || dtlib::getHoursFromRaw(rawDTWithDST) >= DaylightTransitionEnd.getTransitionTime();
+    }
+    return rawDT >= entry.end;
+}
 
 bool DSTAdjustment::checkDSTRegion(int64_t rawDT) const {
     if (noDST()) return false;
 
-    //Current date info
-    int32_t year = dtlib::getYearFromRaw(rawDT);
-    bool isLeap = dtlib::isLeapYear(year);
-    int32_t daysUntilFirstDayOfYear = dtlib::getDaysUntilYear(year);
+    const dst_year_s& entry = getDSTYear(rawDT);
+    bool overStart = rawDT >= entry.start;
+    bool overEnd = isOverEnd(entry, rawDT);
 
-    //Current day of year
-    int64_t DSTOffset = ((int64_t)getDSTOffsetTotalMinutes()) * MINUTE;
-    uint16_t dayOfYear = dtlib::getDaysFromRaw(rawDT) - daysUntilFirstDayOfYear;
-    uint16_t dayOfYearDST = dtlib::getDaysFromRaw(rawDT + DSTOffset) - daysUntilFirstDayOfYear;
+    if (entry.north) {
+        //North hemisphere
+        return overStart != overEnd; //XOR
+    }
+    else {
+        //South hemisphere
+        return overStart == overEnd; //XNOR
+    }
+}
 
-    //Current hours
-    hour_t hours = dtlib::getHoursFromRaw(rawDT);
-    hour_t hoursDST = dtlib::getHoursFromRaw(rawDT + DSTOffset);
+bool DSTAdjustment::checkDSTRegion(int64_t rawDT, int64_t& regionEnd) const {
+    regionEnd = INT64_MAX;
+    if (noDST()) return false;
 
-    //DST start
-    uint16_t dayOfYearTransStart = DaylightTransitionStart.getDayOfYearOfTransitionHelper(daysUntilFirstDayOfYear, isLeap);
-    bool overStart = dayOfYear > dayOfYearTransStart || (dayOfYear == dayOfYearTransStart && hours >= DaylightTransitionStart.getTransitionTime());
+    const dst_year_s& entry = getDSTYear(rawDT);
+    bool overStart = rawDT >= entry.start;
+    bool overEnd = isOverEnd(entry, rawDT);
 
-    //DST end
-    uint16_t dayOfYearTransEnd = DaylightTransitionEnd.getDayOfYearOfTransitionHelper(daysUntilFirstDayOfYear, isLeap);
-    bool overEnd = dayOfYearDST > dayOfYearTransEnd || (dayOfYearDST == dayOfYearTransEnd && hoursDST >= DaylightTransitionEnd.getTransitionTime());
+    //The nearest time, when start or end is reached or when year changes
+    regionEnd = entry.yearEnd;
+    if (!overStart && entry.start < regionEnd) regionEnd = entry.start;
+    if (rawDT < entry.end && entry.end < regionEnd) regionEnd = entry.end;
+    int64_t overflowEnd = entry.yearStart - ((int64_t)getDSTOffsetTotalMinutes()) * MINUTE;
+    if (rawDT < overflowEnd && overflowEnd < regionEnd) regionEnd = overflowEnd; //Negative DST offset
 
-    if (dayOfYearTransStart < dayOfYearTransEnd) {
+    if (entry.north) {
         //North hemisphere
         return overStart != overEnd; //XOR
     }
@@ -351,104 +262,200 @@ int64_t DSTAdjustment::getNextTransitionDateRaw(int64_t rawDT, bool& nextTransIs
     nextTransIsDST = false;
     if (noDST()) return 0LL;
 
-    //Current date info
-    int32_t year = dtlib::getYearFromRaw(rawDT);
-    bool isLeap = dtlib::isLeapYear(year);
-    int32_t daysUntilFirstDayOfYear = dtlib::getDaysUntilYear(year);
-
-    //Current day of year
-    int64_t DSTOffset = ((int64_t)getDSTOffsetTotalMinutes()) * MINUTE;
-    uint16_t dayOfYear = dtlib::getDaysFromRaw(rawDT) - daysUntilFirstDayOfYear;
-    uint16_t dayOfYearDST = dtlib::getDaysFromRaw(rawDT + DSTOffset) - daysUntilFirstDayOfYear;
-
-    //Current hours
-    hour_t hours = dtlib::getHoursFromRaw(rawDT);
-    hour_t hoursDST = dtlib::getHoursFromRaw(rawDT + DSTOffset);
-
-    //DST start
-    uint16_t dayOfYearTransStart = DaylightTransitionStart.getDayOfYearOfTransitionHelper(daysUntilFirstDayOfYear, isLeap);
-    bool overStart = dayOfYear > dayOfYearTransStart || (dayOfYear == dayOfYearTransStart && hours >= DaylightTransitionStart.getTransitionTime());
-
-    //DST end
-    uint16_t dayOfYearTransEnd = DaylightTransitionEnd.getDayOfYearOfTransitionHelper(daysUntilFirstDayOfYear, isLeap);
-    bool overEnd = dayOfYearDST > dayOfYearTransEnd || (dayOfYearDST == dayOfYearTransEnd && hoursDST >= DaylightTransitionEnd.getTransitionTime());
+    const dst_year_s& entry = getDSTYear(rawDT);
+    if (entry.alwaysDST) {
+        //DST is always applyied
+        return 0LL;
+    }
 
-    int16_t hourOfYearTransStart = dayOfYearTransStart * 24 + DaylightTransitionStart.getTransitionTime();
-    int16_t hourOfYearTransEnd = dayOfYearTransEnd * 24 + DaylightTransitionEnd.getTransitionTime();
-    int16_t hourOfYearTransEndNoDST = hourOfYearTransEnd - getDSTOffsetMinutes() / 60;
-    int16_t hoursPerYear = 365 * 24;
-    if(isLeap) hoursPerYear = 366 * 24;
+    bool overStart = rawDT >= entry.start;
+    bool overEnd = isOverEnd(entry, rawDT);
+    int32_t year = entry.year;
 
-    int64_t rv;
-    if (dayOfYearTransStart < dayOfYearTransEnd) {
+    if (entry.north) {
         //North hemisphere
-
-        if (hourOfYearTransEndNoDST - hourOfYearTransStart >= hoursPerYear) {
-            //DST is always applyied
-            return 0LL;
-        }
-
         if (!overStart) {
-            rv = ((int64_t)(daysUntilFirstDayOfYear + dayOfYearTransStart)) * DAY + ((int64_t)DaylightTransitionStart.getTransitionTime()) * HOUR;
             nextTransIsDST = true;
+            return entry.startTrans;
         }
         else if (!overEnd) {
-            rv = ((int64_t)(daysUntilFirstDayOfYear + dayOfYearTransEnd)) * DAY + ((int64_t)DaylightTransitionEnd.getTransitionTime()) * HOUR;
             nextTransIsDST = false;
+            return entry.endTrans;
         }
         else {
             year++;
             if (year == 0) year++;
             nextTransIsDST = true;
+            uint16_t dayOfYearStart, dayOfYearEnd;
+            if (getPresetTransitionDays(year, dayOfYearStart, dayOfYearEnd)) {
+                return ((int64_t)(dtlib::getDaysUntilYear(year) + dayOfYearStart)) * DAY + ((int64_t)DaylightTransitionStart.getTransitionTime()) * HOUR;
+            }
             return DaylightTransitionStart.getDateOfTransitionRaw(year);
         }
     }
     else {
         //South hemisphere
-
-        if (hourOfYearTransStart - hourOfYearTransEndNoDST >= hoursPerYear) {
-            //DST is always applyied
-            return 0LL;
-        }
-
         if (!overEnd) {
-            rv = ((int64_t)(daysUntilFirstDayOfYear + dayOfYearTransEnd)) * DAY + ((int64_t)DaylightTransitionEnd.getTransitionTime()) * HOUR;
             nextTransIsDST = false;
+            return entry.endTrans;
         }
         else if (!overStart) {
-            rv = ((int64_t)(daysUntilFirstDayOfYear + dayOfYearTransStart)) * DAY + ((int64_t)DaylightTransitionStart.getTransitionTime()) * HOUR;
             nextTransIsDST = true;
+            return entry.startTrans;
         }
         else {
             year++;
             if (year == 0) year++;
             nextTransIsDST = false;
+            uint16_t dayOfYearStart, dayOfYearEnd;
+            if (getPresetTransitionDays(year, dayOfYearStart, dayOfYearEnd)) {
+                return ((int64_t)(dtlib::getDaysUntilYear(year) + dayOfYearEnd)) * DAY + ((int64_t)DaylightTransitionEnd.getTransitionTime()) * HOUR;
+            }
             return DaylightTransitionEnd.getDateOfTransitionRaw(year);
         }
     }
-    return rv;
 }
 
+uint8_t DSTAdjustment::getTransitionsOfYear(int32_t year, int64_t transitions[2], bool toDST[2]) const {
+    if (noDST()) return 0;
+
+    dst_year_s entry;
+    computeDSTYear(year, entry);
+    if (entry.alwaysDST) return 0;
+
+    //The same limits as limits used by checkDSTRegion(), so region changes exactly at returned times
+    if (entry.north) {
+        transitions[0] = entry.start;
+        toDST[0] = true;
+        transitions[1] = entry.end;
+        toDST[1] = false;
+    }
+    else {
+        transitions[0] = entry.end;
+        toDST[0] = false;
+        transitions[1] = entry.start;
+        toDST[1] = true;
+    }
+    return 2;
+}
+
+
+enum dst_preset_e {
+    DST_PRESET_NorthAmerica,
+    DST_PRESET_Cuba,
+    DST_PRESET_Mexico,
+    DST_PRESET_WesternEurope,
+    DST_PRESET_CentralEurope,
+    DST_PRESET_EasternEurope,
+    DST_PRESET_Greenland,
+    DST_PRESET_Moldova,
+    DST_PRESET_Israel,
+    DST_PRESET_Lebanon,
+    DST_PRESET_Palestine,
+    DST_PRESET_Syria,
+    DST_PRESET_Jordan,
+    DST_PRESET_Chile,
+    DST_PRESET_Paraguay,
+    DST_PRESET_Australia,
+    DST_PRESET_Australia_Lord_Howe_Island,
+    DST_PRESET_NewZeland,
+    DST_PRESET_COUNT
+};
+
+//Rules of DSTAdjustment presets, static members and precomputed table are both made from them
+#if DT_CPP_VERSION >= 201402L
+static constexpr DSTAdjustment dst_presets[DST_PRESET_COUNT] = {
+#else
+static const DSTAdjustment dst_presets[DST_PRESET_COUNT] = {   //Rules cannot be created at compile time before C++14
+#endif
+    DSTAdjustment(DSTTransitionRule(2, Month::March, DayOfWeek::Sunday, WeekOfMonth::Second, 0), DSTTransitionRule(2, Month::November, DayOfWeek::Sunday, WeekOfMonth::First, 0), 1),
+    DSTAdjustment(DSTTransitionRule(0, Month::March, DayOfWeek::Sunday, WeekOfMonth::Second, 0), DSTTransitionRule(1, Month::November, DayOfWeek::Sunday, WeekOfMonth::First, 0), 1),
+    DSTAdjustment(DSTTransitionRule(2, Month::April, DayOfWeek::Sunday, WeekOfMonth::First, 0), DSTTransitionRule(2, Month::October, DayOfWeek::Sunday, WeekOfMonth::Last, 0), 1),
+    DSTAdjustment(DSTTransitionRule(1, Month::March, DayOfWeek::Sunday, WeekOfMonth::Last, 0), DSTTransitionRule(2, Month::October, DayOfWeek::Sunday, WeekOfMonth::Last, 0), 1),
+    DSTAdjustment(DSTTransitionRule(2, Month::March, DayOfWeek::Sunday, WeekOfMonth::Last, 0), DSTTransitionRule(3, Month::October, DayOfWeek::Sunday, WeekOfMonth::Last, 0), 1),
+    DSTAdjustment(DSTTransitionRule(3, Month::March, DayOfWeek::Sunday, WeekOfMonth::Last, 0), DSTTransitionRule(4, Month::October, DayOfWeek::Sunday, WeekOfMonth::Last, 0), 1),
+    DSTAdjustment(DSTTransitionRule(22, Month::March, DayOfWeek::Sunday, WeekOfMonth::Last, -1), DSTTransitionRule(23, Month::October, DayOfWeek::Sunday, WeekOfMonth::Last, -1), 1),
+    DSTAdjustment(DSTTransitionRule(2, Month::March, DayOfWeek::Sunday, WeekOfMonth::Last, 0), DSTTransitionRule(3, Month::October, DayOfWeek::Sunday, WeekOfMonth::Last, 0), 1),
+    DSTAdjustment(DSTTransitionRule(2, Month::March, DayOfWeek::Sunday, WeekOfMonth::Last, -2), DSTTransitionRule(2, Month::October, DayOfWeek::Sunday, WeekOfMonth::Last, 0), 1),
+    DSTAdjustment(DSTTransitionRule(0, Month::March, DayOfWeek::Sunday, WeekOfMonth::Last, -2), DSTTransitionRule(0, Month::October, DayOfWeek::Sunday, WeekOfMonth::Last, 0), 1),
+    DSTAdjustment(DSTTransitionRule(0, Month::March, DayOfWeek::Sunday, WeekOfMonth::Last, -2), DSTTransitionRule(1, Month::October, DayOfWeek::Friday, WeekOfMonth::Last, 0), 1),
+    DSTAdjustment(DSTTransitionRule(0, Month::March, DayOfWeek::Friday, WeekOfMonth::Last, -2), DSTTransitionRule(0, Month::October, DayOfWeek::Friday, WeekOfMonth::Last, 0), 1),
+    DSTAdjustment(DSTTransitionRule(0, Month::February, DayOfWeek::Thursday, WeekOfMonth::Last, -2), DSTTransitionRule(1, Month::October, DayOfWeek::Friday, WeekOfMonth::Last, 0), 1),
+    DSTAdjustment(DSTTransitionRule(0, Month::September, DayOfWeek::Saturday, WeekOfMonth::First, -2), DSTTransitionRule(0, Month::April, DayOfWeek::Saturday, WeekOfMonth::First, 0), 1),
+    DSTAdjustment(DSTTransitionRule(0, Month::October, DayOfWeek::Sunday, WeekOfMonth::First, -2), DSTTransitionRule(0, Month::March, DayOfWeek::Sunday, WeekOfMonth::Fourth, 0), 1),
+    DSTAdjustment(DSTTransitionRule(2, Month::October, DayOfWeek::Sunday, WeekOfMonth::First, -2), DSTTransitionRule(3, Month::April, DayOfWeek::Sunday, WeekOfMonth::First, 0), 1),
+    DSTAdjustment(DSTTransitionRule(2, Month::October, DayOfWeek::Sunday, WeekOfMonth::First, -2), DSTTransitionRule(2, Month::April, DayOfWeek::Sunday, WeekOfMonth::First, 0), 0, 30, false),
+    DSTAdjustment(DSTTransitionRule(2, Month::September, DayOfWeek::Sunday, WeekOfMonth::Last, -2), DSTTransitionRule(2, Month::April, DayOfWeek::Sunday, WeekOfMonth::First, 0), 1)
+};
 
 const DSTAdjustment DSTAdjustment::NoDST = DSTAdjustment();
-const DSTAdjustment DSTAdjustment::NorthAmerica = DSTAdjustment(DSTTransitionRule(2, Month::March, DayOfWeek::Sunday, WeekOfMonth::Second, 0), DSTTransitionRule(2, Month::November, DayOfWeek::Sunday, WeekOfMonth::First, 0), 1);
-const DSTAdjustment DSTAdjustment::Cuba = DSTAdjustment(DSTTransitionRule(0, Month::March, DayOfWeek::Sunday, WeekOfMonth::Second, 0), DSTTransitionRule(1, Month::November, DayOfWeek::Sunday, WeekOfMonth::First, 0), 1);
-const DSTAdjustment DSTAdjustment::Mexico = DSTAdjustment(DSTTransitionRule(2, Month::April, DayOfWeek::Sunday, WeekOfMonth::First, 0), DSTTransitionRule(2, Month::October, DayOfWeek::Sunday, WeekOfMonth::Last, 0), 1);
-const DSTAdjustment DSTAdjustment::WesternEurope = DSTAdjustment(DSTTransitionRule(1, Month::March, DayOfWeek::Sunday, WeekOfMonth::Last, 0), DSTTransitionRule(2, Month::October, DayOfWeek::Sunday, WeekOfMonth::Last, 0), 1);
-const DSTAdjustment DSTAdjustment::CentralEurope = DSTAdjustment(DSTTransitionRule(2, Month::March, DayOfWeek::Sunday, WeekOfMonth::Last, 0), DSTTransitionRule(3, Month::October, DayOfWeek::Sunday, WeekOfMonth::Last, 0), 1);
-const DSTAdjustment DSTAdjustment::EasternEurope = DSTAdjustment(DSTTransitionRule(3, Month::March, DayOfWeek::Sunday, WeekOfMonth::Last, 0), DSTTransitionRule(4, Month::October, DayOfWeek::Sunday, WeekOfMonth::Last, 0), 1);
-const DSTAdjustment DSTAdjustment::Greenland = DSTAdjustment(DSTTransitionRule(22, Month::March, DayOfWeek::Sunday, WeekOfMonth::Last, -1), DSTTransitionRule(23, Month::October, DayOfWeek::Sunday, WeekOfMonth::Last, -1), 1);
-const DSTAdjustment DSTAdjustment::Moldova = DSTAdjustment(DSTTransitionRule(2, Month::March, DayOfWeek::Sunday, WeekOfMonth::Last, 0), DSTTransitionRule(3, Month::October, DayOfWeek::Sunday, WeekOfMonth::Last, 0), 1);
-const DSTAdjustment DSTAdjustment::Israel = DSTAdjustment(DSTTransitionRule(2, Month::March, DayOfWeek::Sunday, WeekOfMonth::Last, -2), DSTTransitionRule(2, Month::October, DayOfWeek::Sunday, WeekOfMonth::Last, 0), 1);
-const DSTAdjustment DSTAdjustment::Lebanon = DSTAdjustment(DSTTransitionRule(0, Month::March, DayOfWeek::Sunday, WeekOfMonth::Last, -2), DSTTransitionRule(0, Month::October, DayOfWeek::Sunday, WeekOfMonth::Last, 0), 1);
-const DSTAdjustment DSTAdjustment::Palestine = DSTAdjustment(DSTTransitionRule(0, Month::March, DayOfWeek::Sunday, WeekOfMonth::Last, -2), DSTTransitionRule(1, Month::October, DayOfWeek::Friday, WeekOfMonth::Last, 0), 1);
-const DSTAdjustment DSTAdjustment::Syria = DSTAdjustment(DSTTransitionRule(0, Month::March, DayOfWeek::Friday, WeekOfMonth::Last, -2), DSTTransitionRule(0, Month::October, DayOfWeek::Friday, WeekOfMonth::Last, 0), 1);
-const DSTAdjustment DSTAdjustment::Jordan = DSTAdjustment(DSTTransitionRule(0, Month::February, DayOfWeek::Thursday, WeekOfMonth::Last, -2), DSTTransitionRule(1, Month::October, DayOfWeek::Friday, WeekOfMonth::Last, 0), 1);
-const DSTAdjustment DSTAdjustment::Chile = DSTAdjustment(DSTTransitionRule(0, Month::September, DayOfWeek::Saturday, WeekOfMonth::First, -2), DSTTransitionRule(0, Month::April, DayOfWeek::Saturday, WeekOfMonth::First, 0), 1);
-const DSTAdjustment DSTAdjustment::Paraguay = DSTAdjustment(DSTTransitionRule(0, Month::October, DayOfWeek::Sunday, WeekOfMonth::First, -2), DSTTransitionRule(0, Month::March, DayOfWeek::Sunday, WeekOfMonth::Fourth, 0), 1);
-const DSTAdjustment DSTAdjustment::Australia = DSTAdjustment(DSTTransitionRule(2, Month::October, DayOfWeek::Sunday, WeekOfMonth::First, -2), DSTTransitionRule(3, Month::April, DayOfWeek::Sunday, WeekOfMonth::First, 0), 1);
-const DSTAdjustment DSTAdjustment::Australia_Lord_Howe_Island = DSTAdjustment(DSTTransitionRule(2, Month::October, DayOfWeek::Sunday, WeekOfMonth::First, -2), DSTTransitionRule(2, Month::April, DayOfWeek::Sunday, WeekOfMonth::First, 0), 0, 30, false);
-const DSTAdjustment DSTAdjustment::NewZeland = DSTAdjustment(DSTTransitionRule(2, Month::September, DayOfWeek::Sunday, WeekOfMonth::Last, -2), DSTTransitionRule(2, Month::April, DayOfWeek::Sunday, WeekOfMonth::First, 0), 1);
+const DSTAdjustment DSTAdjustment::NorthAmerica = dst_presets[DST_PRESET_NorthAmerica];
+const DSTAdjustment DSTAdjustment::Cuba = dst_presets[DST_PRESET_Cuba];
+const DSTAdjustment DSTAdjustment::Mexico = dst_presets[DST_PRESET_Mexico];
+const DSTAdjustment DSTAdjustment::WesternEurope = dst_presets[DST_PRESET_WesternEurope];
+const DSTAdjustment DSTAdjustment::CentralEurope = dst_presets[DST_PRESET_CentralEurope];
+const DSTAdjustment DSTAdjustment::EasternEurope = dst_presets[DST_PRESET_EasternEurope];
+const DSTAdjustment DSTAdjustment::Greenland = dst_presets[DST_PRESET_Greenland];
+const DSTAdjustment DSTAdjustment::Moldova = dst_presets[DST_PRESET_Moldova];
+const DSTAdjustment DSTAdjustment::Israel = dst_presets[DST_PRESET_Israel];
+const DSTAdjustment DSTAdjustment::Lebanon = dst_presets[DST_PRESET_Lebanon];
+const DSTAdjustment DSTAdjustment::Palestine = dst_presets[DST_PRESET_Palestine];
+const DSTAdjustment DSTAdjustment::Syria = dst_presets[DST_PRESET_Syria];
+const DSTAdjustment DSTAdjustment::Jordan = dst_presets[DST_PRESET_Jordan];
+const DSTAdjustment DSTAdjustment::Chile = dst_presets[DST_PRESET_Chile];
+const DSTAdjustment DSTAdjustment::Paraguay = dst_presets[DST_PRESET_Paraguay];
+const DSTAdjustment DSTAdjustment::Australia = dst_presets[DST_PRESET_Australia];
+const DSTAdjustment DSTAdjustment::Australia_Lord_Howe_Island = dst_presets[DST_PRESET_Australia_Lord_Howe_Island];
+const DSTAdjustment DSTAdjustment::NewZeland = dst_presets[DST_PRESET_NewZeland];
+
+#if DT_DST_PRESET_TABLES != 0
+static_assert(DT_DST_TABLE_FIRST_YEAR > 0 && DT_DST_TABLE_FIRST_YEAR <= DT_DST_TABLE_LAST_YEAR, "Invalid range of DT_DST_TABLE_FIRST_YEAR and DT_DST_TABLE_LAST_YEAR");
+
+#define DT_DST_TABLE_YEARS (DT_DST_TABLE_LAST_YEAR - DT_DST_TABLE_FIRST_YEAR + 1)
+
+/**
+* @struct dst_preset_table_s
+* @brief Days of year of DST start and end transitions of all DSTAdjustment presets, computed at compile time.
+*/
+struct dst_preset_table_s {
+    uint64_t keys[DST_PRESET_COUNT];
+    uint16_t days[DST_PRESET_COUNT][DT_DST_TABLE_YEARS][2];
+
+    constexpr dst_preset_table_s() : keys(), days() {
+        for (uint32_t p = 0; p < DST_PRESET_COUNT; p++) {
+            keys[p] = dst_presets[p].getRulesKey();
+            for (int32_t y = 0; y < DT_DST_TABLE_YEARS; y++) {
+                int32_t year = DT_DST_TABLE_FIRST_YEAR + y;
+                int32_t daysUntilFirstDayOfYear = dtlib::getDaysUntilYear(year);
+                bool isLeap = dtlib::isLeapYear(year);
+                days[p][y][0] = dst_presets[p].DaylightTransitionStart.getDayOfYearOfTransitionHelper(daysUntilFirstDayOfYear, isLeap);
+                days[p][y][1] = dst_presets[p].DaylightTransitionEnd.getDayOfYearOfTransitionHelper(daysUntilFirstDayOfYear, isLeap);
+            }
+        }
+    }
+};
+
+static constexpr dst_preset_table_s dst_preset_table;
+
+bool DSTAdjustment::getPresetTransitionDays(int32_t year, uint16_t& dayOfYearStart, uint16_t& dayOfYearEnd) const {
+    uint32_t y = (uint32_t)(year - DT_DST_TABLE_FIRST_YEAR);
+    if (y >= DT_DST_TABLE_YEARS) return false;
+
+    uint64_t key = getRulesKey();
+    for (uint32_t p = 0; p < DST_PRESET_COUNT; p++) {
+        if (dst_preset_table.keys[p] == key) {
+            dayOfYearStart = dst_preset_table.days[p][y][0];
+            dayOfYearEnd = dst_preset_table.days[p][y][1];
+            return true;
+        }
+    }
+    return false;
+}
+#else
+bool DSTAdjustment::getPresetTransitionDays(int32_t /*year*/, uint16_t& /*dayOfYearStart*/, uint16_t& /*dayOfYearEnd*/) const {
+    return false;
+}
+#endif // DT_DST_PRESET_TABLES != 0
 
 
 const TimeZoneInfo TimeZoneInfo::Empty = TimeZoneInfo();
@@ -1392,12 +1399,127 @@ TimeZoneInfo TimeZoneInfo::getCurrentSystemTZInfo() {
     return ret;
 }
 #elif DT_UNDER_OS == DT_LINUX || DT_UNDER_OS == DT_MAC //Linux or Mac OS specific code
-//Code for retrieving time zone info on Linux and Mac OS
-//This code came from: https://github.com/HowardHinnant/date/blob/master/src/tz.cpp and was modified
+//Time zone is found the same way as by tzset(): TZ environment variable is checked first and /etc/localtime is used, when it is not set
+
+/**
+* @brief Gets key name of zone (for example "Europe/Berlin") from zone file path or from target of symbolic link.
+* On Debian based systems /etc/localtime can be a copy of zone file, then /etc/timezone is read.
+*/
+static std::string getZoneKeyName(const std::string& path) {
+    std::string target = path;
+    char link[PATH_MAX];
+    ssize_t len = readlink(path.c_str(), link, sizeof(link) - 1);
+    if (len > 0) {
+        target.assign(link, (size_t)len);
+    }
+
+    size_t pos = target.rfind("zoneinfo/");
+    if (pos != std::string::npos) {
+        return target.substr(pos + 9);
+    }
+
+    std::string keyName;
+    if (path == TZDEFAULT) {
+        std::ifstream file("/etc/timezone");
+        std::getline(file, keyName);
+    }
+    return keyName;
+}
+
+/**
+* @brief Loads time zone info from TZif file. POSIX time zone from footer of file is used, because it is valid for current
+* and future dates. If file does not have footer, offset after the last transition is used without DST.
+*/
+static bool loadTZInfo(const std::string& path, TimeZoneInfo& info) {
+    TZifZone zone;
+    if (!zone.loadFile(path.c_str())) return false;
+
+    if (zone.hasFooter()) {
+        int pos;
+        info = TimeZoneInfo::fromPOSIX(zone.getPOSIX(), pos);
+        if (pos > 0) return true;
+    }
+
+    size_t count = zone.getTransitionCount();
+    const tzif_type_s& type = (count > 0) ? zone.getTransitionType(count - 1) : zone.getInitialType();
+    info = TimeZoneInfo();
+    info.timeZone = TimeZone::fromTotalMinutesOffset((int16_t)(type.utcOffset / 60));
+    strncpy(info.standardABR, zone.getAbbreviation(type), TIME_ZONE_INFO_TZ_ABR_NAME_SIZE - 1);
+    info.standardABR[TIME_ZONE_INFO_TZ_ABR_NAME_SIZE - 1] = '\0';
+    return true;
+}
+
+/**
+* @struct sys_tz_cache_s
+* @brief Time zone info loaded from zone file. File is loaded again only if it was changed or replaced.
+*/
+struct sys_tz_cache_s {
+    std::mutex mutex;
+    bool valid = false;
+    std::string path;
+    dev_t device = 0;
+    ino_t inode = 0;
+    time_t modified = 0;
+    off_t size = 0;
+    TimeZoneInfo info;
+};
 
 TimeZoneInfo TimeZoneInfo::getCurrentSystemTZInfo() {
-    return TimeZoneInfo(); //TODO implement properly, see: https://github.com/HowardHinnant/date/blob/master/src/tz.cpp
-    //TODO use tryGetPOSIXFrom_tzfile from tzFIleParser.cpp to parse timezone file (tzfile) on Linux and Mac OS
+    const char* tzEnv = getenv("TZ");
+    std::string path;
+    std::string keyName;
+    if (tzEnv == NULL) {
+        path = TZDEFAULT;
+    }
+    else if (tzEnv[0] == '\0') {
+        //Empty TZ means UTC
+        TimeZoneInfo utc;
+        strcpy(utc.standardABR, "UTC");
+        return utc;
+    }
+    else {
+        //TZ can be ":path", ":name", "name" (relative to TZDIR) or POSIX time zone
+        const char* name = (tzEnv[0] == ':') ? tzEnv + 1 : tzEnv;
+        if (name[0] == '/') {
+            path = name;
+        }
+        else {
+            path = TimeZoneDB::getDirectory() + "/" + name;
+            keyName = name;
+        }
+    }
+
+    struct stat st;
+    if (stat(path.c_str(), &st) != 0 || !S_ISREG(st.st_mode)) {
+        if (tzEnv != NULL && tzEnv[0] != ':') {
+            int pos;
+            return TimeZoneInfo::fromPOSIX(tzEnv, (int)strlen(tzEnv) + 1, pos);
+        }
+        return TimeZoneInfo();
+    }
+
+    //File is parsed only when it was changed (it is usually replaced, so inode is changed too)
+    static sys_tz_cache_s cache;
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    if (cache.valid && cache.path == path && cache.device == st.st_dev && cache.inode == st.st_ino
+        && cache.modified == st.st_mtime && cache.size == st.st_size) {
+        return cache.info;
+    }
+
+    TimeZoneInfo info;
+    if (!loadTZInfo(path, info)) {
+        return TimeZoneInfo();
+    }
+    info.keyName = keyName.empty() ? getZoneKeyName(path) : keyName;
+
+    cache.info = info;
+    cache.path = path;
+    cache.device = st.st_dev;
+    cache.inode = st.st_ino;
+    cache.modified = st.st_mtime;
+    cache.size = st.st_size;
+    cache.valid = true;
+    return info;
 }
 
 #elif defined(ESP32) || defined(ESP8266) //ESP32, ESP8266 specific code
@@ -1411,10 +1533,6 @@ TimeZoneInfo TimeZoneInfo::getCurrentSystemTZInfo() {
         return TimeZoneInfo();
     }
 }
-#else //Arduino specific code
-TimeZoneInfo TimeZoneInfo::getSystemTZInfo() {
-    return sysTZ; //Returns own variable 
-}
 #endif
 
 #endif //DT_SUPPORTS_GET_SYSTZ != 0
@@ -1426,12 +1544,13 @@ void TimeZoneInfo::setSystemTZInfo(const TimeZoneInfo& tzinfo) {
     tzinfo.toPOSIX(buffer, sizeof(buffer) / sizeof(char));
     setenv("TZ", buffer, 1/*overwrite*/);
     tzset();
-    sysTZ = tzinfo;
+    DT_SYSTZ_LOCK();
+    publishSystemTZInfo(tzinfo);
 }
 
 #elif defined(ARDUINO)
 void TimeZoneInfo::setSystemTZInfo(const TimeZoneInfo& tzinfo) {
-    sysTZ = tzinfo;
+    publishSystemTZInfo(tzinfo);
 }
 #else
 #error "Setting system time zone info not implemented!";
@@ -1439,8 +1558,45 @@ void TimeZoneInfo::setSystemTZInfo(const TimeZoneInfo& tzinfo) {
 #endif // DT_SUPPORTS_SET_SYSTZ != 0
 
 
+#if DT_SUPPORTS_GET_SYSTZ != 0 || DT_SUPPORTS_SET_SYSTZ != 0
+std::atomic<const TimeZoneInfo*> TimeZoneInfo::sysTZ(NULL);
+
+static bool isSameTZInfo(const TimeZoneInfo& a, const TimeZoneInfo& b) {
+    return a.timeZone.getTimeZoneOffsetTotalMinutes() == b.timeZone.getTimeZoneOffsetTotalMinutes() &&
+        a.DST.getDSTOffsetTotalMinutes() == b.DST.getDSTOffsetTotalMinutes() &&
+        a.DST.DaylightTransitionStart == b.DST.DaylightTransitionStart &&
+        a.DST.DaylightTransitionEnd == b.DST.DaylightTransitionEnd &&
+        a.standardName == b.standardName && a.daylightName == b.daylightName && a.keyName == b.keyName &&
+        strncmp(a.standardABR, b.standardABR, TIME_ZONE_INFO_TZ_ABR_NAME_SIZE) == 0 &&
+        strncmp(a.daylightABR, b.daylightABR, TIME_ZONE_INFO_TZ_ABR_NAME_SIZE) == 0;
+}
+
+const TimeZoneInfo& TimeZoneInfo::publishSystemTZInfo(const TimeZoneInfo& tzinfo) {
+    const TimeZoneInfo* current = sysTZ.load(std::memory_order_relaxed);
+    if (current != NULL && isSameTZInfo(*current, tzinfo)) {
+        return *current; //Nothing changed, snapshot is kept
+    }
+
+    //Old snapshot is not released, because readers can still hold reference to it
+    const TimeZoneInfo* next = new TimeZoneInfo(tzinfo);
+    sysTZ.store(next, std::memory_order_release);
+    return *next;
+}
+
 #if DT_SUPPORTS_GET_SYSTZ != 0
-TimeZoneInfo TimeZoneInfo::sysTZ = getCurrentSystemTZInfo();
-#elif DT_SUPPORTS_SET_SYSTZ != 0
-TimeZoneInfo TimeZoneInfo::sysTZ;
+const TimeZoneInfo& TimeZoneInfo::initSystemTZInfo() {
+    DT_SYSTZ_LOCK();
+    const TimeZoneInfo* current = sysTZ.load(std::memory_order_acquire);
+    if (current != NULL) {
+        return *current; //Captured by other thread meanwhile
+    }
+    return publishSystemTZInfo(getCurrentSystemTZInfo());
+}
+
+void TimeZoneInfo::loadSystemTZInfo() {
+    TimeZoneInfo tzinfo = getCurrentSystemTZInfo(); //Slow part is done without lock
+    DT_SYSTZ_LOCK();
+    publishSystemTZInfo(tzinfo);
+}
+#endif // DT_SUPPORTS_GET_SYSTZ != 0
 #endif //DT_SUPPORTS_GET_SYSTZ != 0 || DT_SUPPORTS_SET_SYSTZ != 0
\ No newline at end of file
@@ -17,6 +17,34 @@
 
 #include "TimeSpan.h"
 
+#if DT_SUPPORTS_GET_SYSTZ != 0 || DT_SUPPORTS_SET_SYSTZ != 0
+#include <atomic>
+#endif // DT_SUPPORTS_GET_SYSTZ != 0 || DT_SUPPORTS_SET_SYSTZ != 0
+
+#ifndef DT_DST_YEAR_CACHE_SIZE
+#if DT_UNDER_OS > 0 || defined(ESP32) || defined(ESP8266)
+#define DT_DST_YEAR_CACHE_SIZE	(8)	//Count of years with precomputed DST transitions cached by DSTAdjustment (power of 2)
+#else
+#define DT_DST_YEAR_CACHE_SIZE	(1)	//Count of years with precomputed DST transitions cached by DSTAdjustment (power of 2)
+#endif // DT_UNDER_OS > 0 || defined(ESP32) || defined(ESP8266)
+#endif // !DT_DST_YEAR_CACHE_SIZE
+
+#ifndef DT_DST_PRESET_TABLES
+#if !defined(DT_LEGACY_CALENDAR) && DT_CPP_VERSION >= 201402L && (DT_UNDER_OS > 0 || defined(ESP32))
+#define DT_DST_PRESET_TABLES	(1)	//DST transitions of DSTAdjustment presets are precomputed at compile time
+#else
+#define DT_DST_PRESET_TABLES	(0)	//DST transitions of DSTAdjustment presets are computed at runtime
+#endif // !defined(DT_LEGACY_CALENDAR) && DT_CPP_VERSION >= 201402L && (DT_UNDER_OS > 0 || defined(ESP32))
+#endif // !DT_DST_PRESET_TABLES
+
+#ifndef DT_DST_TABLE_FIRST_YEAR
+#define DT_DST_TABLE_FIRST_YEAR	(1970)	//First year of precomputed DST transitions of DSTAdjustment presets
+#endif // !DT_DST_TABLE_FIRST_YEAR
+
+#ifndef DT_DST_TABLE_LAST_YEAR
+#define DT_DST_TABLE_LAST_YEAR	(2100)	//Last year of precomputed DST transitions of DSTAdjustment presets
+#endif // !DT_DST_TABLE_LAST_YEAR
+
 class DateTime;
 template <class>
 class DateTimeBase;
@@ -683,7 +711,7 @@ struct TimeZone {
 	/**
 	* @brief Creates TimeZone with UTC time zone.
 	*/
-	TimeZone() :
+	constexpr TimeZone() :
 		timeZoneOffset15min(0)
 	{ }
 
@@ -857,7 +885,7 @@ struct DSTTransitionRule {
 	/**
 	* @brief Cretes DSTTransitionRule with no DST transition.
 	*/
-	DSTTransitionRule() : rawValue(DSTTransitionRuleType::DSTTRT_NoDST)
+	constexpr DSTTransitionRule() : rawValue(DSTTransitionRuleType::DSTTRT_NoDST)
 	{ }
 
 	/**
@@ -865,7 +893,7 @@ struct DSTTransitionRule {
 	* @param transitionHour Hour, when transition happends.
 	* @param dayOfYear Day of year from range 0-364 or 0-365 for leap years.
 	*/
-	DSTTransitionRule(hour_t transitionHour, uint16_t dayOfYear) {
+	DT_CONSTEXPR14 DSTTransitionRule(hour_t transitionHour, uint16_t dayOfYear) : rawValue(0) {
 		setFixed(transitionHour, dayOfYear);
 	}
 
@@ -874,7 +902,7 @@ struct DSTTransitionRule {
 	* @param transitionHour Hour, when transition happends.
 	* @param dayOfYear Day of year from range 0-364 or 0-365 for leap years.
 	*/
-	inline static DSTTransitionRule Fixed(hour_t transitionHour, uint16_t dayOfYear) {
+	DT_CONSTEXPR14 static DSTTransitionRule Fixed(hour_t transitionHour, uint16_t dayOfYear) {
 		return DSTTransitionRule(transitionHour, dayOfYear);
 	}
 
@@ -885,7 +913,7 @@ struct DSTTransitionRule {
 	* @param dayOfMonth Day of month in range from 1-28/29/30/31.
 	* @param dayOffset Days offset in range from -9 to +8.
 	*/
-	DSTTransitionRule(hour_t transitionHour, Month month, uint8_t dayOfMonth, int8_t dayOffset = 0) {
+	DT_CONSTEXPR14 DSTTransitionRule(hour_t transitionHour, Month month, uint8_t dayOfMonth, int8_t dayOffset = 0) : rawValue(0) {
 		setDate(transitionHour, month, dayOfMonth, dayOffset);
 	}
 
@@ -896,7 +924,7 @@ struct DSTTransitionRule {
 	* @param dayOfMonth Day of month in range from 1-28/29/30/31.
 	* @param dayOffset Days offset in range from -9 to +8.
 	*/
-	inline static DSTTransitionRule Date(hour_t transitionHour, Month month, uint8_t dayOfMonth, int8_t dayOffset = 0) {
+	DT_CONSTEXPR14 static DSTTransitionRule Date(hour_t transitionHour, Month month, uint8_t dayOfMonth, int8_t dayOffset = 0) {
 		return DSTTransitionRule(transitionHour, month, dayOfMonth, dayOffset);
 	}
 
@@ -908,7 +936,7 @@ struct DSTTransitionRule {
 	* @param weekOfMonth Week of month from WeekOfMonth enum.
 	* @param dayOffset Days offset in range from -9 to +8.
 	*/
-	DSTTransitionRule(hour_t transitionHour, Month month, DayOfWeek dayOfWeek, WeekOfMonth weekOfMonth, int8_t dayOffset = 0) {
+	DT_CONSTEXPR14 DSTTransitionRule(hour_t transitionHour, Month month, DayOfWeek dayOfWeek, WeekOfMonth weekOfMonth, int8_t dayOffset = 0) : rawValue(0) {
 		setFloating(transitionHour, month, dayOfWeek, weekOfMonth, dayOffset);
 	}
 
@@ -920,7 +948,7 @@ struct DSTTransitionRule {
 	* @param weekOfMonth Week of month from WeekOfMonth enum.
 	* @param dayOffset Days offset in range from -9 to +8.
 	*/
-	inline static DSTTransitionRule Floating(hour_t transitionHour, Month month, DayOfWeek dayOfWeek, WeekOfMonth weekOfMonth, int8_t dayOffset = 0) {
+	DT_CONSTEXPR14 static DSTTransitionRule Floating(hour_t transitionHour, Month month, DayOfWeek dayOfWeek, WeekOfMonth weekOfMonth, int8_t dayOffset = 0) {
 		return DSTTransitionRule(transitionHour, month, dayOfWeek, weekOfMonth, dayOffset);
 	}
 
@@ -929,7 +957,10 @@ struct DSTTransitionRule {
 	* @param transitionHour Hour, when transition happends.
 	* @param dayOfYear Day of year from range 0-364 or 0-365 for leap years.
 	*/
-	void setFixed(hour_t transitionHour, uint16_t dayOfYear);
+	DT_CONSTEXPR14 void setFixed(hour_t transitionHour, uint16_t dayOfYear) {
+		transitionHour.convertTo24();
+		rawValue = (DSTTRT_Fixed & 0x03U) | ((dayOfYear & 0x03FFU) << 2) | (((uint32_t)(transitionHour & 0x3FU)) << 16);
+	}
 
 	/**
 	* @brief Sets DST transition rule by date. Date rule is defined by month and day of month.
@@ -938,7 +969,12 @@ struct DSTTransitionRule {
 	* @param dayOfMonth Day of month in range from 1-28/29/30/31.
 	* @param dayOffset Days offset in range from -9 to +8.
 	*/
-	void setDate(hour_t transitionHour, Month month, uint8_t dayOfMonth, int8_t dayOffset = 0);
+	DT_CONSTEXPR14 void setDate(hour_t transitionHour, Month month, uint8_t dayOfMonth, int8_t dayOffset = 0) {
+		transitionHour.convertTo24();
+		bool negativeOffset = dayOffset < 0;
+		uint8_t dayOffsetABS = (negativeOffset) ? (-1 - dayOffset) : dayOffset;
+		rawValue = (DSTTRT_Date & 0x03U) | ((month & 0x0FU) << 2) | (((uint32_t)(dayOfMonth & 0x3FU)) << 6) | (((uint32_t)(dayOffsetABS & 0x07U)) << 12) | (((uint32_t)negativeOffset) << 15) | (((uint32_t)(transitionHour & 0x3FU)) << 16);
+	}
 
 	/**
 	* @brief Sets floating DST transition. Floating rule is defined by month, day of week, week of month and days offset.
@@ -948,20 +984,25 @@ struct DSTTransitionRule {
 	* @param weekOfMonth Week of month from WeekOfMonth enum.
 	* @param dayOffset Days offset in range from -9 to +8.
 	*/
-	void setFloating(hour_t transitionHour, Month month, DayOfWeek dayOfWeek, WeekOfMonth weekOfMonth, int8_t dayOffset = 0);
+	DT_CONSTEXPR14 void setFloating(hour_t transitionHour, Month month, DayOfWeek dayOfWeek, WeekOfMonth weekOfMonth, int8_t dayOffset = 0) {
+		transitionHour.convertTo24();
+		bool negativeOffset = dayOffset < 0;
+		uint8_t dayOffsetABS = (negativeOffset) ? (-1 - dayOffset) : dayOffset;
+		rawValue = (DSTTRT_Floating & 0x03U) | ((month & 0x0FU) << 2) | ((dayOfWeek & 0x07U) << 6) | (((uint32_t)(weekOfMonth & 0x07U)) << 9) | (((uint32_t)(dayOffsetABS & 0x07U)) << 12) | (((uint32_t)negativeOffset) << 15) | (((uint32_t)(transitionHour & 0x3FU)) << 16);
+	}
 
-	bool operator==(const DSTTransitionRule& d) const {
+	constexpr bool operator==(const DSTTransitionRule& d) const {
 		return d.rawValue == rawValue;
 	}
 
-	bool operator!=(const DSTTransitionRule& d) const {
+	constexpr bool operator!=(const DSTTransitionRule& d) const {
 		return d.rawValue != rawValue;
 	}
 
 	/**
 	* @brief Gets type of rule.
 	*/
-	inline DSTTransitionRuleType getType() const {
+	constexpr DSTTransitionRuleType getType() const {
 		return (DSTTransitionRuleType)(rawValue & 0x03U);
 	}
 
@@ -969,14 +1010,14 @@ struct DSTTransitionRule {
 	* @brief Checks if no DST is set.
 	* @return Returns true if no DST is set and DST adjustment is inactive.
 	*/
-	inline bool noDST() const {
+	constexpr bool noDST() const {
 		return getType() == DSTTransitionRuleType::DSTTRT_NoDST;
 	}
 
 	/**
 	* @brief Gets time in hours, when transition happends.
 	*/
-	inline hour_t getTransitionTime() const {
+	constexpr hour_t getTransitionTime() const {
 		return ((rawValue >> 16) & 0x3FU);
 	}
 
@@ -992,19 +1033,33 @@ struct DSTTransitionRule {
 	/**
 	* @brief Gets days offset in range from -9 to +8.
 	*/
-	int8_t getDaysOffset() const;
+	DT_CONSTEXPR14 int8_t getDaysOffset() const {
+		int8_t dayOffset = (rawValue >> 12) & 0x07U;
+		if (rawValue & 0x8000U) {
+			//Negative
+			return -dayOffset - 1;
+		}
+		else {
+			//Positive
+			return dayOffset;
+		}
+	}
 
 	/**
 	* @brief Sets days offset in range from -9 to +8.
 	* @param val New days offset in range from -9 to +8 days.
 	*/
-	void setDaysOffset(int8_t val);
+	DT_CONSTEXPR14 void setDaysOffset(int8_t val) {
+		bool negativeOffset = val < 0;
+		uint8_t dayOffsetABS = (negativeOffset) ? (-1 - val) : val;
+		rawValue = (rawValue & (~(0x0FUL << 12UL))) | (((uint32_t)(dayOffsetABS & 0x07UL)) << 12) | (((uint32_t)negativeOffset) << 15);
+	}
 
 	/**
 	* @brief Gets day of year in range from 0-364 or 0-365 for leap year.
 	* @note This method can be used only if rule type is Fixed.
 	*/
-	inline uint16_t getDayOfYear() const {
+	constexpr uint16_t getDayOfYear() const {
 		return (rawValue >> 2) & 0x03FFU;
 	}
 
@@ -1012,7 +1067,7 @@ struct DSTTransitionRule {
 	* @brief Gets month.
 	* @note This method can be used only if rule type is Date or Floating.
 	*/
-	inline Month getMonth() const {
+	constexpr Month getMonth() const {
 		return (rawValue >> 2) & 0x0FU;
 	}
 
@@ -1020,7 +1075,7 @@ struct DSTTransitionRule {
 	* @brief Gets day of month in range from 1 to 28/29/30/31.
 	* @note This method can be used only if rule type is Date.
 	*/
-	inline uint8_t getDayOfMonth() const {
+	constexpr uint8_t getDayOfMonth() const {
 		return ((rawValue >> 6) & 0x3FU);
 	}
 
@@ -1028,7 +1083,7 @@ struct DSTTransitionRule {
 	* @brief Gets day of week in range from 1 (Sunday) to 7 (Saturday).
 	* @note This method can be used only if rule type is Floating.
 	*/
-	inline DayOfWeek getDayOfWeek() const {
+	constexpr DayOfWeek getDayOfWeek() const {
 		return (DayOfWeek)((rawValue >> 6) & 0x07U);
 	}
 
@@ -1036,7 +1091,7 @@ struct DSTTransitionRule {
 	* @brief Gets week of month from WeekOfMonth enum.
 	* @note This method can be used only if rule type is Floating.
 	*/
-	inline WeekOfMonth getWeekOfMonth() const {
+	constexpr WeekOfMonth getWeekOfMonth() const {
 		return (WeekOfMonth)((rawValue >> 9) & 0x07U);
 	}
 
@@ -1064,6 +1119,7 @@ struct DSTTransitionRule {
 protected:
 
 	friend struct DSTAdjustment;
+	friend struct dst_preset_table_s;
 
 	/**
 	* @brief Gets date and time of transition of current rule in specified year.
@@ -1078,7 +1134,51 @@ protected:
 	* @param isLeap True if current year is leap day.
 	* @return Returns day of year (zero based) from range 0-364 or 0-365 for leap year.
 	*/
-	uint16_t getDayOfYearOfTransitionHelper(int32_t daysUntilFirstDayOfYear, bool isLeap) const;
+	DT_CAL_CONSTEXPR uint16_t getDayOfYearOfTransitionHelper(int32_t daysUntilFirstDayOfYear, bool isLeap) const {
+		DSTTransitionRuleType type = getType();
+		uint16_t dayOfYearTrans = 0;
+		Month month = getMonth();
+		int32_t dayOfYearUntilMonth = dtlib::getDayOfYearFromMonth(month, isLeap);
+		int32_t daysUntilFirstDayOfMonth = daysUntilFirstDayOfYear + dayOfYearUntilMonth;
+
+		uint8_t dayOfWeekOffset = 0; //Day of week offset at first day of month
+		if (daysUntilFirstDayOfMonth < 0) {
+			//BC
+			dayOfWeekOffset = (7 + ((daysUntilFirstDayOfMonth - 5) % 7));
+		}
+		else {
+			//AD
+			dayOfWeekOffset = (((daysUntilFirstDayOfMonth + 1) % 7) + 1);
+		}
+
+		if (type == DSTTRT_Floating) {
+			dayOfYearTrans = dtlib::getDayOfYearFromMonth(month, isLeap); //Getting count of days from month
+			uint8_t wom = (uint8_t)getWeekOfMonth() - 1;
+			uint8_t dow = getDayOfWeek();
+			uint8_t DoWoffset = 0;
+			//dayOfWeekOffset is day of week of first day in month
+			if (dayOfWeekOffset <= dow) {
+				DoWoffset = dow - dayOfWeekOffset;
+			}
+			else {
+				DoWoffset = 7 - dayOfWeekOffset + dow;
+			}
+			uint8_t monthDaysAdd = wom * 7 + DoWoffset;
+			if (monthDaysAdd < month.getMonthLength(isLeap)) {
+				dayOfYearTrans += monthDaysAdd;
+			}
+			else {
+				dayOfYearTrans += 3 * 7 + DoWoffset;
+			}
+			dayOfYearTrans += getDaysOffset(); //Adding days offset
+		}
+		else if (type == DSTTRT_Date) {
+			dayOfYearTrans = dtlib::getDayOfYearFromMonth(month, isLeap); //Getting count of days from month
+			dayOfYearTrans += (getDayOfMonth() - 1); //Adding days of month
+			dayOfYearTrans += getDaysOffset(); //Adding days offset
+		}
+		return dayOfYearTrans;
+	}
 
 	/**
 	* @brief Compressed rule to 3 bytes. First 2 bits (LSB) are type of rule:
@@ -1125,7 +1225,7 @@ public:
 	/**
 	* @brief Creates default DSTAdjustment with no DST.
 	*/
-	DSTAdjustment() :
+	constexpr DSTAdjustment() :
 		DSTOffset15min(0),
 		isDST_(0)
 	{ }
@@ -1137,7 +1237,7 @@ public:
 	* @param DSTOffsetHours DST offset in hours.
 	* @param isDST True if DST is applyied.
 	*/
-	DSTAdjustment(DSTTransitionRule dltStart, DSTTransitionRule dltEnd, int8_t DSTOffsetHours = 0, bool isDST = false) :
+	constexpr DSTAdjustment(DSTTransitionRule dltStart, DSTTransitionRule dltEnd, int8_t DSTOffsetHours = 0, bool isDST = false) :
 		DaylightTransitionStart(dltStart),
 		DaylightTransitionEnd(dltEnd),
 		DSTOffset15min(DSTOffsetHours * 4),
@@ -1152,7 +1252,7 @@ public:
 	* @param DSTOffsetMinutes DST offset minutes part. If DSTOffsetHours is negative, this has to be also negative.
 	* @param isDST True if DST is applyied.
 	*/
-	DSTAdjustment(DSTTransitionRule dltStart, DSTTransitionRule dltEnd, int8_t DSTOffsetHours, int8_t DSTOffsetMinutes, bool isDST = false) :
+	constexpr DSTAdjustment(DSTTransitionRule dltStart, DSTTransitionRule dltEnd, int8_t DSTOffsetHours, int8_t DSTOffsetMinutes, bool isDST = false) :
 		DaylightTransitionStart(dltStart),
 		DaylightTransitionEnd(dltEnd),
 		DSTOffset15min((DSTOffsetHours * 4) + (DSTOffsetMinutes % 60) / 15),
@@ -1162,7 +1262,7 @@ public:
 	/**
 	* @brief Copies DSTAdjustment.
 	*/
-	DSTAdjustment(const DSTAdjustment& adj, bool isDST) :
+	constexpr DSTAdjustment(const DSTAdjustment& adj, bool isDST) :
 		DaylightTransitionStart(adj.DaylightTransitionStart),
 		DaylightTransitionEnd(adj.DaylightTransitionEnd),
 		DSTOffset15min(adj.DSTOffset15min),
@@ -1275,6 +1375,16 @@ public:
 	*/
 	bool checkDSTRegion(int64_t rawDT) const;
 
+	/**
+	* @brief Checks if DateTime (in raw form) is in DST region or not and gets end of that region. This is useful for conversion of many
+	* sorted values, because region has to be checked only once for all values before its end.
+	* @param raw DateTime to check in microseconds from the begining of the epoch. This time has to be without applyied DST offset.
+	* @param[out] regionEnd Time without applyied DST offset, until which (exclusive) result is the same as for rawDT. Result does not have to change
+	* at this time (for example end of year is also returned). It is INT64_MAX if there is no DST.
+	* @return Returns true if specified DateTime is in DST region.
+	*/
+	bool checkDSTRegion(int64_t rawDT, int64_t& regionEnd) const;
+
 	/**
 	* @brief Checks if DateTime is in DST region or not.
 	* @param dt DateTime to check. This time has to be without applyied DST offset. Only DateTime classes, which have DST field
@@ -1305,6 +1415,15 @@ public:
 	template<class T, class retT = DateTime>
 	retT getNextTransitionDate(const DateTimeBase<T>& dt, bool& nextTransIsDST) const;
 
+	/**
+	* @brief Gets DST transitions of year in order, in which they happen.
+	* @param year Year, which transitions are computed.
+	* @param[out] transitions Times of transitions without applyied DST offset (the same form as checked by checkDSTRegion()).
+	* @param[out] toDST True if transition with the same index is to DST or false if not.
+	* @return Returns count of transitions, which is 2 or 0 if there is no DST or DST is applyied during the whole year.
+	*/
+	uint8_t getTransitionsOfYear(int32_t year, int64_t transitions[2], bool toDST[2]) const;
+
 #if DT_SUPPORTS_GET_SYSTZ != 0
 	/**
 	* @brief Gets current system DST adjustment.
@@ -1513,6 +1632,59 @@ protected:
 	*/
 	int64_t getNextTransitionDateRaw(int64_t raw, bool& nextTransIsDST) const;
 
+	/**
+	* @struct dst_year_s
+	* @brief DST transitions of one year precomputed by getDSTYear(). All values are without applyied DST offset,
+	* so checking of DST region is just comparison of raw value with start and end.
+	*/
+	struct dst_year_s {
+		uint64_t key;			//DST rules and offset, which were used to compute this entry (0 if entry is empty)
+		int64_t yearStart;		//First microsecond of year
+		int64_t yearEnd;		//First microsecond of next year
+		int64_t start;			//Time is over DST start, when it is greather or equal to this value
+		int64_t end;			//Time is over DST end, when it is greather or equal to this value
+		int64_t startTrans;		//Date of DST start transition returned by getNextTransitionDateRaw()
+		int64_t endTrans;		//Date of DST end transition returned by getNextTransitionDateRaw() (DST is applyied)
+		int32_t year;
+		uint16_t dayOfYearEnd;	//Day of year of DST end transition
+		bool north;				//DST start is before DST end in the year
+		bool alwaysDST;			//DST is applyied during the whole year
+	};
+
+	/**
+	* @brief Gets precomputed DST transitions of year containing specified time. Transitions are computed only once per year,
+	* following calls find them in small cache (see DT_DST_YEAR_CACHE_SIZE), which is thread local under OS.
+	* @param rawDT Time in microseconds from the begining of the epoch without applyied DST offset.
+	* @return Returns cache entry, which is valid until next call of this function.
+	*/
+	const dst_year_s& getDSTYear(int64_t rawDT) const;
+
+	/**
+	* @brief Computes DST transitions of specified year.
+	*/
+	void computeDSTYear(int32_t year, dst_year_s& entry) const;
+
+	/**
+	* @brief Gets key, which identifies DST rules and offset. Highest bit is set, so key of empty cache entry never matches.
+	*/
+	constexpr uint64_t getRulesKey() const {
+		return (1ULL << 63) | (((uint64_t)(DSTOffset15min & 0x7F)) << 48)
+			| (((uint64_t)DaylightTransitionEnd.rawValue) << 24) | ((uint64_t)DaylightTransitionStart.rawValue);
+	}
+
+	/**
+	* @brief Gets days of year of DST start and end transition from table precomputed for DSTAdjustment presets.
+	* @return Returns false if DST adjustment is not preset or year is not in range from DT_DST_TABLE_FIRST_YEAR to DT_DST_TABLE_LAST_YEAR.
+	*/
+	bool getPresetTransitionDays(int32_t year, uint16_t& dayOfYearStart, uint16_t& dayOfYearEnd) const;
+
+	friend struct dst_preset_table_s;
+
+	/**
+	* @brief Checks if time is over DST end of year from cache entry.
+	*/
+	bool isOverEnd(const dst_year_s& entry, int64_t rawDT) const;
+
 	int8_t DSTOffset15min : 7;
 	bool isDST_ : 1;
 };
@@ -1687,29 +1859,31 @@ public:
 	/**
 	* @brief Gets current system time zone informations. This function checks system registers (on Windows)
 	* or reads system files with time zone (on Linux and Mac OS) or reads environment variable (on ESP32 or ESP8266).
-	* @note This function can be slow, use rather getSystemTZInfo(), which gets you reference to global variable
-	* with time zone info captured when program started.
+	* On Linux and Mac OS, zone file is selected by TZ environment variable (":path", ":name", "name" or POSIX time zone)
+	* or /etc/localtime is used. POSIX time zone from footer of zone file is used and key name is found from target
+	* of symbolic link. Parsed file is cached and it is parsed again only if its inode, size or modification time is changed.
+	* @note This function can be slow, use rather getSystemTZInfo(), which gets you reference to snapshot
+	* of system time zone info.
 	* @return Returns class with system time zone informations.
-	* @note This function works only with Windows, ESP32 and ESP8266
-	* @todo Implement this also for Linux and Mac OS.
 	*/
 	static TimeZoneInfo getCurrentSystemTZInfo();
 
 	/**
-	* @brief Gets current system time zone informations. This function just returns const reference to global variable,
-	* which was captured at startup or by loadSystemTZInfo() method.
+	* @brief Gets system time zone informations. This function just returns const reference to snapshot,
+	* which is captured on the first call or by loadSystemTZInfo() method. Reading snapshot costs only one atomic load.
+	* @note Snapshots are never released, so returned reference stays valid even after snapshot is replaced.
 	* @return Returns class with system time zone informations.
 	*/
 	inline static const TimeZoneInfo& getSystemTZInfo() {
-		return sysTZ;
+		const TimeZoneInfo* tzinfo = sysTZ.load(std::memory_order_acquire);
+		return (tzinfo != NULL) ? *tzinfo : initSystemTZInfo();
 	}
 
 	/**
-	* @brief Call this to update global variable with system time zone info.
+	* @brief Call this to update snapshot of system time zone info. New snapshot is published atomically,
+	* so readers in other threads see it without any lock. New snapshot is created only if time zone info was changed.
 	*/
-	inline static void loadSystemTZInfo() {
-		sysTZ = getCurrentSystemTZInfo();
-	}
+	static void loadSystemTZInfo();
 
 #endif // DT_SUPPORTS_GET_SYSTZ != 0
 
@@ -1793,10 +1967,24 @@ protected:
 	static char* getNumericABRFromOffset(char* buffer, int bufferSize, int16_t offset);
 
 #if DT_SUPPORTS_GET_SYSTZ != 0 || DT_SUPPORTS_SET_SYSTZ != 0
+#if DT_SUPPORTS_GET_SYSTZ != 0
+	/**
+	* @brief Captures the first snapshot of system time zone info. Called only when snapshot does not exist yet.
+	*/
+	static const TimeZoneInfo& initSystemTZInfo();
+#endif // DT_SUPPORTS_GET_SYSTZ != 0
+
+	/**
+	* @brief Replaces snapshot of system time zone info, if tzinfo differs from current snapshot.
+	* @note Writers have to be serialized by caller.
+	* @return Returns current snapshot.
+	*/
+	static const TimeZoneInfo& publishSystemTZInfo(const TimeZoneInfo& tzinfo);
+
 	/**
-	* @brief System time zone captured at startup.
+	* @brief Snapshot of system time zone info. It is NULL until first use, so no dynamic initialization is done.
 	*/
-	static TimeZoneInfo sysTZ;
+	static std::atomic<const TimeZoneInfo*> sysTZ;
 #endif //DT_SUPPORTS_GET_SYSTZ != 0 || DT_SUPPORTS_SET_SYSTZ != 0
 
 };
@@ -0,0 +1,91 @@
+#include "TimeZoneDB.h"
+
+#if DT_UNDER_OS > 0
+#include <cstdlib>
+#include <cstring>
+#include <utility>
+
+#if DT_UNDER_OS == DT_LINUX || DT_UNDER_OS == DT_MAC
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif // DT_UNDER_OS == DT_LINUX || DT_UNDER_OS == DT_MAC
+
+TimeZoneDB::Zone TimeZoneDB::get(const char* name) {
+	{
+		std::lock_guard<std::mutex> lock(getMutex());
+		cache_t& cache = getCache();
+		cache_t::iterator it = cache.find(name);
+		if (it != cache.end()) return &it->second;
+	}
+
+	//File is loaded without lock, so other zones can be read meanwhile
+	if (!isValidName(name)) return NULL;
+	TZifZone zone;
+	if (!loadMapped(getDirectory() + "/" + name, zone)) return NULL; //Missing zone is not cached, it can be installed later
+
+	std::lock_guard<std::mutex> lock(getMutex());
+	//If another thread loaded the same zone meanwhile, its zone is kept, so returned handles stay equal
+	return &getCache().emplace(name, std::move(zone)).first->second;
+}
+
+const std::string& TimeZoneDB::getDirectory() {
+	static const std::string directory = []() {
+		const char* env = getenv("TZDIR");
+		return std::string((env != NULL && env[0] != '\0') ? env : TZDIR);
+	}();
+	return directory;
+}
+
+size_t TimeZoneDB::getCachedCount() {
+	std::lock_guard<std::mutex> lock(getMutex());
+	return getCache().size();
+}
+
+bool TimeZoneDB::isValidName(const char* name) {
+	if (name[0] == '\0' || name[0] == '/') return false;
+	//Parent directory is not allowed
+	for (const char* p = name; *p != '\0'; p++) {
+		if (p[0] == '.' && p[1] == '.' && (p == name || p[-1] == '/') && (p[2] == '/' || p[2] == '\0')) {
+			return false;
+		}
+	}
+	return true;
+}
+
+bool TimeZoneDB::loadMapped(const std::string& path, TZifZone& zone) {
+#if DT_UNDER_OS == DT_LINUX || DT_UNDER_OS == DT_MAC
+	int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+	if (fd < 0) return false;
+
+	struct stat st;
+	if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size <= 0) {
+		close(fd);
+		return false;
+	}
+
+	size_t size = (size_t)st.st_size;
+	void* data = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (data == MAP_FAILED) return false;
+
+	bool ret = zone.load((const uint8_t*)data, size);
+	munmap(data, size);
+	return ret;
+#else
+	return zone.loadFile(path.c_str());
+#endif // DT_UNDER_OS == DT_LINUX || DT_UNDER_OS == DT_MAC
+}
+
+std::mutex& TimeZoneDB::getMutex() {
+	static std::mutex mutex;
+	return mutex;
+}
+
+TimeZoneDB::cache_t& TimeZoneDB::getCache() {
+	static cache_t cache;
+	return cache;
+}
+
+#endif // DT_UNDER_OS > 0
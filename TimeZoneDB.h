@@ -0,0 +1,99 @@
+/**
+ * @file TimeZoneDB.h
+ * @brief This file contains class TimeZoneDB, which is process-wide cache of time zones loaded from IANA time zone database (TZif files).
+ *
+ * Zone file is memory-mapped and parsed only on the first request of zone. Parsed zones are immutable and they are never released,
+ * so zone handle is just a pointer, which can be freely copied and shared between threads.
+ *
+ * @see TimeZoneDB
+ *
+ * # Credits
+ * @author Matej Fitoš
+ */
+
+#ifndef _TIME_ZONE_DB_H
+#define _TIME_ZONE_DB_H
+
+#include "tzfileParser.h"
+
+#if DT_UNDER_OS > 0
+#include <map>
+#include <mutex>
+#include <string>
+
+/**
+* @class TimeZoneDB
+* @brief Process-wide cache of time zones from IANA time zone database.
+*
+* Zones are loaded from directory specified by environment variable TZDIR or by macro TZDIR, when environment variable is not set.
+* The first request of zone maps its file to memory and parses it, next requests of the same zone
+* only find zone in cache, so they do not do any I/O, parsing or allocation.
+* Zone file is parsed without lock, so loading of one zone does not block requests of other zones.
+* Zone, which was not found, is not cached, so it is searched again on next request.
+* @code{.cpp}
+* TimeZoneDB::Zone berlin = TimeZoneDB::get("Europe/Berlin");
+* if (berlin != NULL) {
+*     DateTime local(berlin->toLocal(utc.getRaw()));
+* }
+* @endcode
+*/
+class TimeZoneDB {
+public:
+
+	/**
+	* @brief Handle of cached zone. Zone is valid until end of program.
+	*/
+	typedef const TZifZone* Zone;
+
+	/**
+	* @brief Gets zone by its name. Zone is loaded on the first request.
+	* @param name Name of zone, for example "Europe/Berlin".
+	* @return Returns handle of zone or NULL if zone does not exist or its file is not valid.
+	*/
+	static Zone get(const char* name);
+
+	/**
+	* @brief Gets zone by its name. Zone is loaded on the first request.
+	* @param name Name of zone, for example "Europe/Berlin".
+	* @return Returns handle of zone or NULL if zone does not exist or its file is not valid.
+	*/
+	static inline Zone get(const std::string& name) {
+		return get(name.c_str());
+	}
+
+	/**
+	* @brief Gets directory with zone files.
+	*/
+	static const std::string& getDirectory();
+
+	/**
+	* @brief Gets count of cached zones. Names, which were not found, are not cached.
+	*/
+	static size_t getCachedCount();
+
+private:
+	/**
+	* @brief Checks if name of zone can be used as relative path in zone directory.
+	*/
+	static bool isValidName(const char* name);
+
+	/**
+	* @brief Maps zone file to memory and parses it.
+	*/
+	static bool loadMapped(const std::string& path, TZifZone& zone);
+
+	static std::mutex& getMutex();
+
+#if DT_CPP_VERSION >= 201402L
+	//Transparent comparator, so no string is created, when zone is already cached
+	typedef std::map<std::string, TZifZone, std::less<>> cache_t;
+#else
+	typedef std::map<std::string, TZifZone> cache_t;
+#endif
+
+	static cache_t& getCache();
+};
+
+#endif // DT_UNDER_OS > 0
+
+#endif // !_TIME_ZONE_DB_H
@@ -0,0 +1,45 @@
+#include "TimeZoneRegistry.h"
+
+#if DT_UNDER_OS > 0 || defined(ESP32)
+#include <mutex>
+static std::mutex& getRegistryMutex() {
+	static std::mutex mutex;
+	return mutex;
+}
+#endif // DT_UNDER_OS > 0 || defined(ESP32)
+
+TimeZoneRegistry::zone_s TimeZoneRegistry::zones[DT_TZ_REGISTRY_SIZE];
+uint32_t TimeZoneRegistry::count = 1; //UTC zone is always registered
+
+bool TimeZoneRegistry::add(TimeZone tz, const DSTAdjustment& dst, Index& index) {
+#if DT_UNDER_OS > 0 || defined(ESP32)
+	std::lock_guard<std::mutex> lock(getRegistryMutex());
+#endif // DT_UNDER_OS > 0 || defined(ESP32)
+
+	for (uint32_t i = 0; i < count; i++) {
+		const zone_s& zone = zones[i];
+		if (zone.timeZone.getTimeZoneOffsetTotalMinutes() == tz.getTimeZoneOffsetTotalMinutes() &&
+			zone.DST.getDSTOffsetTotalMinutes() == dst.getDSTOffsetTotalMinutes() &&
+			zone.DST.DaylightTransitionStart == dst.DaylightTransitionStart &&
+			zone.DST.DaylightTransitionEnd == dst.DaylightTransitionEnd) {
+			index = (Index)i;
+			return true;
+		}
+	}
+
+	if (count >= DT_TZ_REGISTRY_SIZE) return false;
+
+	//Zone is written before its index is returned, readers never see partially written zone
+	zones[count].timeZone = tz;
+	zones[count].DST = DSTAdjustment(dst, false);
+	index = (Index)count;
+	count++;
+	return true;
+}
+
+size_t TimeZoneRegistry::getCount() {
+#if DT_UNDER_OS > 0 || defined(ESP32)
+	std::lock_guard<std::mutex> lock(getRegistryMutex());
+#endif // DT_UNDER_OS > 0 || defined(ESP32)
+	return count;
+}
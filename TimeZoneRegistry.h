@@ -0,0 +1,106 @@
+/**
+ * @file TimeZoneRegistry.h
+ * @brief This file contains class TimeZoneRegistry, which is process-wide table of time zones and DST adjustments
+ * referenced by 16-bit index.
+ *
+ * Registry is used by DateTimeTZRef, which stores only index of zone instead of whole TimeZone and DSTAdjustment.
+ * Registered zones are never removed, so index stays valid until end of program.
+ *
+ * @see TimeZoneRegistry
+ * @see DateTimeTZRef
+ *
+ * # Credits
+ * @author Matej Fitoš
+ */
+
+#ifndef _TIME_ZONE_REGISTRY_H
+#define _TIME_ZONE_REGISTRY_H
+
+#include "TimeZone.h"
+
+#ifndef DT_TZ_REGISTRY_SIZE
+#if DT_UNDER_OS > 0
+#define DT_TZ_REGISTRY_SIZE	(4096)	//Maximum count of zones in TimeZoneRegistry
+#else
+#define DT_TZ_REGISTRY_SIZE	(16)	//Maximum count of zones in TimeZoneRegistry
+#endif // DT_UNDER_OS > 0
+#endif // !DT_TZ_REGISTRY_SIZE
+
+static_assert(DT_TZ_REGISTRY_SIZE >= 1 && DT_TZ_REGISTRY_SIZE <= 65536, "DT_TZ_REGISTRY_SIZE has to be in range from 1 to 65536");
+
+/**
+* @class TimeZoneRegistry
+* @brief Process-wide table of zones (time zone and DST adjustment), which can be referenced by 16-bit index.
+*
+* Zone with index 0 is always UTC without DST. Same zone is registered only once, so registering zone,
+* which already exists, just returns its index. Reading zone is only lookup in static table without any lock.
+* @code{.cpp}
+* TimeZoneRegistry::Index berlin;
+* if (TimeZoneRegistry::add(TimeZones::CET, DSTAdjustment::CentralEurope, berlin)) {
+*     DateTimeTZRef dt(DateTime(2024, 1, 1), berlin);
+* }
+* @endcode
+* @note Index has to be passed to other threads the same way as any other data (with proper synchronization).
+*/
+class TimeZoneRegistry {
+public:
+
+	/**
+	* @brief Index of zone in registry.
+	*/
+	typedef uint16_t Index;
+
+	/**
+	* @brief Index of UTC zone without DST.
+	*/
+	static const Index UTC = 0;
+
+	/**
+	* @brief Registers zone or finds zone, which was already registered.
+	* @param tz Time zone.
+	* @param dst DST adjustment rules and offset. DST flag is ignored.
+	* @param[out] index Index of zone.
+	* @return Returns true if zone was found or registered. Returns false if registry is full (see DT_TZ_REGISTRY_SIZE).
+	*/
+	static bool add(TimeZone tz, const DSTAdjustment& dst, Index& index);
+
+	/**
+	* @brief Gets time zone of zone.
+	* @param index Index of registered zone.
+	*/
+	static inline TimeZone getTimeZone(Index index) {
+		return zones[index].timeZone;
+	}
+
+	/**
+	* @brief Gets DST adjustment of zone. DST flag of returned DST adjustment is always false.
+	* @param index Index of registered zone.
+	*/
+	static inline const DSTAdjustment& getDST(Index index) {
+		return zones[index].DST;
+	}
+
+	/**
+	* @brief Gets count of registered zones including UTC zone.
+	*/
+	static size_t getCount();
+
+private:
+	/**
+	* @struct zone_s
+	* @brief Registered zone.
+	*/
+	struct zone_s {
+		TimeZone timeZone;
+		DSTAdjustment DST;
+	};
+
+	/**
+	* @brief Table of zones. It is constant initialized, so it can be used during static initialization.
+	*/
+	static zone_s zones[DT_TZ_REGISTRY_SIZE];
+
+	static uint32_t count;
+};
+
+#endif // !_TIME_ZONE_REGISTRY_H
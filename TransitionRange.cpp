@@ -0,0 +1,205 @@
+#include "TransitionRange.h"
+
+TransitionRange::TransitionRange(TimeZone tz, const DSTAdjustment& dst, int64_t fromUTC, int64_t toUTC) {
+	first.timeZone = tz;
+	first.DST = DSTAdjustment(dst, false);
+	last = first;
+	if (toUTC < fromUTC) toUTC = fromUTC;
+	first.seek(fromUTC);
+	last.seek(toUTC);
+}
+
+#if DT_UNDER_OS > 0
+TransitionRange::TransitionRange(const TZifZone& zone, int64_t fromUTC, int64_t toUTC) {
+	first.zone = &zone;
+	last = first;
+	if (toUTC < fromUTC) toUTC = fromUTC;
+	first.seek(fromUTC);
+	last.seek(toUTC);
+}
+#endif // DT_UNDER_OS > 0
+
+void TransitionRange::iterator::seek(int64_t utc) {
+#if DT_UNDER_OS > 0
+	if (zone != NULL) {
+		//The first transition of table, which happens at utc or after it
+		size_t count = zone->getTransitionCount();
+		size_t lo = 0;
+		size_t hi = count;
+		while (lo < hi) {
+			size_t mid = lo + (hi - lo) / 2;
+			if (zone->getTransition(mid) < utc) lo = mid + 1;
+			else hi = mid;
+		}
+		if (lo < count) {
+			setFromTable(lo);
+			return;
+		}
+		if (!zone->hasFooter()) {
+			setAfterEnd();
+			return;
+		}
+		//Transitions of POSIX rule are used only after the last transition of table
+		if (count > 0 && utc <= zone->getTransition(count - 1)) {
+			utc = zone->getTransition(count - 1) + 1;
+		}
+	}
+#endif // DT_UNDER_OS > 0
+	seekRules(utc);
+}
+
+void TransitionRange::iterator::seekRules(int64_t utc) {
+	int64_t tzOffset = ((int64_t)getRulesTimeZoneMinutes()) * MINUTE;
+	int32_t y = dtlib::getYearFromRaw(utc + tzOffset);
+	if (!loadYear(y)) {
+		setAfterEnd();
+		return;
+	}
+	for (uint8_t i = 0; i < 2; i++) {
+		if (yearTransitions[i] >= utc) {
+			setFromYear(i);
+			return;
+		}
+	}
+
+	//All transitions of year already happened
+	y++;
+	if (y == 0) y++;
+	if (!loadYear(y)) {
+		setAfterEnd();
+		return;
+	}
+	setFromYear(0);
+}
+
+void TransitionRange::iterator::next() {
+	size_t count = getTableCount();
+	switch (phase) {
+	case BeforeBegin:
+		if (count > 0) setFromTable(0);
+		else setAfterEnd();
+		break;
+	case Table:
+		if (tableIndex + 1 < count) {
+			setFromTable(tableIndex + 1);
+		}
+#if DT_UNDER_OS > 0
+		else if (zone->hasFooter()) {
+			seekRules(zone->getTransition(count - 1) + 1);
+		}
+#endif // DT_UNDER_OS > 0
+		else {
+			setAfterEnd();
+		}
+		break;
+	case Rules:
+		if (yearIndex == 0) {
+			setFromYear(1);
+		}
+		else {
+			int32_t y = year + 1;
+			if (y == 0) y++;
+			if (loadYear(y)) setFromYear(0);
+			else setAfterEnd();
+		}
+		break;
+	default:
+		break;
+	}
+}
+
+void TransitionRange::iterator::prev() {
+	size_t count = getTableCount();
+	switch (phase) {
+	case Table:
+		if (tableIndex > 0) setFromTable(tableIndex - 1);
+		else setBeforeBegin();
+		break;
+	case Rules:
+		if (yearIndex == 1) {
+			setFromYear(0);
+		}
+		else {
+			int32_t y = year - 1;
+			if (y == 0) y--;
+			if (loadYear(y)) setFromYear(1);
+			else setBeforeBegin();
+		}
+#if DT_UNDER_OS > 0
+		//Transitions of POSIX rule before the last transition of table are replaced by table
+		if (count > 0 && (phase == BeforeBegin || current.utc <= zone->getTransition(count - 1))) {
+			setFromTable(count - 1);
+		}
+#endif // DT_UNDER_OS > 0
+		break;
+	case AfterEnd:
+		if (count > 0) setFromTable(count - 1);
+		else setBeforeBegin();
+		break;
+	default:
+		break;
+	}
+}
+
+bool TransitionRange::iterator::loadYear(int32_t y) {
+	if (getRulesDST().getTransitionsOfYear(y, yearTransitions, yearToDST) == 0) return false;
+	int64_t tzOffset = ((int64_t)getRulesTimeZoneMinutes()) * MINUTE;
+	yearTransitions[0] -= tzOffset;
+	yearTransitions[1] -= tzOffset;
+	year = y;
+	return true;
+}
+
+void TransitionRange::iterator::setFromYear(uint8_t index) {
+	yearIndex = index;
+	phase = Rules;
+	current.utc = yearTransitions[index];
+	current.isDST = yearToDST[index];
+	current.utcOffset = ((int32_t)getRulesTimeZoneMinutes() + (current.isDST ? getRulesDST().getDSTOffsetTotalMinutes() : 0)) * 60;
+}
+
+void TransitionRange::iterator::setFromTable(size_t index) {
+#if DT_UNDER_OS > 0
+	const tzif_type_s& type = zone->getTransitionType(index);
+	tableIndex = index;
+	phase = Table;
+	current.utc = zone->getTransition(index);
+	current.utcOffset = type.utcOffset;
+	current.isDST = type.isDST != 0;
+#endif // DT_UNDER_OS > 0
+}
+
+void TransitionRange::iterator::setBeforeBegin() {
+	phase = BeforeBegin;
+	current.utc = INT64_MIN;
+	current.utcOffset = 0;
+	current.isDST = false;
+}
+
+void TransitionRange::iterator::setAfterEnd() {
+	phase = AfterEnd;
+	current.utc = INT64_MAX;
+	current.utcOffset = 0;
+	current.isDST = false;
+}
+
+const DSTAdjustment& TransitionRange::iterator::getRulesDST() const {
+#if DT_UNDER_OS > 0
+	if (zone != NULL) return zone->getFooterDST();
+#endif // DT_UNDER_OS > 0
+	return DST;
+}
+
+int16_t TransitionRange::iterator::getRulesTimeZoneMinutes() const {
+#if DT_UNDER_OS > 0
+	if (zone != NULL) return zone->getFooterTimeZone().getTimeZoneOffsetTotalMinutes();
+#endif // DT_UNDER_OS > 0
+	return timeZone.getTimeZoneOffsetTotalMinutes();
+}
+
+size_t TransitionRange::iterator::getTableCount() const {
+#if DT_UNDER_OS > 0
+	if (zone != NULL) return zone->getTransitionCount();
+#endif // DT_UNDER_OS > 0
+	return 0;
+}
@@ -0,0 +1,261 @@
+/**
+ * @file TransitionRange.h
+ * @brief This file contains class TransitionRange, which enumerates transitions of zone (DST transitions or changes
+ * of offset) in interval of UTC times.
+ *
+ * Iterator keeps its position between steps, so DST rules are evaluated only once per year and transitions of TZif zone
+ * are found by binary search only once, when iterator is created. Each step costs O(1) amortized.
+ *
+ * @see TransitionRange
+ *
+ * # Credits
+ * @author Matej Fitoš
+ */
+
+#ifndef _TRANSITION_RANGE_H
+#define _TRANSITION_RANGE_H
+
+#include "TimeZone.h"
+#include "tzfileParser.h"
+#include <iterator>
+
+class TZifZone;
+
+/**
+* @struct tz_transition_s
+* @brief Transition of zone.
+*/
+struct tz_transition_s {
+	int64_t utc;		/**< Time of transition as raw UTC value. */
+	int32_t utcOffset;	/**< Offset from UTC in seconds (time zone and DST offset), which is valid from transition. */
+	bool isDST;			/**< True if DST is applied from transition. */
+};
+
+/**
+* @class TransitionRange
+* @brief Range of transitions of zone, which happen in interval [from, to) of UTC times. Zone is time zone with DST adjustment
+* or TZif zone. Transitions can be walked forward and backward.
+* @code{.cpp}
+* TransitionRange range(TimeZones::CET, DSTAdjustment::CentralEurope, DateTime(2020, 1, 1).getRaw(), DateTime(2030, 1, 1).getRaw());
+* for (const tz_transition_s& trans : range) {
+*     //20 transitions from the oldest
+* }
+* for (TransitionRange::reverse_iterator it = range.rbegin(); it != range.rend(); ++it) {
+*     //20 transitions from the newest
+* }
+* @endcode
+* @note TZif zone is referenced by range and its iterators, so it has to be valid until they are used.
+*/
+class TransitionRange {
+public:
+
+	/**
+	* @class iterator
+	* @brief Bidirectional iterator of transitions. Iterators are equal, when they point to transition with the same time.
+	*/
+	class iterator {
+	public:
+		typedef std::bidirectional_iterator_tag iterator_category;
+		typedef tz_transition_s value_type;
+		typedef std::ptrdiff_t difference_type;
+		typedef const tz_transition_s* pointer;
+		typedef tz_transition_s reference;	//Returned by value, so iterator can be used by std::reverse_iterator
+
+		/**
+		* @brief Creates iterator of zone without transitions.
+		*/
+		iterator() {}
+
+		/**
+		* @brief Gets transition, which iterator points to.
+		*/
+		inline tz_transition_s operator*() const {
+			return current;
+		}
+
+		/**
+		* @brief Gets transition, which iterator points to.
+		*/
+		inline const tz_transition_s* operator->() const {
+			return &current;
+		}
+
+		/**
+		* @brief Moves iterator to the next transition.
+		*/
+		inline iterator& operator++() {
+			next();
+			return *this;
+		}
+
+		/**
+		* @brief Moves iterator to the next transition.
+		*/
+		inline iterator operator++(int) {
+			iterator it = *this;
+			next();
+			return it;
+		}
+
+		/**
+		* @brief Moves iterator to the previous transition.
+		*/
+		inline iterator& operator--() {
+			prev();
+			return *this;
+		}
+
+		/**
+		* @brief Moves iterator to the previous transition.
+		*/
+		inline iterator operator--(int) {
+			iterator it = *this;
+			prev();
+			return it;
+		}
+
+		inline bool operator==(const iterator& it) const {
+			return current.utc == it.current.utc;
+		}
+
+		inline bool operator!=(const iterator& it) const {
+			return current.utc != it.current.utc;
+		}
+
+	private:
+		friend class TransitionRange;
+
+		/**
+		* @brief Position of iterator.
+		*/
+		enum phase_e : uint8_t {
+			BeforeBegin,	//Before the first transition of zone
+			Table,			//At transition from table of TZif zone
+			Rules,			//At transition computed by DST rules
+			AfterEnd		//After the last transition of zone
+		};
+
+		/**
+		* @brief Moves iterator to the first transition, which happens at specified time or after it.
+		*/
+		void seek(int64_t utc);
+
+		void next();
+
+		void prev();
+
+		/**
+		* @brief Moves iterator to transition of the first year computed by DST rules, which happens at specified time or after it.
+		*/
+		void seekRules(int64_t utc);
+
+		/**
+		* @brief Computes transitions of year by DST rules.
+		* @return Returns false if there are no transitions.
+		*/
+		bool loadYear(int32_t year);
+
+		/**
+		* @brief Sets current transition to transition of loaded year.
+		*/
+		void setFromYear(uint8_t index);
+
+		/**
+		* @brief Sets current transition to transition of TZif zone.
+		*/
+		void setFromTable(size_t index);
+
+		void setBeforeBegin();
+
+		void setAfterEnd();
+
+		/**
+		* @brief Gets DST rules, which are used for transitions, which are not in table.
+		*/
+		const DSTAdjustment& getRulesDST() const;
+
+		/**
+		* @brief Gets time zone offset of DST rules in minutes.
+		*/
+		int16_t getRulesTimeZoneMinutes() const;
+
+		/**
+		* @brief Gets count of transitions in table of TZif zone.
+		*/
+		size_t getTableCount() const;
+
+		tz_transition_s current = { INT64_MAX, 0, false };
+		TimeZone timeZone;
+		DSTAdjustment DST;
+		const TZifZone* zone = NULL;	//NULL if iterator walks time zone with DST adjustment
+		size_t tableIndex = 0;
+		int64_t yearTransitions[2] = {};	//Transitions of loaded year as raw UTC values
+		bool yearToDST[2] = {};
+		int32_t year = 0;
+		uint8_t yearIndex = 0;
+		phase_e phase = AfterEnd;
+	};
+
+	typedef iterator const_iterator;
+	typedef std::reverse_iterator<iterator> reverse_iterator;
+
+	/**
+	* @brief Creates range of transitions of time zone with DST adjustment.
+	* @param tz Time zone.
+	* @param dst DST adjustment rules and offset. DST flag is ignored.
+	* @param fromUTC The first UTC time of range in raw form (inclusive).
+	* @param toUTC The last UTC time of range in raw form (exclusive).
+	*/
+	TransitionRange(TimeZone tz, const DSTAdjustment& dst, int64_t fromUTC, int64_t toUTC);
+
+#if DT_UNDER_OS > 0
+	/**
+	* @brief Creates range of transitions of TZif zone. Transitions from table of zone are followed by transitions of its POSIX rule.
+	* @param zone TZif zone, which has to be valid until range and its iterators are used.
+	* @param fromUTC The first UTC time of range in raw form (inclusive).
+	* @param toUTC The last UTC time of range in raw form (exclusive).
+	*/
+	TransitionRange(const TZifZone& zone, int64_t fromUTC, int64_t toUTC);
+#endif // DT_UNDER_OS > 0
+
+	/**
+	* @brief Gets iterator of the first transition in range.
+	*/
+	inline iterator begin() const {
+		return first;
+	}
+
+	/**
+	* @brief Gets iterator of the first transition after range. It can be decremented to get the last transition in range.
+	*/
+	inline iterator end() const {
+		return last;
+	}
+
+	/**
+	* @brief Gets reverse iterator of the last transition in range.
+	*/
+	inline reverse_iterator rbegin() const {
+		return reverse_iterator(last);
+	}
+
+	/**
+	* @brief Gets reverse iterator of the first transition before range.
+	*/
+	inline reverse_iterator rend() const {
+		return reverse_iterator(first);
+	}
+
+	/**
+	* @brief Checks if there is no transition in range.
+	*/
+	inline bool empty() const {
+		return first == last;
+	}
+
+private:
+	iterator first;
+	iterator last;
+};
+
+#endif // !_TRANSITION_RANGE_H
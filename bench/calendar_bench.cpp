@@ -0,0 +1,106 @@
+/**
+ * @file calendar_bench.cpp
+ * @brief Benchmark of calendar kernel (conversion of days to year, month and day).
+ *
+ * Build it twice, once with default kernel and once with legacy kernel and compare results:
+ * @verbatim
+ * g++ -O2 -I.. calendar_bench.cpp ../DateTimeHelpers.cpp -o calendar_bench
+ * g++ -O2 -I.. -DDT_LEGACY_CALENDAR calendar_bench.cpp ../DateTimeHelpers.cpp -o calendar_bench_legacy
+ * @endverbatim
+ */
+
+#include "DateTimeHelpers.h"
+#include <cstdio>
+
+using namespace dtlib;
+
+#define BENCH_ROUNDS	(20)
+#define BENCH_SPAN		(1 << 20)	//Count of days converted in one round
+
+template<class F>
+static double benchNsPerCall(F func) {
+	int64_t best = INT64_MAX;
+	for (int r = 0; r < BENCH_ROUNDS; r++) {
+		int64_t start = getSysTicks();
+		func();
+		int64_t elapsed = getSysTicks() - start;
+		if (elapsed < best) best = elapsed;
+	}
+	return (double)best * 1000.0 / BENCH_SPAN;
+}
+
+int main() {
+	//Days are spread over the whole valid range, so BC and AD dates are mixed
+	static int32_t days[BENCH_SPAN];
+	uint32_t seed = 12345;
+	for (int i = 0; i < BENCH_SPAN; i++) {
+		seed = seed * 1664525UL + 1013904223UL;
+		days[i] = MIN_DAYS + (int32_t)(seed % (uint32_t)(MAX_DAYS - MIN_DAYS));
+	}
+
+	volatile uint32_t sink = 0;
+
+	double ydNs = benchNsPerCall([&]() {
+		uint32_t acc = 0;
+		for (int i = 0; i < BENCH_SPAN; i++) {
+			year_day_tuple yd = getYearFromDays(days[i]);
+			acc += yd.year + yd.dayOfYear;
+		}
+		sink = sink + acc;
+	});
+
+	double ymdNs = benchNsPerCall([&]() {
+		uint32_t acc = 0;
+		for (int i = 0; i < BENCH_SPAN; i++) {
+			year_day_tuple yd = getYearFromDays(days[i]);
+			month_day_tuple md = getMonthFromDayOfYear(yd.dayOfYear, isLeapYear(yd.year));
+			acc += yd.year + md.month + md.day;
+		}
+		sink = sink + acc;
+	});
+
+	double dateNs = benchNsPerCall([&]() {
+		uint32_t acc = 0;
+		for (int i = 0; i < BENCH_SPAN; i++) {
+			date_s date = getDateFromDays(days[i]);
+			acc += date.year + date.month + date.day + date.dayOfWeek;
+		}
+		sink = sink + acc;
+	});
+
+	double rawNs = benchNsPerCall([&]() {
+		uint32_t acc = 0;
+		for (int i = 0; i < BENCH_SPAN; i++) {
+			date_time_s dt = rawToDateTime((int64_t)days[i] * DAY + i);
+			acc += dt.year + dt.month + dt.day + dt.microseconds;
+		}
+		sink = sink + acc;
+	});
+
+	int32_t years[BENCH_SPAN / 16];
+	for (int i = 0; i < BENCH_SPAN / 16; i++) {
+		years[i] = getYearFromDays(days[i]).year;
+	}
+	double duyNs = benchNsPerCall([&]() {
+		uint32_t acc = 0;
+		for (int j = 0; j < 16; j++) {
+			for (int i = 0; i < BENCH_SPAN / 16; i++) {
+				acc += getDaysUntilYear(years[i]);
+			}
+		}
+		sink = sink + acc;
+	});
+
+#ifdef DT_LEGACY_CALENDAR
+	printf("Calendar kernel: legacy\n");
+#else
+	printf("Calendar kernel: default\n");
+#endif // DT_LEGACY_CALENDAR
+	printf("getYearFromDays                        %6.2f ns/call\n", ydNs);
+	printf("getYearFromDays+getMonthFromDayOfYear  %6.2f ns/call\n", ymdNs);
+	printf("getDateFromDays                        %6.2f ns/call\n", dateNs);
+	printf("rawToDateTime                          %6.2f ns/call\n", rawNs);
+	printf("getDaysUntilYear                       %6.2f ns/call\n", duyNs);
+	printf("(checksum %u)\n", (unsigned)sink);
+	return 0;
+}
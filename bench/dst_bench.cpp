@@ -0,0 +1,76 @@
+/**
+ * @file dst_bench.cpp
+ * @brief Benchmark of DST region checking: bulk increments of DateTimeTZ across the whole year with DST transitions,
+ * DSTAdjustment::checkDSTRegion() and DSTAdjustment::getNextTransitionDate().
+ *
+ * @verbatim
+ * g++ -std=c++17 -O2 -I.. dst_bench.cpp ../DateTimeHelpers.cpp ../TimeZone.cpp ../TimeSpan.cpp ../tzfileParser.cpp ../TimeZoneDB.cpp -o dst_bench
+ * @endverbatim
+ */
+
+#include "DateTimeTZ.h"
+#include <cstdio>
+
+using namespace dtlib;
+
+#define BENCH_ROUNDS	(20)
+#define BENCH_SPAN		(366 * 24 * 4)	//Count of 15 minute steps in one leap year
+
+template<class F>
+static double benchNsPerCall(F func) {
+	int64_t best = INT64_MAX;
+	for (int r = 0; r < BENCH_ROUNDS; r++) {
+		int64_t start = getSysTicks();
+		func();
+		int64_t elapsed = getSysTicks() - start;
+		if (elapsed < best) best = elapsed;
+	}
+	return (double)best * 1000.0 / BENCH_SPAN;
+}
+
+static volatile uint32_t sink = 0;
+
+static void benchDST(const char* name, TimeZones::TimeZoneName tz, const DSTAdjustment& adj) {
+	DateTimeTZ first(2024, 1, 1, tz, adj);
+
+	double addNs = benchNsPerCall([&]() {
+		DateTimeTZ dt = first;
+		uint32_t acc = 0;
+		for (int i = 0; i < BENCH_SPAN; i++) {
+			dt.addMinutes(15);
+			acc += dt.isDST();
+		}
+		sink = sink + acc;
+	});
+
+	double checkNs = benchNsPerCall([&]() {
+		int64_t raw = first.getRaw();
+		uint32_t acc = 0;
+		for (int i = 0; i < BENCH_SPAN; i++) {
+			acc += adj.checkDSTRegion(raw);
+			raw += 15 * MINUTE;
+		}
+		sink = sink + acc;
+	});
+
+	double nextNs = benchNsPerCall([&]() {
+		int64_t raw = first.getRaw();
+		uint32_t acc = 0;
+		bool nextIsDST;
+		for (int i = 0; i < BENCH_SPAN; i++) {
+			acc += (uint32_t)adj.getNextTransitionDate(raw, nextIsDST).getRaw() + nextIsDST;
+			raw += 15 * MINUTE;
+		}
+		sink = sink + acc;
+	});
+
+	printf("%-16s %8.2f %8.2f %8.2f\n", name, addNs, checkNs, nextNs);
+}
+
+int main() {
+	printf("ns/call          addMinutes checkDSTRegion getNextTransitionDate\n");
+	benchDST("CentralEurope", TimeZones::CET, DSTAdjustment::CentralEurope);
+	benchDST("NorthAmerica", TimeZones::EST, DSTAdjustment::NorthAmerica);
+	benchDST("NewZeland", TimeZones::NZST, DSTAdjustment::NewZeland);
+	return 0;
+}
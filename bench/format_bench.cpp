@@ -0,0 +1,85 @@
+/**
+ * @file format_bench.cpp
+ * @brief Benchmark of date and time formatting: interpreted format string, precompiled DateTimeFormat
+ * and format known at compile time (DateTimeRawBase::format()).
+ *
+ * @verbatim
+ * g++ -std=c++17 -O2 -I.. format_bench.cpp ../DateTimeHelpers.cpp ../DateTimeFormat.cpp ../TimeZone.cpp ../tzfileParser.cpp ../TimeZoneDB.cpp -o format_bench
+ * @endverbatim
+ */
+
+#include "DateTimeBase.h"
+#include <cstdio>
+
+using namespace dtlib;
+
+#define BENCH_ROUNDS	(20)
+#define BENCH_SPAN		(1 << 18)	//Count of values converted in one round
+
+static constexpr char logFormat[] = "yyyy-MM-dd HH:mm:ss.ffffff";
+static constexpr char isoFormat[] = "yyyy-MM-ddTHH:mm:ss.fffZZZ";
+static constexpr char longFormat[] = "dddd, MMMM dd, yyyy hh:mm tt";
+
+template<class F>
+static double benchNsPerCall(F func) {
+	int64_t best = INT64_MAX;
+	for (int r = 0; r < BENCH_ROUNDS; r++) {
+		int64_t start = getSysTicks();
+		func();
+		int64_t elapsed = getSysTicks() - start;
+		if (elapsed < best) best = elapsed;
+	}
+	return (double)best * 1000.0 / BENCH_SPAN;
+}
+
+static int64_t values[BENCH_SPAN];
+static volatile uint32_t sink = 0;
+
+template<const char* Format>
+static void benchFormat(const char* name) {
+	DateTimeFormat compiled(Format);
+	char buffer[DT_FORMAT_MAX_LENGTH + 1];
+
+	double interpretedNs = benchNsPerCall([&]() {
+		uint32_t acc = 0;
+		for (int i = 0; i < BENCH_SPAN; i++) {
+			acc += (uint32_t)(dateTimeToArray(buffer, sizeof(buffer), Format, values[i], 60, 60) - buffer);
+		}
+		sink = sink + acc;
+	});
+
+	double compiledNs = benchNsPerCall([&]() {
+		uint32_t acc = 0;
+		for (int i = 0; i < BENCH_SPAN; i++) {
+			acc += (uint32_t)(compiled.toArray(buffer, sizeof(buffer), values[i], 60, 60) - buffer);
+		}
+		sink = sink + acc;
+	});
+
+	double staticNs = benchNsPerCall([&]() {
+		uint32_t acc = 0;
+		for (int i = 0; i < BENCH_SPAN; i++) {
+			acc += (uint32_t)(StaticFormat<Format>::toArray(buffer, sizeof(buffer), values[i], 60, 60) - buffer);
+		}
+		sink = sink + acc;
+	});
+
+	printf("%-30s %8.2f %8.2f %8.2f\n", name, interpretedNs, compiledNs, staticNs);
+}
+
+int main() {
+	//Values are spread over years 1 to 9999
+	uint32_t seed = 12345;
+	for (int i = 0; i < BENCH_SPAN; i++) {
+		seed = seed * 1664525UL + 1013904223UL;
+		uint64_t r = ((uint64_t)seed << 20) ^ (seed >> 3);
+		values[i] = (int64_t)(r % (uint64_t)(3652059LL * DAY));
+	}
+
+	printf("ns/call                        dateTimeToArray DateTimeFormat format<>\n");
+	benchFormat<logFormat>(logFormat);
+	benchFormat<isoFormat>(isoFormat);
+	benchFormat<longFormat>(longFormat);
+	printf("(checksum %u)\n", (unsigned)sink);
+	return 0;
+}
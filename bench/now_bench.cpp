@@ -0,0 +1,81 @@
+/**
+ * @file now_bench.cpp
+ * @brief Benchmark of reading current time: direct path (DateTimeSysSync::nowUTC(), DateTimeTZSysSync::now())
+ * and cached time published by CoarseClock.
+ *
+ * @verbatim
+ * g++ -std=c++17 -O2 -I.. now_bench.cpp ../CoarseClock.cpp ../DateTimeSysSync.cpp ../DateTimeTZSysSync.cpp ../DateTimeHelpers.cpp ../TimeZone.cpp ../TimeSpan.cpp ../tzfileParser.cpp ../TimeZoneDB.cpp -o now_bench -lpthread
+ * @endverbatim
+ */
+
+#include "CoarseClock.h"
+#include "DateTimeTZSysSync.h"
+#include <cstdio>
+
+using namespace dtlib;
+
+#define BENCH_ROUNDS	(20)
+#define BENCH_SPAN		(1 << 16)	//Count of readings in one round
+
+template<class F>
+static double benchNsPerCall(F func) {
+	int64_t best = INT64_MAX;
+	for (int r = 0; r < BENCH_ROUNDS; r++) {
+		int64_t start = getSysTicks();
+		func();
+		int64_t elapsed = getSysTicks() - start;
+		if (elapsed < best) best = elapsed;
+	}
+	return (double)best * 1000.0 / BENCH_SPAN;
+}
+
+static volatile uint32_t sink = 0;
+
+static void benchNow(const char* name) {
+	double utcNs = benchNsPerCall([]() {
+		uint32_t acc = 0;
+		for (int i = 0; i < BENCH_SPAN; i++) {
+			acc += (uint32_t)CoarseClock::nowUTC().getRaw();
+		}
+		sink = sink + acc;
+	});
+
+	double localNs = benchNsPerCall([]() {
+		uint32_t acc = 0;
+		bool isDST;
+		for (int i = 0; i < BENCH_SPAN; i++) {
+			acc += (uint32_t)CoarseClock::now(isDST).getRaw() + isDST;
+		}
+		sink = sink + acc;
+	});
+
+	printf("%-28s %8.2f %8.2f\n", name, utcNs, localNs);
+}
+
+int main() {
+	printf("ns/call                       UTC      local\n");
+
+	double utcNs = benchNsPerCall([]() {
+		uint32_t acc = 0;
+		for (int i = 0; i < BENCH_SPAN; i++) {
+			acc += (uint32_t)((DateTime)DateTimeSysSync::nowUTC()).getRaw();
+		}
+		sink = sink + acc;
+	});
+
+	double localNs = benchNsPerCall([]() {
+		uint32_t acc = 0;
+		for (int i = 0; i < BENCH_SPAN; i++) {
+			DateTimeTZSysSync now = DateTimeTZSysSync::now();
+			acc += (uint32_t)((DateTime)now).getRaw() + now.isDST();
+		}
+		sink = sink + acc;
+	});
+	printf("%-28s %8.2f %8.2f\n", "direct (SysSync)", utcNs, localNs);
+
+	benchNow("CoarseClock (not running)");
+	CoarseClock::start(1000);
+	benchNow("CoarseClock (1 ms period)");
+	CoarseClock::stop();
+	return 0;
+}
@@ -1,5 +1,6 @@
 #include "tzfileParser.h"
-
+#include <algorithm>
+#include <cstring>
 
 #if DT_UNDER_OS > 0
 
@@ -120,4 +121,220 @@ std::string tryGetPOSIXFrom_tzfile(const char* path) {
 }
 
 
+#define TZIF_HEADER_SIZE		(44)
+#define TZIF_UNIX_EPOCH_RAW		(62135596800000000LL)	//Raw value of 1970/01/01
+#define TZIF_MAX_UNIX_SECONDS	(INT64_MAX / SECOND - 62135596800LL)
+
+static uint32_t readBE32(const uint8_t* p) {
+	return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | (uint32_t)p[3];
+}
+
+static int64_t readBE64(const uint8_t* p) {
+	return (int64_t)(((uint64_t)readBE32(p) << 32) | readBE32(p + 4));
+}
+
+/**
+* @brief Reads TZif header from memory.
+*/
+static bool readHeader(const uint8_t* data, size_t size, size_t pos, tzif_header& header) {
+	header.valid = false;
+	if (size < TZIF_HEADER_SIZE || pos > size - TZIF_HEADER_SIZE) return false;
+	data += pos;
+	memcpy(header.magic, data, 4);
+	header.version = (char)data[4];
+	memcpy(header.reserved, data + 5, 15);
+	header.tzh_ttisutcnt = readBE32(data + 20);
+	header.tzh_ttisstdcnt = readBE32(data + 24);
+	header.tzh_leapcnt = readBE32(data + 28);
+	header.tzh_timecnt = readBE32(data + 32);
+	header.tzh_typecnt = readBE32(data + 36);
+	header.tzh_charcnt = readBE32(data + 40);
+	header.valid = memcmp(header.magic, "TZif", 4) == 0;
+	return header.valid;
+}
+
+/**
+* @brief Converts Unix time in seconds to raw value, value is limited to range of raw value.
+*/
+static int64_t unixToRaw(int64_t seconds) {
+	if (seconds > TZIF_MAX_UNIX_SECONDS) seconds = TZIF_MAX_UNIX_SECONDS;
+	else if (seconds < -TZIF_MAX_UNIX_SECONDS) seconds = -TZIF_MAX_UNIX_SECONDS;
+	return seconds * SECOND + TZIF_UNIX_EPOCH_RAW;
+}
+
+/**
+* @brief Copies abbreviation from POSIX time zone, numeric abbreviation is copied without '<' and '>' as it is in TZif data.
+*/
+static void copyFooterABR(char* to, const char* from) {
+	if (*from == '<') from++;
+	size_t i = 0;
+	for (; i < TIME_ZONE_INFO_TZ_ABR_NAME_SIZE - 1 && from[i] != '\0' && from[i] != '>'; i++) {
+		to[i] = from[i];
+	}
+	to[i] = '\0';
+}
+
+/**
+* @brief Checks if all transition times of POSIX rule are whole hours, because DSTTransitionRule keeps only hours.
+*/
+static bool hasWholeHourTransitions(const char* posix) {
+	const char* p = strchr(posix, ',');
+	if (p == NULL) return true;
+	for (; *p != '\0'; p++) {
+		if (*p != '/') continue;
+		//Hours are skipped, minutes and seconds have to be zero
+		for (p++; *p == '+' || *p == '-' || (*p >= '0' && *p <= '9'); p++);
+		while (*p == ':') {
+			for (p++; *p >= '0' && *p <= '9'; p++) {
+				if (*p != '0') return false;
+			}
+		}
+		if (*p == '\0') break;
+	}
+	return true;
+}
+
+void TZifZone::clear() {
+	transitions.clear();
+	transitionTypes.clear();
+	types.clear();
+	abbreviations.clear();
+	posix.clear();
+	footerTZ = TimeZone();
+	footerDST = DSTAdjustment();
+	footerABR[0][0] = '\0';
+	footerABR[1][0] = '\0';
+	footerValid = false;
+}
+
+bool TZifZone::loadFile(const char* path) {
+	clear();
+	std::ifstream tzfile(path, std::ios::binary);
+	if (!tzfile) return false;
+
+	std::vector<uint8_t> data((std::istreambuf_iterator<char>(tzfile)), std::istreambuf_iterator<char>());
+	return load(data.data(), data.size());
+}
+
+bool TZifZone::load(const uint8_t* data, size_t size) {
+	clear();
+
+	tzif_header header;
+	if (!readHeader(data, size, 0, header)) return false;
+
+	//Version 2 and 3 contain second header and data with 64-bit times, version 1 data are skipped
+	size_t pos = TZIF_HEADER_SIZE;
+	uint8_t timeSize = 4;
+	int headerIndex = 0;
+	if (header.version >= '2') {
+		pos += header.getSizeOfData(0);
+		if (!readHeader(data, size, pos, header)) return false;
+		pos += TZIF_HEADER_SIZE;
+		timeSize = 8;
+		headerIndex = 1;
+	}
+
+	size_t dataSize = header.getSizeOfData(headerIndex);
+	if (header.tzh_typecnt == 0 || header.tzh_typecnt > 256 || header.tzh_charcnt == 0 || dataSize > size - pos) return false;
+
+	//Transition times
+	const uint8_t* p = data + pos;
+	transitions.resize(header.tzh_timecnt);
+	for (uint32_t i = 0; i < header.tzh_timecnt; i++) {
+		int64_t seconds = (timeSize == 8) ? readBE64(p) : (int64_t)(int32_t)readBE32(p);
+		transitions[i] = unixToRaw(seconds);
+		if (i > 0 && transitions[i] < transitions[i - 1]) {
+			clear();
+			return false; //Transitions have to be sorted
+		}
+		p += timeSize;
+	}
+
+	//Transition types
+	transitionTypes.assign(p, p + header.tzh_timecnt);
+	for (uint32_t i = 0; i < header.tzh_timecnt; i++) {
+		if (transitionTypes[i] >= header.tzh_typecnt) {
+			clear();
+			return false;
+		}
+	}
+	p += header.tzh_timecnt;
+
+	//Local time types
+	types.resize(header.tzh_typecnt);
+	for (uint32_t i = 0; i < header.tzh_typecnt; i++) {
+		types[i].utcOffset = (int32_t)readBE32(p);
+		types[i].isDST = p[4] != 0;
+		types[i].abbrIndex = p[5];
+		if (p[5] >= header.tzh_charcnt) {
+			clear();
+			return false;
+		}
+		p += 6;
+	}
+
+	//Abbreviations, leap seconds and indicators are not needed
+	abbreviations.assign((const char*)p, header.tzh_charcnt);
+	if (abbreviations.back() != '\0') abbreviations.push_back('\0');
+	p = data + pos + dataSize;
+
+	//Footer with POSIX time zone enclosed in new lines
+	if (headerIndex == 1 && p < data + size && *p == '\n') {
+		const uint8_t* end = (const uint8_t*)memchr(p + 1, '\n', size - (p + 1 - data));
+		if (end != NULL && end > p + 1) {
+			posix.assign((const char*)p + 1, end - p - 1);
+			int parsed;
+			TimeZoneInfo info = TimeZoneInfo::fromPOSIX(posix.c_str(), (int)posix.size() + 1, parsed);
+			//Rule with transitions out of whole hours cannot be represented, so the last transition is used after it instead of wrong offsets
+			if (parsed > 0 && hasWholeHourTransitions(posix.c_str())) {
+				int16_t dstOffset = info.DST.getDSTOffsetTotalMinutes();
+				if (dstOffset >= 0) {
+					footerTZ = info.timeZone;
+					footerDST = info.DST;
+					copyFooterABR(footerABR[0], info.standardABR);
+					copyFooterABR(footerABR[1], info.daylightABR);
+				}
+				else {
+					//Negative DST (Europe/Dublin) is converted to the same offsets with positive DST, rules and names are swapped
+					footerTZ = TimeZone::fromTotalMinutesOffset(info.timeZone.getTimeZoneOffsetTotalMinutes() + dstOffset);
+					footerDST = DSTAdjustment(info.DST.DaylightTransitionEnd, info.DST.DaylightTransitionStart, (int8_t)(-dstOffset / 60), (int8_t)(-dstOffset % 60));
+					copyFooterABR(footerABR[0], info.daylightABR);
+					copyFooterABR(footerABR[1], info.standardABR);
+				}
+				footerValid = true;
+			}
+		}
+	}
+
+	return true;
+}
+
+tzif_offset_s TZifZone::getOffset(int64_t rawUTC) const {
+	tzif_offset_s ret;
+	if (types.empty()) {
+		ret.utcOffset = 0;
+		ret.isDST = false;
+		ret.abbreviation = "";
+		return ret;
+	}
+
+	//Count of transitions, which already happened
+	size_t index = std::upper_bound(transitions.begin(), transitions.end(), rawUTC) - transitions.begin();
+
+	if (index == transitions.size() && footerValid) {
+		//After the last transition, POSIX rule is used
+		int16_t tzOffset = footerTZ.getTimeZoneOffsetTotalMinutes();
+		ret.isDST = footerDST.checkDSTRegion(rawUTC + ((int64_t)tzOffset) * MINUTE);
+		ret.utcOffset = ((int32_t)tzOffset + (ret.isDST ? footerDST.getDSTOffsetTotalMinutes() : 0)) * 60;
+		ret.abbreviation = footerABR[ret.isDST];
+		return ret;
+	}
+
+	const tzif_type_s& type = (index == 0) ? types[0] : types[transitionTypes[index - 1]];
+	ret.utcOffset = type.utcOffset;
+	ret.isDST = type.isDST != 0;
+	ret.abbreviation = abbreviations.c_str() + type.abbrIndex;
+	return ret;
+}
+
 #endif // DT_UNDER_OS > 0
\ No newline at end of file
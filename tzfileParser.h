@@ -2,10 +2,12 @@
 #define TZFILE_PARSER_H_
 
 #include "DateTimeHelpers.h"
+#include "TimeZone.h"
 
 #if DT_UNDER_OS > 0
 #include <iostream>
 #include <fstream>
+#include <vector>
 
 #ifndef TZDIR
 #define TZDIR	"/usr/share/zoneinfo" // Time zone object file directory, but this may not be true always
@@ -81,6 +83,183 @@ struct ttinfo {
 
 std::string tryGetPOSIXFrom_tzfile(const char* path);
 
+/**
+* @struct tzif_type_s
+* @brief Local time type of TZif zone (compact ttinfo record).
+*/
+struct tzif_type_s {
+	int32_t utcOffset;		/**< Offset from UTC in seconds, which is added to UTC time to get local time. */
+	uint8_t isDST;			/**< 1 if this local time type is DST. */
+	uint8_t abbrIndex;		/**< Index of abbreviation in array of abbreviations. */
+};
+
+/**
+* @struct tzif_offset_s
+* @brief Result of offset lookup in TZifZone.
+*/
+struct tzif_offset_s {
+	int32_t utcOffset;			/**< Offset from UTC in seconds (time zone and DST offset), which is added to UTC time to get local time. */
+	bool isDST;					/**< True if DST is applied. */
+	const char* abbreviation;	/**< Abbreviation of local time type, for example "CEST". It is never NULL. */
+};
+
+/**
+* @class TZifZone
+* @brief Time zone loaded from TZif file (version 1, 2 or 3), which keeps all historical transitions.
+* Transition times are stored as raw UTC values in sorted array, so offset lookup is binary search.
+* Times after the last transition are resolved by POSIX time zone from footer of file (version 2 and 3).
+* @note Footer rule is evaluated by DSTAdjustment, so its limits apply there. Negative DST is converted to positive DST
+* with swapped rules (offsets are the same, but DST flag is inverted). Footer with transitions out of whole hours is ignored
+* and offset of the last transition is used after it.
+* Leap seconds are ignored.
+*/
+class TZifZone {
+public:
+
+	/**
+	* @brief Creates empty (invalid) zone, which has zero offset.
+	*/
+	TZifZone() {}
+
+	/**
+	* @brief Loads zone from TZif file.
+	* @param path Path to TZif file, for example "/usr/share/zoneinfo/Europe/Berlin".
+	* @return Returns true if file was loaded. If it failed, zone is empty.
+	*/
+	bool loadFile(const char* path);
+
+	/**
+	* @brief Loads zone from TZif data in memory (for example memory-mapped file). Data are copied, so they can be released after loading.
+	* @param data TZif data.
+	* @param size Size of data in bytes.
+	* @return Returns true if data were loaded. If it failed, zone is empty.
+	*/
+	bool load(const uint8_t* data, size_t size);
+
+	/**
+	* @brief Creates zone from TZif file.
+	* @param path Path to TZif file.
+	* @return Returns loaded zone or empty zone if loading failed, see isValid().
+	*/
+	static TZifZone fromFile(const char* path) {
+		TZifZone zone;
+		zone.loadFile(path);
+		return zone;
+	}
+
+	/**
+	* @brief Checks if zone was loaded.
+	*/
+	inline bool isValid() const {
+		return !types.empty();
+	}
+
+	/**
+	* @brief Gets offset of local time from UTC.
+	* @param rawUTC UTC date and time in raw form (microseconds since year 1).
+	* @return Returns offset, DST flag and abbreviation of local time type, which is valid at specified time.
+	*/
+	tzif_offset_s getOffset(int64_t rawUTC) const;
+
+	/**
+	* @brief Gets offset of local time from UTC in seconds.
+	* @param rawUTC UTC date and time in raw form (microseconds since year 1).
+	*/
+	inline int32_t getOffsetSeconds(int64_t rawUTC) const {
+		return getOffset(rawUTC).utcOffset;
+	}
+
+	/**
+	* @brief Converts UTC date and time to local date and time.
+	* @param rawUTC UTC date and time in raw form (microseconds since year 1).
+	* @return Returns local date and time in raw form.
+	*/
+	inline int64_t toLocal(int64_t rawUTC) const {
+		return rawUTC + ((int64_t)getOffsetSeconds(rawUTC)) * SECOND;
+	}
+
+	/**
+	* @brief Gets count of transitions.
+	*/
+	inline size_t getTransitionCount() const {
+		return transitions.size();
+	}
+
+	/**
+	* @brief Gets time of transition in raw UTC form.
+	* @param index Index of transition, transitions are sorted from the oldest.
+	*/
+	inline int64_t getTransition(size_t index) const {
+		return transitions[index];
+	}
+
+	/**
+	* @brief Gets local time type, which is valid from transition.
+	* @param index Index of transition, transitions are sorted from the oldest.
+	*/
+	inline const tzif_type_s& getTransitionType(size_t index) const {
+		return types[transitionTypes[index]];
+	}
+
+	/**
+	* @brief Gets local time type, which is used before the first transition.
+	*/
+	inline const tzif_type_s& getInitialType() const {
+		return types[0];
+	}
+
+	/**
+	* @brief Gets abbreviation of local time type.
+	*/
+	inline const char* getAbbreviation(const tzif_type_s& type) const {
+		return abbreviations.c_str() + type.abbrIndex;
+	}
+
+	/**
+	* @brief Checks if zone has POSIX time zone rule, which is used after the last transition.
+	*/
+	inline bool hasFooter() const {
+		return footerValid;
+	}
+
+	/**
+	* @brief Gets POSIX time zone rule from footer of file, for example "CET-1CEST,M3.5.0,M10.5.0/3". It can be empty.
+	*/
+	inline const std::string& getPOSIX() const {
+		return posix;
+	}
+
+	/**
+	* @brief Gets time zone of POSIX rule from footer.
+	*/
+	inline TimeZone getFooterTimeZone() const {
+		return footerTZ;
+	}
+
+	/**
+	* @brief Gets DST adjustment of POSIX rule from footer.
+	*/
+	inline const DSTAdjustment& getFooterDST() const {
+		return footerDST;
+	}
+
+	/**
+	* @brief Empties zone.
+	*/
+	void clear();
+
+private:
+	std::vector<int64_t> transitions;		//Transition times as raw UTC values, sorted
+	std::vector<uint8_t> transitionTypes;	//Index of local time type for each transition
+	std::vector<tzif_type_s> types;			//Local time types
+	std::string abbreviations;				//Null terminated abbreviations one after another
+	std::string posix;						//POSIX time zone from footer
+	TimeZone footerTZ;
+	DSTAdjustment footerDST;
+	char footerABR[2][TIME_ZONE_INFO_TZ_ABR_NAME_SIZE] = {};	//Standard and daylight abbreviation from footer
+	bool footerValid = false;
+};
+
 #endif // DT_UNDER_OS > 0
 
 #endif // !TZFILE_PARSER_H_